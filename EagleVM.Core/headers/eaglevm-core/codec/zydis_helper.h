@@ -54,6 +54,7 @@ namespace eagle::codec
     std::string instruction_to_string(const dec::inst_info& decode);
     std::string operand_to_string(const dec::inst_info& decode, int index);
     const char* reg_to_string(reg reg);
+    const char* mnemonic_to_string(mnemonic mnemonic);
 
     std::vector<uint8_t> compile(enc::req& request);
     std::vector<uint8_t> compile_absolute(enc::req& request, uint32_t address);
@@ -32,6 +32,7 @@ namespace eagle::asmb
         void bind(const code_label_ptr& code_label);
 
         [[nodiscard]] std::vector<inst_label_v> get_instructions() const;
+        [[nodiscard]] size_t get_segment_count() const;
 
     private:
         uint32_t uid;
@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace eagle::interp
+{
+    using xmm_value = std::array<uint64_t, 2>;
+
+    enum rflags_bit : uint64_t
+    {
+        flag_cf = 1ull << 0,
+        flag_pf = 1ull << 2,
+        flag_af = 1ull << 4,
+        flag_zf = 1ull << 6,
+        flag_sf = 1ull << 7,
+        flag_tf = 1ull << 8,
+        flag_if = 1ull << 9,
+        flag_df = 1ull << 10,
+        flag_of = 1ull << 11,
+    };
+
+    /**
+    * architectural state the interpreter runs against
+    * gprs are stored in zydis order: rax, rcx, rdx, rbx, rsp, rbp, rsi, rdi, r8 - r15
+    */
+    struct cpu_state
+    {
+        std::array<uint64_t, 16> gpr = { };
+        std::array<xmm_value, 16> xmm = { };
+
+        uint64_t rip = 0;
+        uint64_t rflags = 0x202;
+        uint32_t mxcsr = 0x1F80;
+
+        uint64_t fs_base = 0;
+        uint64_t gs_base = 0;
+    };
+}
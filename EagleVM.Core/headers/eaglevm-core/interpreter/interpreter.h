@@ -0,0 +1,109 @@
+#pragma once
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/interpreter/cpu_state.h"
+#include "eaglevm-core/interpreter/memory.h"
+
+namespace eagle::interp
+{
+    enum class exec_status
+    {
+        success,
+
+        // ud2, vmcall, int3 or hlt, the way compiled tests signal they are done
+        trap,
+
+        memory_fault,
+        divide_error,
+        invalid_instruction,
+        unsupported_instruction,
+        step_limit,
+    };
+
+    using trace_callback = std::function<void(const cpu_state& state, const codec::dec::inst_info& decode)>;
+
+    /**
+    * x86-64 interpreter for user mode code, decoded with zydis
+    * covers the instructions the vm emits for handlers and exits plus the general purpose and scalar sse
+    * instructions lifted from guest code. everything runs against a cpu_state and a memory, so a run can never
+    * take the host process down and any number of interpreters can run in parallel
+    */
+    class interpreter
+    {
+    public:
+        explicit interpreter(memory& memory);
+
+        cpu_state& get_state();
+        const cpu_state& get_state() const;
+
+        /**
+        * executes a single instruction at rip
+        * on failure rip is left on the instruction which failed
+        */
+        exec_status step();
+
+        /**
+        * steps until anything other than success comes back
+        * @param max_steps amount of instructions after which step_limit is returned
+        */
+        exec_status run(uint64_t max_steps);
+
+        /**
+        * called before every instruction with the state it is about to execute on
+        */
+        void set_trace(trace_callback callback);
+
+        /**
+        * @return amount of instructions which executed successfully
+        */
+        uint64_t get_executed() const;
+
+        /**
+        * @return address of the last memory access that faulted
+        */
+        uint64_t get_fault_address() const;
+
+    private:
+        memory& mem;
+        cpu_state state;
+
+        trace_callback trace;
+        uint64_t executed = 0;
+        uint64_t fault_address = 0;
+
+        std::unordered_map<uint64_t, codec::dec::inst_info> decode_cache;
+        std::unordered_set<uint64_t> code_pages;
+
+        exec_status fetch(codec::dec::inst_info& decode);
+        exec_status execute(const codec::dec::inst_info& decode);
+
+        exec_status execute_sse(const codec::dec::inst_info& decode);
+        exec_status execute_string(const codec::dec::inst_info& decode);
+
+        uint64_t read_reg(codec::reg reg) const;
+        void write_reg(codec::reg reg, uint64_t value);
+
+        uint64_t get_address(const codec::dec::inst& inst, const codec::dec::operand& operand) const;
+
+        bool read_operand(const codec::dec::inst& inst, const codec::dec::operand& operand, uint64_t& value);
+        bool write_operand(const codec::dec::inst& inst, const codec::dec::operand& operand, uint64_t value);
+
+        bool read_vector(const codec::dec::inst& inst, const codec::dec::operand& operand, xmm_value& value);
+        bool write_vector(const codec::dec::inst& inst, const codec::dec::operand& operand, const xmm_value& value);
+
+        bool read_memory(uint64_t address, void* buffer, uint64_t size);
+        bool write_memory(uint64_t address, const void* buffer, uint64_t size);
+
+        bool push(uint64_t value, uint16_t bytes = 8);
+        bool pop(uint64_t& value, uint16_t bytes = 8);
+
+        bool test_condition(codec::mnemonic mnemonic) const;
+
+        void set_flag(rflags_bit flag, bool set);
+        bool get_flag(rflags_bit flag) const;
+        void set_result_flags(uint64_t result, uint16_t bits);
+    };
+}
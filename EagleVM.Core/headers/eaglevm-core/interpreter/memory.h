@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace eagle::interp
+{
+    /**
+    * sparse paged memory for the interpreter
+    * nothing here touches host memory, every address is only a key into the page table
+    */
+    class memory
+    {
+    public:
+        static constexpr uint64_t page_size = 0x1000;
+
+        /**
+        * maps zeroed pages covering the range, pages which are already mapped keep their contents
+        */
+        void map(uint64_t address, uint64_t size);
+
+        /**
+        * maps the range and copies data into it
+        */
+        void load(uint64_t address, const void* data, uint64_t size);
+
+        /**
+        * when set, reads and writes to unmapped data map zeroed pages instead of faulting
+        * instruction fetches still fault so a bad jump does not run through zeroed memory
+        */
+        void set_lazy(bool lazy);
+
+        bool is_mapped(uint64_t address, uint64_t size) const;
+
+        bool read(uint64_t address, void* buffer, uint64_t size);
+        bool write(uint64_t address, const void* buffer, uint64_t size);
+
+        /**
+        * reads as many bytes as are mapped starting at address, up to size
+        * @return amount of bytes read
+        */
+        uint64_t fetch(uint64_t address, void* buffer, uint64_t size) const;
+
+    private:
+        using page = std::array<uint8_t, page_size>;
+        std::unordered_map<uint64_t, std::unique_ptr<page>> pages;
+
+        bool lazy = false;
+
+        page* get_page(uint64_t address, bool create);
+        const page* get_page(uint64_t address) const;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include <linuxpe>
+
+namespace eagle::pe
+{
+    /**
+    * read only mapping of an input image, the file is paged in by the os as it is read instead of copied up front
+    * views handed out by the image and by a pe_generator loaded from it are only valid while the image is alive
+    */
+    class mapped_image
+    {
+    public:
+        mapped_image() = default;
+        ~mapped_image();
+
+        mapped_image(const mapped_image&) = delete;
+        mapped_image& operator=(const mapped_image&) = delete;
+
+        /**
+        * @return false if the file could not be opened or mapped, or is empty
+        */
+        bool open(const std::string& path);
+        void close();
+
+        [[nodiscard]] const uint8_t* data() const;
+        [[nodiscard]] size_t size() const;
+
+        /**
+        * linux-pe only takes mutable images, the pages are read only so writing through it faults
+        */
+        [[nodiscard]] win::image_x64_t* get_image() const;
+
+    private:
+        void* view = nullptr;
+        size_t view_size = 0;
+
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int file = -1;
+#endif
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace eagle::pe
+{
+    /**
+    * output file created at its final size and mapped writable, bytes are copied straight into the file pages
+    * the file is zero filled when it is created so gaps between written ranges need no padding writes
+    */
+    class mapped_output
+    {
+    public:
+        mapped_output() = default;
+        ~mapped_output();
+
+        mapped_output(const mapped_output&) = delete;
+        mapped_output& operator=(const mapped_output&) = delete;
+
+        /**
+        * truncates any existing file at path
+        * @return false if the file could not be created, sized or mapped
+        */
+        bool create(const std::string& path, size_t size);
+
+        /**
+        * unmaps the view, which is when the os is free to flush it to disk
+        */
+        void close();
+
+        [[nodiscard]] uint8_t* data() const;
+        [[nodiscard]] size_t size() const;
+
+    private:
+        void* view = nullptr;
+        size_t view_size = 0;
+
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int file = -1;
+#endif
+    };
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cstdint>
+
+/*
+ * the parts of winnt.h the pe generator works with, laid out exactly like the windows headers
+ * so they can still be copied straight out of an image when building somewhere else
+ */
+
+using BYTE = uint8_t;
+using WORD = uint16_t;
+using DWORD = uint32_t;
+using LONG = int32_t;
+using ULONGLONG = uint64_t;
+
+constexpr uint32_t IMAGE_SIZEOF_SHORT_NAME = 8;
+constexpr uint32_t IMAGE_NUMBEROF_DIRECTORY_ENTRIES = 16;
+
+constexpr uint32_t IMAGE_DIRECTORY_ENTRY_DEBUG = 6;
+constexpr uint32_t IMAGE_DEBUG_TYPE_CODEVIEW = 2;
+
+struct IMAGE_DOS_HEADER
+{
+    WORD e_magic;
+    WORD e_cblp;
+    WORD e_cp;
+    WORD e_crlc;
+    WORD e_cparhdr;
+    WORD e_minalloc;
+    WORD e_maxalloc;
+    WORD e_ss;
+    WORD e_sp;
+    WORD e_csum;
+    WORD e_ip;
+    WORD e_cs;
+    WORD e_lfarlc;
+    WORD e_ovno;
+    WORD e_res[4];
+    WORD e_oemid;
+    WORD e_oeminfo;
+    WORD e_res2[10];
+    LONG e_lfanew;
+};
+
+struct IMAGE_FILE_HEADER
+{
+    WORD Machine;
+    WORD NumberOfSections;
+    DWORD TimeDateStamp;
+    DWORD PointerToSymbolTable;
+    DWORD NumberOfSymbols;
+    WORD SizeOfOptionalHeader;
+    WORD Characteristics;
+};
+
+struct IMAGE_DATA_DIRECTORY
+{
+    DWORD VirtualAddress;
+    DWORD Size;
+};
+
+struct IMAGE_OPTIONAL_HEADER64
+{
+    WORD Magic;
+    BYTE MajorLinkerVersion;
+    BYTE MinorLinkerVersion;
+    DWORD SizeOfCode;
+    DWORD SizeOfInitializedData;
+    DWORD SizeOfUninitializedData;
+    DWORD AddressOfEntryPoint;
+    DWORD BaseOfCode;
+    ULONGLONG ImageBase;
+    DWORD SectionAlignment;
+    DWORD FileAlignment;
+    WORD MajorOperatingSystemVersion;
+    WORD MinorOperatingSystemVersion;
+    WORD MajorImageVersion;
+    WORD MinorImageVersion;
+    WORD MajorSubsystemVersion;
+    WORD MinorSubsystemVersion;
+    DWORD Win32VersionValue;
+    DWORD SizeOfImage;
+    DWORD SizeOfHeaders;
+    DWORD CheckSum;
+    WORD Subsystem;
+    WORD DllCharacteristics;
+    ULONGLONG SizeOfStackReserve;
+    ULONGLONG SizeOfStackCommit;
+    ULONGLONG SizeOfHeapReserve;
+    ULONGLONG SizeOfHeapCommit;
+    DWORD LoaderFlags;
+    DWORD NumberOfRvaAndSizes;
+    IMAGE_DATA_DIRECTORY DataDirectory[IMAGE_NUMBEROF_DIRECTORY_ENTRIES];
+};
+
+struct IMAGE_NT_HEADERS64
+{
+    DWORD Signature;
+    IMAGE_FILE_HEADER FileHeader;
+    IMAGE_OPTIONAL_HEADER64 OptionalHeader;
+};
+
+struct IMAGE_SECTION_HEADER
+{
+    BYTE Name[IMAGE_SIZEOF_SHORT_NAME];
+    union
+    {
+        DWORD PhysicalAddress;
+        DWORD VirtualSize;
+    } Misc;
+    DWORD VirtualAddress;
+    DWORD SizeOfRawData;
+    DWORD PointerToRawData;
+    DWORD PointerToRelocations;
+    DWORD PointerToLinenumbers;
+    WORD NumberOfRelocations;
+    WORD NumberOfLinenumbers;
+    DWORD Characteristics;
+};
+
+struct IMAGE_DEBUG_DIRECTORY
+{
+    DWORD Characteristics;
+    DWORD TimeDateStamp;
+    WORD MajorVersion;
+    WORD MinorVersion;
+    DWORD Type;
+    DWORD SizeOfData;
+    DWORD AddressOfRawData;
+    DWORD PointerToRawData;
+};
+
+using IMAGE_OPTIONAL_HEADER = IMAGE_OPTIONAL_HEADER64;
+using IMAGE_NT_HEADERS = IMAGE_NT_HEADERS64;
+
+using PIMAGE_SECTION_HEADER = IMAGE_SECTION_HEADER*;
+using PIMAGE_DEBUG_DIRECTORY = IMAGE_DEBUG_DIRECTORY*;
+
+static_assert(sizeof(IMAGE_DOS_HEADER) == 0x40);
+static_assert(sizeof(IMAGE_NT_HEADERS64) == 0x108);
+static_assert(sizeof(IMAGE_SECTION_HEADER) == 0x28);
+static_assert(sizeof(IMAGE_DEBUG_DIRECTORY) == 0x1C);
+#endif
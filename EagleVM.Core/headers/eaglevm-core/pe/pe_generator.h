@@ -6,12 +6,15 @@
 #include <algorithm>
 #include <fstream>
 
-#include <Windows.h>
 #include <linuxpe>
 
+#include "eaglevm-core/pe/models/winnt.h"
+
+#include "eaglevm-core/pe/section_data.h"
+
 namespace eagle::pe
 {
-    using generator_section_t = std::pair<win::section_header_t, std::vector<uint8_t>>;
+    using generator_section_t = std::pair<win::section_header_t, section_data>;
     class pe_generator
     {
     public:
@@ -28,6 +31,10 @@ namespace eagle::pe
             sections = {};
         }
 
+        /**
+        * copies the headers and makes every section a view into the parsed image
+        * the image has to stay alive until the generator is done with it, sections are only copied once they are written to
+        */
         void load_parser();
 
         generator_section_t& add_section(const char* name);
@@ -48,7 +55,10 @@ namespace eagle::pe
 
         void add_custom_pdb(uint32_t target_rva, uint32_t target_raw, uint32_t target_size);
 
-        void save_file(const std::string& save_path);
+        /**
+        * @return false if the output file could not be created
+        */
+        bool save_file(const std::string& save_path);
 
         void zero_memory_rva(uint32_t rva, uint32_t size);
 
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eagle::pe
+{
+    /**
+    * raw bytes of a section, either a view into the mapped input image or a buffer of its own
+    * sections loaded from the input stay views until something writes to them, only then are they copied
+    */
+    class section_data
+    {
+    public:
+        section_data() = default;
+        section_data(const uint8_t* view, size_t size);
+
+        [[nodiscard]] const uint8_t* data() const;
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool empty() const;
+
+        /**
+        * copies the view into a buffer of its own the first time it is called
+        * @return buffer which can be written to and resized
+        */
+        std::vector<uint8_t>& materialize();
+        [[nodiscard]] bool is_materialized() const;
+
+        section_data& operator+=(const std::vector<uint8_t>& bytes);
+
+    private:
+        const uint8_t* view = nullptr;
+        size_t view_size = 0;
+
+        // sections created by the generator have no view to start with
+        bool materialized = true;
+        std::vector<uint8_t> buffer;
+    };
+}
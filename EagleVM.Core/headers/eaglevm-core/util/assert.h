@@ -1,6 +1,14 @@
 #pragma once
 #include <cassert>
 
+// stops in the debugger, or kills the process when there is none attached
+#ifdef _MSC_VER
+    #include <intrin.h>
+    #define VM_BREAK() __debugbreak()
+#else
+    #define VM_BREAK() __asm__ volatile("int3")
+#endif
+
 // credit: https://github.dev/x64dbg/x64dbg
 #ifdef _DEBUG
     #define __DBG_ARGUMENT_EXPAND(x) x
@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace eagle::util
+{
+    /**
+    * collects scoped timings and named counters from every stage of the pipeline
+    * while disabled every call returns right away, so instrumented code only pays for a branch
+    */
+    class profiler
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static void set_enabled(bool enabled);
+        static bool is_enabled();
+
+        static void add_counter(const char* name, int64_t value = 1);
+        static void add_span(const char* name, clock::time_point start, clock::time_point end);
+
+        /**
+        * chrome trace event json, opens in chrome://tracing and perfetto
+        */
+        static std::string chrome_trace();
+
+        /**
+        * table of every span name with calls, total, average and max time followed by the counters
+        */
+        static std::string summary();
+
+        static void reset();
+    };
+
+    /**
+    * records a span from construction to destruction
+    * names have to outlive the profiler, string literals are expected
+    */
+    class scoped_timer
+    {
+    public:
+        explicit scoped_timer(const char* name);
+        ~scoped_timer();
+
+        scoped_timer(const scoped_timer&) = delete;
+        scoped_timer& operator=(const scoped_timer&) = delete;
+
+    private:
+        const char* name;
+        bool active;
+        profiler::clock::time_point start;
+    };
+}
+
+#define VM_PROFILE_CONCAT_INNER(a, b) a##b
+#define VM_PROFILE_CONCAT(a, b) VM_PROFILE_CONCAT_INNER(a, b)
+#define VM_PROFILE_SCOPE(name) eagle::util::scoped_timer VM_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
@@ -21,8 +21,8 @@ namespace eagle::ir
         void add_command(const std::vector<base_command_ptr>& command);
 
         void copy_from(const block_ptr& other);
-        bool insert_after(const base_command_ptr& command_ptr);
-        bool insert_before(const base_command_ptr& command_ptr);
+        bool insert_after(const base_command_ptr& target, const base_command_ptr& command_ptr);
+        bool insert_before(const base_command_ptr& target, const base_command_ptr& command_ptr);
 
         base_command_ptr& get_command(size_t i);
 
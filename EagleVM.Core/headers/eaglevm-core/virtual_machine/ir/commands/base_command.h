@@ -30,6 +30,10 @@ namespace eagle::ir
     SHARED_DEFINE(cmd_sx);
     SHARED_DEFINE(cmd_x86_dynamic);
     SHARED_DEFINE(cmd_x86_exec);
+    SHARED_DEFINE(cmd_native_island);
+    SHARED_DEFINE(cmd_call);
+    SHARED_DEFINE(cmd_ret);
+    SHARED_DEFINE(cmd_string);
     SHARED_DEFINE(cmd_branch);
 
     class base_command : public std::enable_shared_from_this<base_command>
@@ -55,8 +55,17 @@ namespace eagle::ir
         il_exit_result& get_condition_default();
         il_exit_result& get_condition_special();
 
+        /**
+        * a virtual branch is executed inside the vm, the condition has to come from the virtual rflags
+        * because the native rflags do not hold the guest flags at that point
+        */
+        void set_virtual(bool inside_vm);
+        [[nodiscard]] bool is_virtual() const;
+
     private:
         std::vector<il_exit_result> info;
         exit_condition condition;
+
+        bool virtual_branch = false;
     };
 }
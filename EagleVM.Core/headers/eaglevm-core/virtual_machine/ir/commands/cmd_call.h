@@ -0,0 +1,85 @@
+#pragma once
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/virtual_machine/ir/commands/base_command.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_branch.h"
+
+namespace eagle::ir
+{
+    /**
+    * calls a function without leaving the vm on the caller side
+    * the return address pushed to the guest stack is the vm enter of the return block so native callees return into the vm
+    */
+    class cmd_call : public base_command
+    {
+    public:
+        /**
+        * @param target rva of the callee or the head block of a virtualized callee
+        * @param return_entry block containing the vm enter native callees return to
+        * @param return_body block virtualized callees return to without re-entering the vm
+        * @param request original call instruction
+        */
+        cmd_call(const il_exit_result& target, const block_ptr& return_entry, const block_ptr& return_body,
+            codec::dynamic_instruction request)
+            : base_command(command_type::vm_call), target(target), dynamic(false), return_entry(return_entry),
+              return_body(return_body), request(std::move(request)), is_virtual_call(false)
+        {
+        }
+
+        /**
+        * creates a call where the absolute target address is popped off the vm stack
+        */
+        cmd_call(const block_ptr& return_entry, const block_ptr& return_body, codec::dynamic_instruction request)
+            : base_command(command_type::vm_call), target(vmexit_rva(0)), dynamic(true), return_entry(return_entry),
+              return_body(return_body), request(std::move(request)), is_virtual_call(false)
+        {
+        }
+
+        il_exit_result& get_target()
+        {
+            return target;
+        }
+
+        bool is_dynamic() const
+        {
+            return dynamic;
+        }
+
+        block_ptr get_return_entry() const
+        {
+            return return_entry;
+        }
+
+        block_ptr get_return_body() const
+        {
+            return return_body;
+        }
+
+        codec::dynamic_instruction get_request() const
+        {
+            return request;
+        }
+
+        /**
+        * a virtual call jumps straight into the callee body, the callee has to be lifted by the same machine
+        */
+        void set_virtual(const bool is_virtual)
+        {
+            is_virtual_call = is_virtual;
+        }
+
+        bool is_virtual() const
+        {
+            return is_virtual_call;
+        }
+
+    private:
+        il_exit_result target;
+        bool dynamic;
+
+        block_ptr return_entry;
+        block_ptr return_body;
+
+        codec::dynamic_instruction request;
+        bool is_virtual_call;
+    };
+}
@@ -13,8 +13,14 @@ namespace eagle::ir
         codec::reg get_reg() const;
         codec::reg_class get_reg_class() const;
 
+        void set_cache(const discrete_store_ptr& store);
+        discrete_store_ptr get_cache() const;
+
     private:
         codec::reg source = codec::reg::none;
         codec::reg_class r_class = codec::reg_class::invalid;
+
+        // when set, the loaded value is kept in this store after being pushed
+        discrete_store_ptr cache = nullptr;
     };
 }
@@ -12,8 +12,14 @@ namespace eagle::ir
         codec::reg get_reg() const;
         codec::reg_size get_value_size() const;
 
+        void set_cache(const discrete_store_ptr& store);
+        discrete_store_ptr get_cache() const;
+
     private:
         codec::reg dest;
         codec::reg_size size;
+
+        // when set, the popped value is kept in this store after being written
+        discrete_store_ptr cache = nullptr;
     };
 }
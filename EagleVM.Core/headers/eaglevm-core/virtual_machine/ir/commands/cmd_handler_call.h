@@ -26,7 +26,7 @@ namespace eagle::ir
         handler_sig get_handler_signature();
 
     private:
-        call_type call_type = call_type::none;
+        ir::call_type call_type = ir::call_type::none;
         codec::mnemonic mnemonic;
 
         bool operand_sig_init;
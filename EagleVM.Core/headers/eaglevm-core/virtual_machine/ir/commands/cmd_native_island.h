@@ -0,0 +1,54 @@
+#pragma once
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/virtual_machine/ir/commands/base_command.h"
+
+namespace eagle::ir
+{
+    /**
+    * executes a single native instruction without leaving the vm
+    * only the registers the instruction touches are moved in and out of the virtual context
+    */
+    class cmd_native_island : public base_command
+    {
+    public:
+        /**
+        * @param request native instruction to execute
+        * @param registers 64 bit versions of every gpr the instruction reads or writes
+        * @param written 64 bit versions of every gpr the instruction writes, subset of registers
+        * @param flags true if the instruction reads or writes rflags
+        */
+        explicit cmd_native_island(codec::dynamic_instruction request, const std::vector<codec::reg>& registers,
+            const std::vector<codec::reg>& written, const bool flags)
+            : base_command(command_type::vm_native_island), request(std::move(request)), registers(registers), written(written),
+              flags(flags)
+        {
+        }
+
+        codec::dynamic_instruction get_request() const
+        {
+            return request;
+        }
+
+        std::vector<codec::reg> get_registers() const
+        {
+            return registers;
+        }
+
+        std::vector<codec::reg> get_written() const
+        {
+            return written;
+        }
+
+        bool get_flags() const
+        {
+            return flags;
+        }
+
+    private:
+        codec::dynamic_instruction request;
+
+        std::vector<codec::reg> registers;
+        std::vector<codec::reg> written;
+        bool flags;
+    };
+}
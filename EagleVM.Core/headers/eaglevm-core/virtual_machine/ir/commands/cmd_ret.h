@@ -0,0 +1,29 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/commands/base_command.h"
+
+namespace eagle::ir
+{
+    /**
+    * pops the return address off the guest stack and continues there
+    * return addresses pushed by a call from the same vm are resumed without leaving the vm
+    */
+    class cmd_ret : public base_command
+    {
+    public:
+        /**
+        * @param release_bytes bytes released from the stack after the return address, ret imm16
+        */
+        explicit cmd_ret(const uint16_t release_bytes = 0)
+            : base_command(command_type::vm_ret), release_bytes(release_bytes)
+        {
+        }
+
+        uint16_t get_release_bytes() const
+        {
+            return release_bytes;
+        }
+
+    private:
+        uint16_t release_bytes;
+    };
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/virtual_machine/ir/commands/base_command.h"
+
+namespace eagle::ir
+{
+    enum class string_op
+    {
+        movs,
+        stos
+    };
+
+    /**
+    * runs a string instruction on the guest rdi, rsi or rax and rcx
+    * the registers are read from and written back to the vm context directly
+    */
+    class cmd_string : public base_command
+    {
+    public:
+        /**
+        * @param op string operation to perform
+        * @param element_size size of a single element
+        * @param rep true if rcx holds the element count, otherwise a single element is processed
+        * @param request original instruction, for machines without bulk handlers
+        */
+        cmd_string(const string_op op, const ir_size element_size, const bool rep, codec::dynamic_instruction request)
+            : base_command(command_type::vm_string), op(op), element_size(element_size), rep(rep), request(std::move(request))
+        {
+        }
+
+        string_op get_op() const
+        {
+            return op;
+        }
+
+        ir_size get_element_size() const
+        {
+            return element_size;
+        }
+
+        bool get_rep() const
+        {
+            return rep;
+        }
+
+        codec::dynamic_instruction get_request() const
+        {
+            return request;
+        }
+
+    private:
+        string_op op;
+        ir_size element_size;
+        bool rep;
+
+        codec::dynamic_instruction request;
+    };
+}
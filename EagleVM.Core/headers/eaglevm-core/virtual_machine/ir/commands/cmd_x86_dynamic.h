@@ -4,13 +4,21 @@
 
 namespace eagle::ir
 {
-    // todo actually add options
-    using variant_op = std::variant<discrete_store_ptr>;
+    // immediates are encoded as signed values, they must fit the instruction's immediate width
+    using variant_op = std::variant<discrete_store_ptr, uint64_t>;
     class cmd_x86_dynamic : public base_command
     {
     public:
         // TODO: make this a template constructor
 
+        explicit cmd_x86_dynamic(const codec::mnemonic mnemonic, const variant_op& op1, const variant_op& op2, const variant_op& op3)
+            : base_command(command_type::vm_exec_dynamic_x86), mnemonic(mnemonic)
+        {
+            operands.push_back(op1);
+            operands.push_back(op2);
+            operands.push_back(op3);
+        }
+
         explicit cmd_x86_dynamic(const codec::mnemonic mnemonic, const variant_op& op1, const variant_op& op2)
             : base_command(command_type::vm_exec_dynamic_x86), mnemonic(mnemonic)
         {
@@ -34,8 +42,26 @@ namespace eagle::ir
             return operands;
         }
 
+        /**
+        * binds a store to a register the instruction uses implicitly, like rdx:rax for mul and div
+        * the store goes in through that register and whatever the instruction leaves there comes back out
+        * @param target 64 bit register the instruction reads or writes implicitly
+        * @param store store holding the value of that register
+        */
+        cmd_x86_dynamic_ptr bind(const codec::reg target, const discrete_store_ptr& store)
+        {
+            implicit.emplace_back(target, store);
+            return std::static_pointer_cast<cmd_x86_dynamic>(shared_from_this());
+        }
+
+        std::vector<std::pair<codec::reg, discrete_store_ptr>> get_implicit() const
+        {
+            return implicit;
+        }
+
     private:
         codec::mnemonic mnemonic;
         std::vector<variant_op> operands;
+        std::vector<std::pair<codec::reg, discrete_store_ptr>> implicit;
     };
 }
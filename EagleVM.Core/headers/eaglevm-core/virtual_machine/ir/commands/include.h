@@ -13,4 +13,8 @@
 #include "eaglevm-core/virtual_machine/ir/commands/cmd_sx.h"
 #include "eaglevm-core/virtual_machine/ir/commands/cmd_x86_exec.h"
 #include "eaglevm-core/virtual_machine/ir/commands/cmd_x86_dynamic.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_native_island.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_call.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_ret.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_string.h"
 
@@ -25,6 +25,10 @@ namespace eagle::ir
 
         vm_exec_x86,
         vm_exec_dynamic_x86,
+        vm_native_island,
+        vm_call,
+        vm_ret,
+        vm_string,
         vm_rflags_load,
         vm_rflags_store,
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <set>
 #include <unordered_map>
 #include "commands/cmd_branch.h"
@@ -27,11 +28,11 @@ namespace eagle::ir
         explicit ir_translator(dasm::segment_dasm_ptr seg_dasm);
 
         std::vector<preopt_block_ptr> translate(bool split);
-        std::vector<block_vm_id> flatten(
+        static std::vector<block_vm_id> flatten(
             const std::vector<preopt_vm_id>& block_vms,
             std::unordered_map<preopt_block_ptr, block_ptr>& block_tracker
         );
-        std::vector<block_vm_id> optimize(
+        static std::vector<block_vm_id> optimize(
             const std::vector<preopt_vm_id>& block_vms,
             std::unordered_map<preopt_block_ptr, block_ptr>& block_tracker,
             const std::vector<preopt_block_ptr>& extern_call_blocks = { }
@@ -40,17 +41,44 @@ namespace eagle::ir
         dasm::basic_block_ptr map_basic_block(const preopt_block_ptr& preopt_target);
         preopt_block_ptr map_preopt_block(dasm::basic_block_ptr basic_block);
 
+        /**
+        * instructions which had no lifter and were executed by leaving the vm, counted by mnemonic
+        */
+        std::map<codec::mnemonic, uint32_t> get_native_fallbacks() const;
+
+        /**
+        * instructions which had no lifter but could run as a native island inside the vm
+        */
+        std::map<codec::mnemonic, uint32_t> get_native_islands() const;
+
     private:
         dasm::segment_dasm_ptr dasm;
 
         std::unordered_map<dasm::basic_block_ptr, preopt_block_ptr> bb_map;
 
+        std::map<codec::mnemonic, uint32_t> native_fallbacks;
+        std::map<codec::mnemonic, uint32_t> native_islands;
+
         preopt_block_ptr translate_block(dasm::basic_block_ptr bb);
         preopt_block_ptr translate_block_split(dasm::basic_block_ptr bb);
 
         exit_condition get_exit_condition(codec::mnemonic mnemonic);
 
+        /**
+        * creates the vm call for a near call, indirect targets are lifted into call_block
+        * @return nullptr if the call has to be executed natively
+        */
+        cmd_call_ptr create_call(const codec::dec::inst_info& decoded_inst, uint64_t current_rva, const block_ptr& call_block);
+
         static void handle_block_command(codec::dec::inst_info decoded_inst, const block_ptr& current_block, uint64_t current_rva);
+        static codec::dynamic_instruction get_native_request(codec::dec::inst_info decoded_inst, uint64_t current_rva);
+
+        /**
+        * collects the gprs an instruction reads and writes so it can be executed as a native island
+        * @return false if the instruction touches state that cannot be moved in and out of the vm context
+        */
+        static bool get_island_registers(const codec::dec::inst_info& decoded_inst, std::vector<codec::reg>& registers,
+            std::vector<codec::reg>& written, bool& flags);
     };
 
     class preopt_block
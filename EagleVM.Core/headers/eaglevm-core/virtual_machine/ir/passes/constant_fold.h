@@ -0,0 +1,41 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/block.h"
+
+namespace eagle::ir
+{
+    /**
+    * folds stack arithmetic on known immediates
+    *
+    * address calculations and immediate operands are lifted as a push followed by a handler call,
+    * so a displacement or scale costs a full handler dispatch even though its value is known at protection time
+    */
+    class constant_fold
+    {
+    public:
+        /**
+        * runs every rule over the block until nothing changes
+        */
+        static void run(const block_ptr& block);
+
+    private:
+        /**
+        * push imm, sx -> push sign extended imm
+        */
+        static bool fold_sign_extend(const block_ptr& block, size_t i);
+
+        /**
+        * push imm, push imm, handler -> push result
+        */
+        static bool fold_immediates(const block_ptr& block, size_t i);
+
+        /**
+        * push 0, add / push 1, imul -> nothing
+        */
+        static bool fold_identity(const block_ptr& block, size_t i);
+
+        /**
+        * push imm, handler -> pop, x86 instruction with immediate operand, push
+        */
+        static bool fold_handler_call(const block_ptr& block, size_t i);
+    };
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/block.h"
+
+namespace eagle::ir
+{
+    /**
+    * block local dataflow over x86 context commands
+    *
+    * every lifted instruction reloads its operands with cmd_context_load and writes back with cmd_context_store,
+    * so instructions touching the same register pay for decoding and encoding it again each time
+    */
+    class context_dataflow
+    {
+    public:
+        /**
+        * @param max_cached maximum amount of context values which may be kept alive at the same time
+        */
+        explicit context_dataflow(uint8_t max_cached);
+
+        void run(const block_ptr& block) const;
+
+    private:
+        uint8_t max_cached;
+
+        /**
+        * replaces context stores which are overwritten before they can be read with a plain pop
+        */
+        static void remove_dead_stores(const block_ptr& block);
+
+        /**
+        * keeps the value of a loaded or stored register in a cache store
+        * following loads of the same register become pushes of that store until the register is written or the block leaves the vm
+        */
+        void cache_context_values(const block_ptr& block) const;
+    };
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "eaglevm-core/virtual_machine/ir/region_graph.h"
+
+namespace eagle::ir
+{
+    /**
+    * execution count of every original basic block, keyed by the rva of its first instruction
+    */
+    class block_profile
+    {
+    public:
+        /**
+        * reads one "<rva> <count>" pair per line, both may be written in hex with a 0x prefix
+        * empty lines and lines starting with # are skipped
+        * @return false if the file could not be opened or a line could not be parsed
+        */
+        bool load(const std::string& path);
+
+        void add(uint64_t rva, uint64_t count);
+        [[nodiscard]] uint64_t get_count(uint64_t rva) const;
+        [[nodiscard]] bool empty() const;
+
+    private:
+        std::unordered_map<uint64_t, uint64_t> counts;
+    };
+
+    /**
+    * relative cost of one execution of a block, in units of one native instruction
+    * the defaults are rough and only the ratio between the two configurations matters for the selection
+    */
+    struct profile_costs
+    {
+        // cost of a single ir command lifted with the heavy and the light machine settings
+        double heavy_command = 12.0;
+        double light_command = 7.0;
+
+        // vm enter and exit paid by a block which sits in a vm of its own
+        double transition = 80.0;
+    };
+
+    struct profile_plan
+    {
+        // blocks which get the light settings and share one vm per region
+        std::unordered_set<preopt_block_ptr> hot_blocks;
+
+        double native_cost = 0.0;
+        double heavy_cost = 0.0;
+        double planned_cost = 0.0;
+
+        [[nodiscard]] double get_heavy_slowdown() const;
+        [[nodiscard]] double get_planned_slowdown() const;
+    };
+
+    /**
+    * splits profiled blocks into hot and cold so the estimated slowdown stays inside a budget
+    *
+    * every block starts out with the heavy settings in a vm of its own
+    * the blocks which cost the most under that configuration are moved to the light one until the budget is met
+    * blocks without a profile entry never ran, they always stay heavy
+    */
+    class profile_guide
+    {
+    public:
+        /**
+        * @param profile execution counts of the original blocks
+        * @param slowdown_budget estimated virtualized cost divided by native cost the plan tries to stay under
+        * @param costs per command costs of both configurations
+        */
+        profile_guide(block_profile profile, double slowdown_budget, profile_costs costs = { });
+
+        /**
+        * replaces the per command estimate of blocks with the static cycle estimate of their lifted code
+        * the light cost of such a block keeps the ratio between light_command and heavy_command
+        * @param cycles estimated cycles per execution keyed by block rva, as written by the driver next to the output
+        */
+        void set_block_costs(block_profile cycles);
+
+        [[nodiscard]] profile_plan plan(const std::vector<region_ptr>& regions) const;
+
+    private:
+        block_profile profile;
+        block_profile block_costs;
+
+        double slowdown_budget;
+        profile_costs costs;
+
+        static size_t get_command_count(const preopt_block_ptr& block);
+    };
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "eaglevm-core/virtual_machine/ir/ir_translator.h"
+
+namespace eagle::ir
+{
+    struct region
+    {
+        dasm::segment_dasm_ptr dasm;
+        std::shared_ptr<ir_translator> translator;
+
+        preopt_block_ptr entry;
+        std::vector<preopt_vm_id> blocks;
+    };
+
+    using region_ptr = std::shared_ptr<region>;
+
+    /**
+    * program level view of every virtualized region
+    *
+    * regions are translated on their own, so a branch into another region only shows up as an exit to an rva
+    * linking turns those exits into block targets, which lets the branch stay inside the vm
+    */
+    class region_graph
+    {
+    public:
+        /**
+        * adds a translated region, every block is given its own vm
+        * @param dasm disassembly the region was translated from
+        * @param translator translator which owns the preopt blocks
+        * @param blocks translated blocks of the region
+        * @param entry block which is entered from native code
+        */
+        region_ptr add_region(const dasm::segment_dasm_ptr& dasm, const std::shared_ptr<ir_translator>& translator,
+            const preopt_block_vec& blocks, const preopt_block_ptr& entry);
+
+        /**
+        * rewrites exits which land on the first instruction of a block in another region
+        * the source and target are moved into the same vm so they end up being lifted by the same machine
+        * calls are linked the same way, blocks of the callee which return are pulled into the vm of the caller as well
+        * @return amount of exits and calls that were linked
+        */
+        uint32_t link();
+
+        /**
+        * moves blocks into a single vm, branches between them no longer leave the vm
+        * every block linked to one of them is pulled in as well
+        * @return id of the shared vm
+        */
+        uint32_t share_vm(const std::vector<preopt_block_ptr>& blocks);
+
+        std::vector<preopt_vm_id> get_block_vms();
+        std::vector<preopt_block_ptr> get_entry_blocks() const;
+
+    private:
+        std::vector<region_ptr> regions;
+
+        // union find over vm ids, linked blocks share a root
+        std::vector<uint32_t> vm_parent;
+
+        uint32_t find_vm(uint32_t vm_id);
+        void merge_vms(uint32_t first, uint32_t second);
+
+        bool link_call(const region_ptr& source, uint32_t vm_id, const cmd_call_ptr& call);
+        void merge_returns(const region_ptr& target, uint32_t vm_id);
+
+        [[nodiscard]] std::pair<preopt_block_ptr, uint32_t> find_block(uint64_t rva, const region_ptr& source) const;
+    };
+}
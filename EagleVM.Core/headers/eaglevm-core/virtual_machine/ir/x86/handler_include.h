@@ -1,13 +1,38 @@
 #pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/adc.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/add.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/and.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/call.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/cmovcc.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/cmp.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/dec.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/imul.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/inc.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/lea.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/mov.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/movs.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/movsx.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/movzx.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/neg.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/not.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/or.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/pop.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/push.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/rol.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/ror.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sar.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sbb.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/setcc.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/shl.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/shr.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_arith.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_compare.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_convert.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_mov.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/stos.h"
 #include "eaglevm-core/virtual_machine/ir/x86/handlers/sub.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/test.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/wide_arith.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/xchg.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/xor.h"
 
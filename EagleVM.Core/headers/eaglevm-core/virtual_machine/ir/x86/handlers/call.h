@@ -0,0 +1,15 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::lifter
+{
+    /**
+    * only pushes the target of an indirect call, the translator emits the call command itself
+    */
+    class call : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        void finalize_translate_to_virtual() override;
+    };
+}
\ No newline at end of file
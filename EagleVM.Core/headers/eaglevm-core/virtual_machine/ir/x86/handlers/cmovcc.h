@@ -0,0 +1,26 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    class cmovcc : public base_handler_gen
+    {
+    public:
+        explicit cmovcc(codec::mnemonic mnemonic);
+        ir_insts gen_handler(handler_sig signature) override;
+
+    private:
+        codec::mnemonic mnemonic;
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class cmovcc : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        void finalize_translate_to_virtual() override;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    class movs : public base_handler_gen
+    {
+    public:
+        movs();
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class movs : public base_x86_translator
+    {
+    public:
+        movs(codec::dec::inst_info decode, uint64_t rva);
+
+        bool translate_to_il(uint64_t original_rva) override;
+
+    private:
+        codec::dec::inst_info decoded_inst;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    class not_ : public base_handler_gen
+    {
+    public:
+        not_();
+        ir_insts gen_handler(handler_sig signature) override;
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class not_ : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        translate_mem_result translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx) override;
+        void finalize_translate_to_virtual() override;
+    };
+}
\ No newline at end of file
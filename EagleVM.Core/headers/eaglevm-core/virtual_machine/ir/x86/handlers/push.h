@@ -17,7 +17,6 @@ namespace eagle::ir::lifter
     {
         using base_x86_translator::base_x86_translator;
 
-        translate_mem_result translate_mem_result();
         void finalize_translate_to_virtual() override;
     };
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    class sse_convert : public base_handler_gen
+    {
+    public:
+        explicit sse_convert(codec::mnemonic mnemonic);
+        ir_insts gen_handler(handler_sig signature) override;
+
+    private:
+        codec::mnemonic mnemonic;
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class sse_convert : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        bool translate_to_il(uint64_t original_rva) override;
+
+        translate_mem_result translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx) override;
+        bool skip(uint8_t idx) override;
+
+        void finalize_translate_to_virtual() override;
+    };
+}
\ No newline at end of file
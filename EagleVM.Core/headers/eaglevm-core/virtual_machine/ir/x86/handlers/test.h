@@ -0,0 +1,24 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    class test : public base_handler_gen
+    {
+    public:
+        test();
+        ir_insts gen_handler(handler_sig signature) override;
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class test : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        void finalize_translate_to_virtual() override;
+        translate_status encode_operand(codec::dec::op_imm op_imm, uint8_t idx) override;
+    };
+}
\ No newline at end of file
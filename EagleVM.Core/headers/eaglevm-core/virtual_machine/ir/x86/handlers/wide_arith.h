@@ -0,0 +1,36 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    /**
+    * one operand mul, imul, div and idiv
+    * the implicit rdx:rax operands are pushed under the explicit one and both halves of the result come back out
+    */
+    class wide_arith : public base_handler_gen
+    {
+    public:
+        explicit wide_arith(codec::mnemonic mnemonic);
+        ir_insts gen_handler(handler_sig signature) override;
+
+        /**
+        * @return true if the instruction also reads rdx (or ah for the 8 bit form) as the top half of the dividend
+        */
+        static bool is_division(codec::mnemonic mnemonic);
+
+    private:
+        codec::mnemonic mnemonic;
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class wide_arith : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        bool translate_to_il(uint64_t original_rva) override;
+        void finalize_translate_to_virtual() override;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
+#include "eaglevm-core/virtual_machine/ir/x86/base_x86_translator.h"
+
+namespace eagle::ir::handler
+{
+    class xchg : public base_handler_gen
+    {
+    public:
+        xchg();
+    };
+}
+
+namespace eagle::ir::lifter
+{
+    class xchg : public base_x86_translator
+    {
+        using base_x86_translator::base_x86_translator;
+
+        void finalize_translate_to_virtual() override;
+    };
+}
\ No newline at end of file
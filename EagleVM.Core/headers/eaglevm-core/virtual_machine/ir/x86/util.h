@@ -1,10 +1,30 @@
 #pragma once
 #include <cassert>
 
+#include "eaglevm-core/codec/zydis_defs.h"
 #include "eaglevm-core/util/assert.h"
+#include "eaglevm-core/virtual_machine/ir/commands/base_command.h"
 #include "eaglevm-core/virtual_machine/ir/models/ir_size.h"
 
 namespace eagle::ir
 {
-    inline ir_size bits_to_ir_size(const uint16_t bit_count);
+    ir_size bits_to_ir_size(uint16_t bit_count);
+
+    /**
+    * zydis sizes scalar sse register operands by their element, the lifters need the size of what actually gets pushed
+    * @return full register width for register operands, access width for memory operands
+    */
+    ir_size get_sse_operand_size(const codec::dec::operand& operand);
+
+    /**
+    * mmx instructions share most of their mnemonics with sse, only xmm and gpr registers can be lifted
+    * @return true if every register operand is an xmm register or gpr
+    */
+    bool is_sse_operands(const codec::dec::operand* operands, uint8_t operand_count);
+
+    /**
+    * pops an sse source operand into a 128 bit store
+    * 32 and 64 bit sources come off the stack as gpr values and get zero extended into the store
+    */
+    ir_insts pop_xmm_operand(const discrete_store_ptr& destination, ir_size source_size);
 }
@@ -29,6 +29,10 @@ namespace eagle::virt
         virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_vm_exit_ptr& cmd) = 0;
         virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_dynamic_ptr& cmd) = 0;
         virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_exec_ptr& cmd) = 0;
+        virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_native_island_ptr& cmd) = 0;
+        virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_call_ptr& cmd) = 0;
+        virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_ret_ptr& cmd) = 0;
+        virtual void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_string_ptr& cmd) = 0;
 
         void add_block_context(const std::vector<ir::block_ptr>& blocks);
         void add_block_context(const ir::block_ptr& block);
@@ -0,0 +1,79 @@
+#pragma once
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "eaglevm-core/codec/zydis_defs.h"
+#include "eaglevm-core/compiler/code_container.h"
+
+namespace eagle::virt::eg
+{
+    /**
+    * rough cycles paid for each kind of emitted instruction, a native instruction is counted as one cycle
+    */
+    struct cost_weights
+    {
+        double instruction = 1.0;
+
+        // loads and stores on top of the instruction itself, push, pop, call and ret included
+        double memory_op = 3.0;
+
+        // jmp VIP goes somewhere else on almost every dispatch so it is expected to mispredict now and then
+        double indirect_jump = 8.0;
+
+        // pushfq and popfq are microcoded
+        double flags_op = 20.0;
+    };
+
+    struct container_cost
+    {
+        uint64_t instructions = 0;
+        uint64_t memory_ops = 0;
+        uint64_t indirect_jumps = 0;
+        uint64_t flags_ops = 0;
+        uint64_t handler_calls = 0;
+
+        double cycles = 0.0;
+
+        void add(const container_cost& other);
+    };
+
+    /**
+    * static estimate of what a single pass through a lifted container costs
+    *
+    * every instruction in the container is counted once and the handlers it calls are added on top
+    * handlers which call other handlers are followed all the way down
+    * branches are not resolved, every path through a handler is counted as if it ran
+    */
+    class cost_model
+    {
+    public:
+        explicit cost_model(cost_weights weights = { });
+
+        /**
+        * makes the handlers of a machine known to the model
+        * @param handlers containers returned by create_handlers
+        * @param handler_calls handler labels each container passes control to, see machine::get_handler_calls
+        */
+        void add_handlers(const std::vector<asmb::code_container_ptr>& handlers,
+            const std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>>& handler_calls);
+
+        /**
+        * @param container lifted block or handler
+        * @return cost of the container including every handler it calls
+        */
+        container_cost estimate(const asmb::code_container_ptr& container);
+
+    private:
+        cost_weights weights;
+
+        std::unordered_map<asmb::code_label_ptr, asmb::code_container_ptr> handler_entries;
+        std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>> handler_calls;
+
+        std::unordered_map<asmb::code_container_ptr, container_cost> estimates;
+        std::unordered_set<asmb::code_container_ptr> visiting;
+
+        container_cost get_local_cost(const asmb::code_container_ptr& container) const;
+        void add_instruction(container_cost& cost, const codec::enc::req& request) const;
+    };
+}
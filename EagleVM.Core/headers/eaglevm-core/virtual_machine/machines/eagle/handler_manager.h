@@ -1,10 +1,13 @@
 #pragma once
 #include <deque>
+#include <map>
 
 #include "eaglevm-core/codec/zydis_enum.h"
 #include "eaglevm-core/compiler/code_container.h"
 
 #include "eaglevm-core/virtual_machine/ir/models/ir_discrete_reg.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_branch.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_string.h"
 
 #include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
 #include "eaglevm-core/virtual_machine/machines/eagle/register_manager.h"
@@ -48,6 +51,34 @@ namespace eagle::virt::eg
         std::pair<reg_range, reg_range> get_mapping(uint16_t bit);
     };
 
+    struct thread_table
+    {
+        asmb::code_label_ptr label;
+
+        // continuation of every handler call in the container, in the order they execute
+        std::vector<asmb::code_label_ptr> entries;
+
+        // segment count of the container right after the last call returned
+        size_t last_return_segment = 0;
+
+        bool nested = false;
+        bool cursor_valid = false;
+        bool cursor_saved = false;
+    };
+
+    using thread_table_ptr = std::shared_ptr<thread_table>;
+
+    struct profile_counter
+    {
+        std::string name;
+
+        // entry of the handler and the 8 byte counter it increments
+        asmb::code_label_ptr handler;
+        asmb::code_label_ptr counter;
+
+        // every container which calls or jumps into the handler
+        std::vector<asmb::code_container_ptr> callers;
+    };
     using inst_handlers_ptr = std::shared_ptr<class handler_manager>;
     using machine_ptr = std::shared_ptr<class machine>;
 
@@ -65,6 +96,24 @@ namespace eagle::virt::eg
 
         asmb::code_label_ptr get_vm_enter();
         asmb::code_label_ptr get_vm_exit();
+
+        /**
+         * vm exit used for native calls, the volatile registers no argument is passed in are not written back
+         */
+        asmb::code_label_ptr get_vm_exit_call();
+
+        /**
+         * handler which resumes a return address popped by a virtual ret
+         * the caller places the return address in VTEMP, addresses of return sites in this vm never leave the vm
+         */
+        asmb::code_label_ptr get_vm_return();
+
+        /**
+         * registers a call made from this vm so returns to it can skip the vm enter
+         * @param entry label of the block the return address points to
+         * @param body label of the block to continue at inside the vm
+         */
+        void add_return_site(const asmb::code_label_ptr& entry, const asmb::code_label_ptr& body);
         asmb::code_label_ptr get_rlfags_load();
         asmb::code_label_ptr get_rflags_store();
 
@@ -74,7 +123,47 @@ namespace eagle::virt::eg
         asmb::code_label_ptr get_push(codec::reg target_reg, codec::reg_size size);
         asmb::code_label_ptr get_pop(codec::reg target_reg, codec::reg_size size);
 
-        void call_vm_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label) const;
+        /**
+         * handler which evaluates a condition against the virtual rflags and jumps to the selected block
+         * the handler never returns, the caller places the taken rva in VTEMP and the fall through rva in VTEMP2
+         * @param condition flag based condition to evaluate
+         */
+        asmb::code_label_ptr get_vm_branch(ir::exit_condition condition);
+
+        /**
+         * handler which runs a string operation in 16 and 8 byte chunks instead of one element per dispatch
+         * the caller places rdi in VTEMP, rsi or rax in VTEMP2 and the element count in VTEMP3, all three are updated in place
+         * @param op string operation to perform
+         * @param size element size
+         */
+        asmb::code_label_ptr get_string_handler(ir::string_op op, codec::reg_size size);
+
+        void call_vm_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label);
+
+        /**
+         * records that container passes control to the handler at label
+         * call_vm_handler does this on its own, direct jumps into vm enter, vm exit and friends have to be added by the caller
+         */
+        void add_handler_call(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label);
+
+        /**
+         * @return handler labels each container calls or jumps to, in the order they were emitted
+         */
+        const std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>>& get_handler_calls() const;
+
+        /**
+         * marks the dispatch cursor of a container as clobbered, the next handler call will reload it
+         * used when the container leaves or re-enters the vm
+         * @param container
+         */
+        void invalidate_dispatch_cursor(const asmb::code_container_ptr& container) const;
+
+        /**
+         * the context saved by vm enter sits right below rsp for the entire time the vm is running
+         * @param target_reg gpr to locate
+         * @return displacement from rsp to the context slot of target_reg
+         */
+        int32_t get_context_displacement(codec::reg target_reg) const;
 
         /**
          * append to the current working block a call or inlined code to load specific register
@@ -108,12 +197,24 @@ namespace eagle::virt::eg
 
         asmb::code_container_ptr build_vm_enter();
         asmb::code_container_ptr build_vm_exit();
+        asmb::code_container_ptr build_vm_exit_call();
+        asmb::code_container_ptr build_vm_return();
 
         asmb::code_container_ptr build_rflags_load();
         asmb::code_container_ptr build_rflags_store();
 
         std::vector<asmb::code_container_ptr> build_push();
         std::vector<asmb::code_container_ptr> build_pop();
+        std::vector<asmb::code_container_ptr> build_vm_branch();
+        std::vector<asmb::code_container_ptr> build_string_handlers();
+
+        /**
+         * container with a zeroed counter for every handler that was profiled
+         * must be compiled before the handlers, the counters are addressed relative to VBASE
+         * @return nullptr if handler profiling is disabled or nothing was profiled
+         */
+        asmb::code_container_ptr build_profile_counters() const;
+        std::vector<profile_counter> get_profile_counters() const;
 
     private:
         std::weak_ptr<machine> machine_inst;
@@ -125,18 +226,28 @@ namespace eagle::virt::eg
 
         tagged_handler vm_enter;
         tagged_handler vm_exit;
+        tagged_handler vm_exit_call;
+        tagged_handler vm_return;
+
+        std::vector<std::pair<asmb::code_label_ptr, asmb::code_label_ptr>> return_sites;
 
         tagged_handler vm_rflags_load;
         tagged_handler vm_rflags_store;
 
         std::unordered_map<codec::reg, tagged_handler_data_pair> vm_push;
         std::unordered_map<codec::reg, tagged_handler_data_pair> vm_pop;
+        std::unordered_map<ir::exit_condition, tagged_handler_data_pair> vm_branch;
+        std::map<std::pair<ir::string_op, codec::reg_size>, tagged_handler_data_pair> string_handlers;
 
         std::vector<tagged_handler_data_pair> register_load_handlers;
         std::vector<tagged_handler_data_pair> register_store_handlers;
 
         std::vector<tagged_handler_data_pair> complex_resolve_handlers;
 
+        std::unordered_map<asmb::code_container_ptr, thread_table_ptr> thread_tables;
+        std::vector<thread_table_ptr> thread_table_order;
+        bool building_nested_handler = false;
+
         uint16_t vm_overhead;
         uint16_t vm_stack_regs;
         uint16_t vm_call_stack;
@@ -145,6 +256,10 @@ namespace eagle::virt::eg
         using tagged_handler_label = std::pair<tagged_handler_id, asmb::code_label_ptr>;
         std::vector<tagged_handler_label> tagged_instruction_handlers;
 
+        std::vector<profile_counter> profile_counters;
+        std::unordered_map<asmb::code_container_ptr, size_t> profiled_containers;
+        std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>> handler_calls;
+
         void load_register_internal(codec::reg load_destination, const asmb::code_container_ptr& out,
             const std::vector<reg_mapped_range>& ranges_required) const;
         void store_register_internal(codec::reg source_register, const asmb::code_container_ptr& out,
@@ -154,8 +269,29 @@ namespace eagle::virt::eg
 
         [[nodiscard]] std::vector<reg_mapped_range> get_relevant_ranges(codec::reg source_reg) const;
         void create_vm_return(const asmb::code_container_ptr& container) const;
+
+        /**
+         * gives the handler in container a counter, does nothing if handler profiling is disabled
+         * @param container handler body, create_vm_return will increment the counter
+         * @param label entry of the handler used by callers
+         * @param name readable handler signature for the profile manifest
+         */
+        void add_profile_counter(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label, const std::string& name);
+
+        /**
+         * increments the counter of container using VIP as scratch, rflags are left untouched
+         * only valid where VIP is free and VBASE is set
+         */
+        void increment_profile_counter(const asmb::code_container_ptr& container) const;
+        void create_vm_exit(const asmb::code_container_ptr& container, const std::vector<codec::reg>& skipped_regs);
+        void create_stack_return(const asmb::code_container_ptr& container) const;
+
+        void call_stack_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label) const;
+        void call_threaded_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label);
+        thread_table_ptr get_thread_table(const asmb::code_container_ptr& container);
         static codec::reg_size load_store_index_size(uint8_t index);
 
         std::vector<asmb::code_container_ptr> build_instruction_handlers();
+        std::vector<asmb::code_container_ptr> build_thread_tables() const;
     };
 }
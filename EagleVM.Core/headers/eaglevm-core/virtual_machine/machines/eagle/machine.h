@@ -40,9 +40,26 @@ namespace eagle::virt::eg
         void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_vm_exit_ptr& cmd) override;
         void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_dynamic_ptr& cmd) override;
         void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_exec_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_native_island_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_call_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_ret_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_string_ptr& cmd) override;
 
         std::vector<asmb::code_container_ptr> create_handlers() override;
 
+        /**
+        * counters incremented by the handlers when settings->profile_handlers is set
+        * has to be called after create_handlers and compiled before the handlers
+        * @return nullptr if nothing was profiled
+        */
+        asmb::code_container_ptr create_profile_counters() const;
+        std::vector<profile_counter> get_profile_counters() const;
+
+        /**
+        * handler labels every lifted block and handler passes control to, used to follow handler calls statically
+        */
+        const std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>>& get_handler_calls() const;
+
     private:
         settings_ptr settings;
         register_manager_ptr reg_man;
@@ -50,10 +67,14 @@ namespace eagle::virt::eg
 
         register_context_ptr reg_64_container;
         register_context_ptr reg_128_container;
+        register_context_ptr reg_cache_container;
 
         std::unordered_map<ir::discrete_store_ptr, complex_load_info> store_complex_load_info;
 
         void handle_cmd(const asmb::code_container_ptr& code, const ir::base_command_ptr& command) override;
+        void release_store(const ir::discrete_store_ptr& store) const;
+        [[nodiscard]] const register_context_ptr& get_store_container(const ir::discrete_store_ptr& store) const;
+        void handle_virtual_branch(const asmb::code_container_ptr& block, const ir::cmd_branch_ptr& cmd);
 
         void call_push(const asmb::code_container_ptr& block, const ir::discrete_store_ptr& shared);
         void call_push(const asmb::code_container_ptr& block, codec::reg target_reg);
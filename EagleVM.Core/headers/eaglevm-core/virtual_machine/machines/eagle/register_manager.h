@@ -69,9 +69,11 @@ namespace eagle::virt::eg
         [[nodiscard]] codec::reg get_vm_reg(uint8_t i) const;
         [[nodiscard]] std::vector<codec::reg> get_unreserved_temp() const;
         [[nodiscard]] codec::reg get_reserved_temp(uint8_t i) const;
+        [[nodiscard]] std::vector<codec::reg> get_cache_temp() const;
 
         [[nodiscard]] std::vector<codec::reg> get_unreserved_temp_xmm() const;
         [[nodiscard]] codec::reg get_reserved_temp_xmm(uint8_t i) const;
+        [[nodiscard]] codec::reg get_mapping_xmm(uint8_t i) const;
 
         template<typename T>
         void enumerate(const T& enumerable, const bool from_back = false)
@@ -141,17 +143,22 @@ namespace eagle::virt::eg
         * the order goes as the following
         * 0-x vm registers
         * ... vtemp reserved
+        * ... vtemp cache
         * ... unreserved for register mapping
         */
         std::array<codec::reg, 16> virtual_order_gpr{ };
 
         /**
-        * when assigning virtual
+        * the order goes as the following
+        * 0-x xmm reserved temps
+        * ... gpr register mappings
+        * ... xmm unreserved temps
         */
         std::array<codec::reg, 16> virtual_order_xmm{ };
 
         uint8_t num_v_temp_unreserved;
         uint8_t num_v_temp_reserved;
+        uint8_t num_v_temp_cache;
 
         uint8_t num_v_temp_xmm_unreserved;
         uint8_t num_v_temp_xmm_reserved;
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "eaglevm-core/codec/zydis_defs.h"
+#include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
+
+namespace eagle::virt::eg
+{
+    /**
+    * how the blocks of the code are spread across vms
+    */
+    enum class vm_id_policy
+    {
+        // every block is lifted by the same machine and shares its handlers
+        shared,
+
+        // every block gets a machine of its own, the same as unlinked blocks in the driver
+        per_block,
+    };
+
+    struct section_build
+    {
+        codec::encoded_vec code;
+
+        // runtime address the vm is entered at for the first block
+        uint64_t entry_address = 0;
+
+        size_t instruction_count = 0;
+        size_t command_count = 0;
+
+        // runtime address of every block start with the amount of ir commands in the block
+        std::vector<std::pair<uint64_t, size_t>> block_entries;
+    };
+
+    /**
+    * wraps every stage of build_section, the stage only runs once the hook calls run
+    */
+    using stage_hook = std::function<void(const char* stage, const std::function<void()>& run)>;
+
+    /**
+    * decode -> lift -> compile for a single run of code, without any of the region handling the driver does
+    * this is the chain the tests, benchmarks and the fuzzer share
+    * @param bytes code placed at rva 0, the first block starts at the first byte
+    * @param vm_ids how blocks are assigned to machines
+    * @param section_rva rva the vm section is compiled to
+    * @param runtime_base base address the section is compiled to run at
+    * @param hook optional, called around decode, generate_blocks, translate, optimize, lift_block, create_handlers and compile_section
+    */
+    section_build build_section(const settings_ptr& settings, const std::vector<uint8_t>& bytes, vm_id_policy vm_ids,
+        uint64_t section_rva, uint64_t runtime_base, const stage_hook& hook = nullptr);
+}
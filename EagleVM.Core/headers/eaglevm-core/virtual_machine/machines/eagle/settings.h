@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 
 namespace eagle::virt::eg
@@ -55,6 +56,28 @@ namespace eagle::virt::eg
         bool relative_addressing = true;
 
         bool complex_temp_loading = true;
+
+        /**
+         * when enabled, handlers no longer return through the VCS call stack
+         * each container gets a table of continuation addresses and a handler returns by reading the next entry
+         * handler calls with nothing in between are chained, so a handler jumps straight into the next one
+         */
+        bool threaded_dispatch = false;
+
+        /**
+         * number of unreserved temporaries set aside for context values the ir keeps alive across commands
+         * these are never handed out to vm handlers, so a cached register value survives handler calls
+         *
+         * recommended value: 2
+         */
+        uint8_t context_cache_registers = 2;
+
+        /**
+         * when enabled, every handler increments its own 64 bit counter each time it runs
+         * the counters are placed in a separate container which has to be compiled before the handlers reference it
+         * increments are not atomic, counts from multiple threads running the vm at once can be lost
+         */
+        bool profile_handlers = false;
     };
 
     using settings_ptr = std::shared_ptr<settings>;
@@ -46,6 +46,10 @@ namespace eagle::virt::pidg
         void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_vm_exit_ptr& cmd) override;
         void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_dynamic_ptr& cmd) override;
         void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_exec_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_native_island_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_call_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_ret_ptr& cmd) override;
+        void handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_string_ptr& cmd) override;
 
     private:
         register_context_ptr transaction;
@@ -42,6 +42,8 @@ namespace eagle::virt
         void release(const ir::discrete_store_ptr& store);
         void release(codec::reg reg);
 
+        [[nodiscard]] bool is_blocked(const ir::discrete_store_ptr& store) const;
+
         scope_register_manager create_scope();
 
     private:
@@ -1,5 +1,6 @@
 #pragma once
 #include "eaglevm-core/codec/zydis_enum.h"
+#include "eaglevm-core/codec/zydis_helper.h"
 #include "eaglevm-core/virtual_machine/ir/models/ir_size.h"
 
 namespace eagle::virt
@@ -55,4 +56,103 @@ namespace eagle::virt
         VM_ASSERT("reached invalid reg size");
         return codec::reg_size::empty;
     }
-}
+
+    /**
+    * shifts and rotates only take a register count through cl
+    */
+    inline bool is_cl_count_mnemonic(const codec::mnemonic mnemonic)
+    {
+        switch (mnemonic)
+        {
+            case codec::m_shl:
+            case codec::m_shr:
+            case codec::m_sar:
+            case codec::m_rol:
+            case codec::m_ror:
+            case codec::m_rcl:
+            case codec::m_rcr:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+    * encodes a shift or rotate with the count sitting in any gpr
+    * rcx gets swapped with the count register around the instruction, xchg does not touch rflags
+    * @param mnemonic shift or rotate mnemonic
+    * @param value_reg sized register holding the value
+    * @param count_reg register holding the count
+    */
+    inline std::vector<codec::enc::req> encode_cl_count(const codec::mnemonic mnemonic, const codec::reg value_reg, const codec::reg count_reg)
+    {
+        const codec::reg count_64 = codec::get_bit_version(count_reg, codec::gpr_64);
+        const codec::reg value_64 = codec::get_bit_version(value_reg, codec::gpr_64);
+        if (count_64 == codec::rcx)
+            return { codec::encode(mnemonic, ZREG(value_reg), ZREG(codec::cl)) };
+
+        // if the value was in rcx it is now sitting in the count register
+        const codec::reg target = value_64 == codec::rcx ? codec::get_bit_version(count_64, codec::get_reg_size(value_reg)) : value_reg;
+        return {
+            codec::encode(codec::m_xchg, ZREG(codec::rcx), ZREG(count_64)),
+            codec::encode(mnemonic, ZREG(target), ZREG(codec::cl)),
+            codec::encode(codec::m_xchg, ZREG(codec::rcx), ZREG(count_64)),
+        };
+    }
+
+    /**
+    * encodes an instruction with implicit register operands while its values sit in any gpr
+    * each fixed register gets swapped with the register holding its value and swapped back afterwards
+    * whatever the vm kept in a fixed register rides along in the holder until then, xchg does not touch rflags
+    * @param request instruction with its explicit operands already encoded
+    * @param bindings pairs of 64 bit fixed register and 64 bit register holding the value for it
+    */
+    inline std::vector<codec::enc::req> encode_implicit(codec::enc::req request, const std::vector<std::pair<codec::reg, codec::reg>>& bindings)
+    {
+        std::vector<std::pair<codec::reg, codec::reg>> swaps;
+        auto locate = [&swaps](const codec::reg target)
+        {
+            // follow a value through every swap done so far
+            codec::reg location = target;
+            for (const auto& [first, second] : swaps)
+            {
+                if (location == first)
+                    location = second;
+                else if (location == second)
+                    location = first;
+            }
+
+            return location;
+        };
+
+        for (const auto& [fixed, holder] : bindings)
+        {
+            const codec::reg current = locate(holder);
+            if (current != fixed)
+                swaps.emplace_back(fixed, current);
+        }
+
+        // explicit registers may have been moved by the swaps
+        for (uint8_t i = 0; i < request.operand_count; i++)
+        {
+            if (request.operands[i].type != ZYDIS_OPERAND_TYPE_REGISTER)
+                continue;
+
+            const codec::reg op_reg = static_cast<codec::reg>(request.operands[i].reg.value);
+            const codec::reg location = locate(codec::get_bit_version(op_reg, codec::gpr_64));
+            request.operands[i].reg.value = static_cast<ZydisRegister>(codec::get_bit_version(location, codec::get_reg_size(op_reg)));
+        }
+
+        std::vector<codec::enc::req> requests;
+        for (const auto& [first, second] : swaps)
+            requests.push_back(codec::encode(codec::m_xchg, ZREG(first), ZREG(second)));
+
+        requests.push_back(request);
+
+        // undoing the swaps backwards puts every register back except the holders, which now have the results
+        for (auto it = swaps.rbegin(); it != swaps.rend(); ++it)
+            requests.push_back(codec::encode(codec::m_xchg, ZREG(it->first), ZREG(it->second)));
+
+        return requests;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "eaglevm-core/compiler/code_container.h"
+#include "eaglevm-core/virtual_machine/ir/region_graph.h"
+
+namespace eagle::virt
+{
+    /**
+    * collects how much a protection run expanded the input and where the expansion came from
+    *
+    * lifted containers get a label bound at their start and end, so their size can only be read after the section is compiled
+    */
+    class protection_stats
+    {
+    public:
+        /**
+        * registers a translated region, has to be called before optimization so every block can be traced back to it
+        * @param region region returned by the region graph
+        * @param rva_begin first byte of the original code
+        * @param rva_end end of the original code, exclusive
+        */
+        void add_region(const ir::region_ptr& region, uint64_t rva_begin, uint64_t rva_end);
+
+        /**
+        * records a lifted block and the commands it was lifted from
+        * @param vm_id id of the machine which lifted the block
+        */
+        void add_block(uint32_t vm_id, const ir::block_ptr& block, const asmb::code_container_ptr& container);
+
+        /**
+        * records the handlers a machine built
+        */
+        void add_handlers(uint32_t vm_id, const std::vector<asmb::code_container_ptr>& handlers);
+
+        /**
+        * json report with a section per region, per machine and the totals
+        * the section has to be compiled before this is called
+        */
+        std::string to_json() const;
+
+    private:
+        struct container_span
+        {
+            asmb::code_label_ptr begin;
+            asmb::code_label_ptr end;
+
+            static container_span bind(const asmb::code_container_ptr& container);
+            [[nodiscard]] uint64_t size() const;
+        };
+
+        struct command_stats
+        {
+            uint64_t emitted_bytes = 0;
+            uint32_t blocks = 0;
+            std::map<ir::command_type, uint32_t> commands;
+
+            void add(const command_stats& other);
+        };
+
+        struct region_info
+        {
+            uint64_t rva_begin = 0;
+            uint64_t rva_end = 0;
+
+            std::map<codec::mnemonic, uint32_t> native_fallbacks;
+            std::map<codec::mnemonic, uint32_t> native_islands;
+        };
+
+        struct block_info
+        {
+            uint32_t vm_id;
+            container_span span;
+            std::map<ir::command_type, uint32_t> commands;
+        };
+
+        struct machine_info
+        {
+            std::vector<container_span> handlers;
+        };
+
+        std::vector<region_info> regions;
+        std::unordered_map<ir::block_ptr, size_t> block_regions;
+
+        std::vector<std::pair<ir::block_ptr, block_info>> blocks;
+        std::map<uint32_t, machine_info> machines;
+    };
+}
@@ -194,7 +194,7 @@ namespace eagle::codec
             &request, instruction.data(), &encoded_length);
 
         if (!ZYAN_SUCCESS(status))
-            __debugbreak();
+            VM_BREAK();
 
         instruction.resize(encoded_length);
         return instruction;
@@ -285,6 +285,11 @@ namespace eagle::codec
         return ZydisRegisterGetString(static_cast<ZydisRegister>(reg));
     }
 
+    const char* mnemonic_to_string(mnemonic mnemonic)
+    {
+        return ZydisMnemonicGetString(static_cast<ZydisMnemonic>(mnemonic));
+    }
+
     std::vector<uint8_t> compile(enc::req& request)
     {
         std::vector<uint8_t> instruction_data(ZYDIS_MAX_INSTRUCTION_LENGTH);
@@ -292,7 +297,7 @@ namespace eagle::codec
 
         const ZyanStatus result = ZydisEncoderEncodeInstruction(&request, instruction_data.data(), &encoded_length);
         if (!ZYAN_SUCCESS(result))
-            __debugbreak();
+            VM_BREAK();
 
         instruction_data.resize(encoded_length);
         return instruction_data;
@@ -306,7 +311,7 @@ namespace eagle::codec
         const ZyanStatus result = ZydisEncoderEncodeInstructionAbsolute(&request, instruction_data.data(),
             &encoded_length, address);
         if (!ZYAN_SUCCESS(result))
-            __debugbreak();
+            VM_BREAK();
 
         instruction_data.resize(encoded_length);
         return instruction_data;
@@ -322,7 +327,7 @@ namespace eagle::codec
 
             const ZyanStatus result = ZydisEncoderEncodeInstruction(&i, instruction_data.data(), &encoded_length);
             if (!ZYAN_SUCCESS(result))
-                __debugbreak();
+                VM_BREAK();
 
             instruction_data.resize(encoded_length);
             data.insert(data.end(), instruction_data.begin(), instruction_data.end());
@@ -345,7 +350,7 @@ namespace eagle::codec
                 &i, instruction_data.data(), &encoded_length, current_rva);
             if (!ZYAN_SUCCESS(result))
             {
-                __debugbreak();
+                VM_BREAK();
             }
 
             instruction_data.resize(encoded_length);
@@ -54,6 +54,11 @@ namespace eagle::asmb
         return function_segments;
     }
 
+    size_t code_container::get_segment_count() const
+    {
+        return function_segments.size();
+    }
+
     code_container::code_container()
     {
         is_named = false;
@@ -1,4 +1,6 @@
 #include "eaglevm-core/compiler/section_manager.h"
+#include "eaglevm-core/util/assert.h"
+#include "eaglevm-core/util/profiler.h"
 #include "eaglevm-core/util/random.h"
 
 #include <ranges>
@@ -30,6 +32,8 @@ namespace eagle::asmb
 
     codec::encoded_vec section_manager::compile_section(const uint64_t base_address, const uint64_t runtime_base)
     {
+        VM_PROFILE_SCOPE("asmb.compile_section");
+
         if (shuffle_functions)
             shuffle_containers();
 
@@ -112,7 +116,7 @@ namespace eagle::asmb
                                 else if constexpr (std::is_same_v<T, codec::enc::req>)
                                     request = arg;
                                 else
-                                    __debugbreak();
+                                    VM_BREAK();
 
                                 attempt_instruction_fix(request);
 
@@ -138,6 +142,7 @@ namespace eagle::asmb
             }
         }
 
+        util::profiler::add_counter("asmb.section_bytes", compiled_section.size());
         return compiled_section;
     }
 
@@ -2,6 +2,8 @@
 #include <ranges>
 #include <unordered_set>
 
+#include "eaglevm-core/util/profiler.h"
+
 namespace eagle::dasm::analysis
 {
     liveness::liveness(segment_dasm_ptr segment)
@@ -11,6 +13,8 @@ namespace eagle::dasm::analysis
 
     void liveness::analyze_cross_liveness(const basic_block_ptr& exit_block)
     {
+        VM_PROFILE_SCOPE("dasm.liveness.cross");
+
         bool changed = true;
         while (changed)
         {
@@ -93,6 +97,8 @@ namespace eagle::dasm::analysis
 
     void liveness::compute_use_def()
     {
+        VM_PROFILE_SCOPE("dasm.liveness.use_def");
+
         for (auto& block : segment->blocks)
         {
             liveness_info use, def = {};
@@ -11,6 +11,11 @@ namespace eagle::dasm
     block_end_reason basic_block::get_end_reason() const
     {
         const auto& [inst, _] = decoded_insts.back();
+
+        // a ret never falls through but it does not have a target either
+        if (inst.mnemonic == ZYDIS_MNEMONIC_RET)
+            return block_end;
+
         if (inst.meta.branch_type != ZYDIS_BRANCH_TYPE_NONE && inst.mnemonic != ZYDIS_MNEMONIC_CALL)
         {
             // this is either JMP or conditional JMP
@@ -27,7 +32,8 @@ namespace eagle::dasm
     bool basic_block::is_conditional_jump() const
     {
         const auto& [instruction, _] = decoded_insts.back();
-        return instruction.meta.branch_type != ZYDIS_BRANCH_TYPE_NONE && instruction.mnemonic != ZYDIS_MNEMONIC_JMP;
+        return instruction.meta.branch_type != ZYDIS_BRANCH_TYPE_NONE && instruction.mnemonic != ZYDIS_MNEMONIC_JMP &&
+            instruction.mnemonic != ZYDIS_MNEMONIC_RET;
     }
 
     bool basic_block::is_jump() const
@@ -1,5 +1,7 @@
 #include "eaglevm-core/disassembler/disassembler.h"
 
+#include "eaglevm-core/util/profiler.h"
+
 namespace eagle::dasm
 {
     segment_dasm::segment_dasm(const codec::decode_vec& segment, const uint64_t binary_rva, const uint64_t binary_end)
@@ -13,6 +15,8 @@ namespace eagle::dasm
 
     basic_block_ptr segment_dasm::generate_blocks()
     {
+        VM_PROFILE_SCOPE("dasm.generate_blocks");
+
         uint64_t block_start_rva = rva_begin;
         uint64_t current_rva = rva_begin;
 
@@ -21,8 +25,8 @@ namespace eagle::dasm
         {
             block_instructions.push_back(inst);
 
-            if (inst.instruction.meta.branch_type != ZYDIS_BRANCH_TYPE_NONE &&
-                inst.instruction.mnemonic != ZYDIS_MNEMONIC_CALL)
+            if ((inst.instruction.meta.branch_type != ZYDIS_BRANCH_TYPE_NONE &&
+                inst.instruction.mnemonic != ZYDIS_MNEMONIC_CALL) || inst.instruction.mnemonic == ZYDIS_MNEMONIC_RET)
             {
                 // end of our block
                 basic_block_ptr block = std::make_shared<basic_block>();
@@ -104,6 +108,9 @@ namespace eagle::dasm
             return a->start_rva < b->start_rva;
         });
 
+        util::profiler::add_counter("dasm.instructions", function.size());
+        util::profiler::add_counter("dasm.blocks", blocks.size());
+
         return blocks[0];
     }
 
@@ -0,0 +1,1545 @@
+#include "eaglevm-core/interpreter/interpreter.h"
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#include "eaglevm-core/util/assert.h"
+
+namespace eagle::interp
+{
+    namespace
+    {
+        uint64_t size_mask(const uint16_t bits)
+        {
+            return bits >= 64 ? ~0ull : (1ull << bits) - 1;
+        }
+
+        bool sign_of(const uint64_t value, const uint16_t bits)
+        {
+            return (value >> (bits - 1)) & 1;
+        }
+
+        int64_t sign_extend(const uint64_t value, const uint16_t bits)
+        {
+            if (bits >= 64)
+                return static_cast<int64_t>(value);
+
+            uint64_t result = value & size_mask(bits);
+            if (sign_of(result, bits))
+                result |= ~size_mask(bits);
+
+            return static_cast<int64_t>(result);
+        }
+
+        // 64 x 64 -> 128 without relying on compiler extensions
+        uint64_t multiply_128(const uint64_t a, const uint64_t b, uint64_t& high)
+        {
+            const uint64_t a_low = a & 0xFFFFFFFF;
+            const uint64_t a_high = a >> 32;
+            const uint64_t b_low = b & 0xFFFFFFFF;
+            const uint64_t b_high = b >> 32;
+
+            const uint64_t low_low = a_low * b_low;
+            const uint64_t low_high = a_low * b_high;
+            const uint64_t high_low = a_high * b_low;
+            const uint64_t high_high = a_high * b_high;
+
+            const uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFF) + (high_low & 0xFFFFFFFF);
+            high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+
+            return (middle << 32) | (low_low & 0xFFFFFFFF);
+        }
+
+        // 128 / 64, high has to be below the divisor so the quotient fits
+        uint64_t divide_128(uint64_t high, uint64_t low, const uint64_t divisor, uint64_t& remainder)
+        {
+            uint64_t quotient = 0;
+            for (int i = 0; i < 64; i++)
+            {
+                const bool carry = high >> 63;
+                high = high << 1 | low >> 63;
+                low <<= 1;
+
+                quotient <<= 1;
+                if (carry || high >= divisor)
+                {
+                    high -= divisor;
+                    quotient |= 1;
+                }
+            }
+
+            remainder = high;
+            return quotient;
+        }
+
+        void negate_128(uint64_t& high, uint64_t& low)
+        {
+            low = ~low + 1;
+            high = ~high + (low == 0);
+        }
+
+        double as_double(const uint64_t value)
+        {
+            return std::bit_cast<double>(value);
+        }
+
+        float as_float(const uint64_t value)
+        {
+            return std::bit_cast<float>(static_cast<uint32_t>(value));
+        }
+
+        uint64_t from_double(const double value)
+        {
+            return std::bit_cast<uint64_t>(value);
+        }
+
+        uint64_t from_float(const float value)
+        {
+            return std::bit_cast<uint32_t>(value);
+        }
+
+        // out of range and nan conversions produce the integer indefinite value
+        uint64_t convert_to_integer(const double value, const uint16_t bits, const bool truncate)
+        {
+            const double rounded = truncate ? std::trunc(value) : std::nearbyint(value);
+            const uint64_t indefinite = 1ull << (bits - 1);
+
+            const double limit = std::ldexp(1.0, bits - 1);
+            if (std::isnan(rounded) || rounded >= limit || rounded < -limit)
+                return indefinite;
+
+            return static_cast<uint64_t>(static_cast<int64_t>(rounded)) & size_mask(bits);
+        }
+
+        bool is_xmm(const codec::dec::operand& operand)
+        {
+            return operand.type == ZYDIS_OPERAND_TYPE_REGISTER && ZydisRegisterGetClass(operand.reg.value) == ZYDIS_REGCLASS_XMM;
+        }
+
+        uint8_t xmm_index(const codec::dec::operand& operand)
+        {
+            return static_cast<uint8_t>(operand.reg.value - ZYDIS_REGISTER_XMM0);
+        }
+    }
+
+    interpreter::interpreter(memory& memory)
+        : mem(memory)
+    {
+    }
+
+    cpu_state& interpreter::get_state()
+    {
+        return state;
+    }
+
+    const cpu_state& interpreter::get_state() const
+    {
+        return state;
+    }
+
+    exec_status interpreter::step()
+    {
+        codec::dec::inst_info decode;
+        if (const exec_status status = fetch(decode); status != exec_status::success)
+            return status;
+
+        if (trace)
+            trace(state, decode);
+
+        // rip relative operands and branches work off the next instruction
+        const uint64_t inst_rip = state.rip;
+        state.rip += decode.instruction.length;
+
+        const exec_status status = execute(decode);
+        if (status != exec_status::success)
+        {
+            state.rip = inst_rip;
+            return status;
+        }
+
+        executed++;
+        return status;
+    }
+
+    exec_status interpreter::run(const uint64_t max_steps)
+    {
+        for (uint64_t i = 0; i < max_steps; i++)
+        {
+            const exec_status status = step();
+            if (status != exec_status::success)
+                return status;
+        }
+
+        return exec_status::step_limit;
+    }
+
+    void interpreter::set_trace(trace_callback callback)
+    {
+        trace = std::move(callback);
+    }
+
+    uint64_t interpreter::get_executed() const
+    {
+        return executed;
+    }
+
+    uint64_t interpreter::get_fault_address() const
+    {
+        return fault_address;
+    }
+
+    exec_status interpreter::fetch(codec::dec::inst_info& decode)
+    {
+        if (const auto it = decode_cache.find(state.rip); it != decode_cache.end())
+        {
+            decode = it->second;
+            return exec_status::success;
+        }
+
+        uint8_t buffer[ZYDIS_MAX_INSTRUCTION_LENGTH];
+        const uint64_t available = mem.fetch(state.rip, buffer, sizeof(buffer));
+        if (available == 0)
+        {
+            fault_address = state.rip;
+            return exec_status::memory_fault;
+        }
+
+        if (!ZYAN_SUCCESS(ZydisDecoderDecodeFull(&zyids_decoder, buffer, available, &decode.instruction, decode.operands)))
+            return exec_status::invalid_instruction;
+
+        decode_cache[state.rip] = decode;
+        code_pages.insert(state.rip & ~(memory::page_size - 1));
+        code_pages.insert((state.rip + decode.instruction.length - 1) & ~(memory::page_size - 1));
+
+        return exec_status::success;
+    }
+
+    exec_status interpreter::execute(const codec::dec::inst_info& decode)
+    {
+        const codec::dec::inst& inst = decode.instruction;
+        const codec::dec::operand* ops = decode.operands;
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+
+        switch (mnemonic)
+        {
+            case codec::m_nop:
+            case codec::m_pause:
+            case codec::m_endbr64:
+                return exec_status::success;
+
+            case codec::m_ud2:
+            case codec::m_vmcall:
+            case codec::m_int3:
+            case codec::m_hlt:
+                return exec_status::trap;
+
+            case codec::m_mov:
+            {
+                // segment registers are not modeled
+                if (ops[0].type == ZYDIS_OPERAND_TYPE_REGISTER && ZydisRegisterGetClass(ops[0].reg.value) == ZYDIS_REGCLASS_SEGMENT)
+                    return exec_status::unsupported_instruction;
+
+                uint64_t value;
+                if (!read_operand(inst, ops[1], value) || !write_operand(inst, ops[0], value))
+                    return exec_status::memory_fault;
+
+                return exec_status::success;
+            }
+            case codec::m_movzx:
+            case codec::m_movsx:
+            case codec::m_movsxd:
+            {
+                uint64_t value;
+                if (!read_operand(inst, ops[1], value))
+                    return exec_status::memory_fault;
+
+                if (mnemonic != codec::m_movzx)
+                    value = static_cast<uint64_t>(sign_extend(value, ops[1].size));
+
+                if (!write_operand(inst, ops[0], value & size_mask(ops[0].size)))
+                    return exec_status::memory_fault;
+
+                return exec_status::success;
+            }
+            case codec::m_lea:
+            {
+                write_reg(static_cast<codec::reg>(ops[0].reg.value), get_address(inst, ops[1]) & size_mask(ops[0].size));
+                return exec_status::success;
+            }
+            case codec::m_xchg:
+            {
+                uint64_t first, second;
+                if (!read_operand(inst, ops[0], first) || !read_operand(inst, ops[1], second))
+                    return exec_status::memory_fault;
+
+                if (!write_operand(inst, ops[0], second) || !write_operand(inst, ops[1], first))
+                    return exec_status::memory_fault;
+
+                return exec_status::success;
+            }
+            case codec::m_cmpxchg:
+            {
+                const uint16_t bits = ops[0].size;
+                const codec::reg accumulator = codec::get_bit_version(codec::rax, static_cast<codec::reg_size>(bits));
+
+                uint64_t target, source;
+                if (!read_operand(inst, ops[0], target) || !read_operand(inst, ops[1], source))
+                    return exec_status::memory_fault;
+
+                const uint64_t compare = read_reg(accumulator);
+                const uint64_t result = (compare - target) & size_mask(bits);
+
+                set_result_flags(result, bits);
+                set_flag(flag_cf, compare < target);
+                set_flag(flag_of, sign_of((compare ^ target) & (compare ^ result), bits));
+                set_flag(flag_af, ((compare ^ target ^ result) >> 4) & 1);
+
+                if (compare == target)
+                    return write_operand(inst, ops[0], source) ? exec_status::success : exec_status::memory_fault;
+
+                write_reg(accumulator, target);
+                return exec_status::success;
+            }
+
+            case codec::m_add:
+            case codec::m_adc:
+            case codec::m_sub:
+            case codec::m_sbb:
+            case codec::m_cmp:
+            {
+                const uint16_t bits = ops[0].size;
+                const uint64_t mask = size_mask(bits);
+
+                uint64_t a, b;
+                if (!read_operand(inst, ops[0], a) || !read_operand(inst, ops[1], b))
+                    return exec_status::memory_fault;
+
+                a &= mask;
+                b &= mask;
+
+                const bool carry_in = (mnemonic == codec::m_adc || mnemonic == codec::m_sbb) && get_flag(flag_cf);
+
+                uint64_t result;
+                bool carry, overflow;
+                if (mnemonic == codec::m_add || mnemonic == codec::m_adc)
+                {
+                    result = (a + b + carry_in) & mask;
+                    carry = bits == 64 ? result < a || (carry_in && result == a) : ((a + b + carry_in) >> bits) & 1;
+                    overflow = sign_of((a ^ result) & (b ^ result), bits);
+                }
+                else
+                {
+                    result = (a - b - carry_in) & mask;
+                    carry = a < b || (carry_in && a == b);
+                    overflow = sign_of((a ^ b) & (a ^ result), bits);
+                }
+
+                set_result_flags(result, bits);
+                set_flag(flag_cf, carry);
+                set_flag(flag_of, overflow);
+                set_flag(flag_af, ((a ^ b ^ result) >> 4) & 1);
+
+                if (mnemonic != codec::m_cmp && !write_operand(inst, ops[0], result))
+                    return exec_status::memory_fault;
+
+                return exec_status::success;
+            }
+            case codec::m_and:
+            case codec::m_or:
+            case codec::m_xor:
+            case codec::m_test:
+            {
+                const uint16_t bits = ops[0].size;
+
+                uint64_t a, b;
+                if (!read_operand(inst, ops[0], a) || !read_operand(inst, ops[1], b))
+                    return exec_status::memory_fault;
+
+                uint64_t result;
+                if (mnemonic == codec::m_or)
+                    result = a | b;
+                else if (mnemonic == codec::m_xor)
+                    result = a ^ b;
+                else
+                    result = a & b;
+
+                result &= size_mask(bits);
+
+                set_result_flags(result, bits);
+                set_flag(flag_cf, false);
+                set_flag(flag_of, false);
+                set_flag(flag_af, false);
+
+                if (mnemonic != codec::m_test && !write_operand(inst, ops[0], result))
+                    return exec_status::memory_fault;
+
+                return exec_status::success;
+            }
+            case codec::m_inc:
+            case codec::m_dec:
+            {
+                const uint16_t bits = ops[0].size;
+
+                uint64_t a;
+                if (!read_operand(inst, ops[0], a))
+                    return exec_status::memory_fault;
+
+                a &= size_mask(bits);
+
+                // carry is left alone
+                const bool increment = mnemonic == codec::m_inc;
+                const uint64_t result = (increment ? a + 1 : a - 1) & size_mask(bits);
+
+                set_result_flags(result, bits);
+                set_flag(flag_of, increment ? result == 1ull << (bits - 1) : a == 1ull << (bits - 1));
+                set_flag(flag_af, ((a ^ 1 ^ result) >> 4) & 1);
+
+                return write_operand(inst, ops[0], result) ? exec_status::success : exec_status::memory_fault;
+            }
+            case codec::m_neg:
+            {
+                const uint16_t bits = ops[0].size;
+
+                uint64_t a;
+                if (!read_operand(inst, ops[0], a))
+                    return exec_status::memory_fault;
+
+                a &= size_mask(bits);
+                const uint64_t result = (0 - a) & size_mask(bits);
+
+                set_result_flags(result, bits);
+                set_flag(flag_cf, a != 0);
+                set_flag(flag_of, a == 1ull << (bits - 1));
+                set_flag(flag_af, ((a ^ result) >> 4) & 1);
+
+                return write_operand(inst, ops[0], result) ? exec_status::success : exec_status::memory_fault;
+            }
+            case codec::m_not:
+            {
+                uint64_t a;
+                if (!read_operand(inst, ops[0], a))
+                    return exec_status::memory_fault;
+
+                return write_operand(inst, ops[0], ~a & size_mask(ops[0].size)) ? exec_status::success : exec_status::memory_fault;
+            }
+
+            case codec::m_shl:
+            case codec::m_shr:
+            case codec::m_sar:
+            case codec::m_rol:
+            case codec::m_ror:
+            case codec::m_rcl:
+            case codec::m_rcr:
+            {
+                const uint16_t bits = ops[0].size;
+                const uint64_t mask = size_mask(bits);
+
+                uint64_t a, count = 1;
+                if (!read_operand(inst, ops[0], a))
+                    return exec_status::memory_fault;
+
+                if (inst.operand_count_visible > 1 && !read_operand(inst, ops[1], count))
+                    return exec_status::memory_fault;
+
+                a &= mask;
+                count &= bits == 64 ? 0x3F : 0x1F;
+
+                // a zero count leaves flags alone
+                if (count == 0)
+                    return write_operand(inst, ops[0], a) ? exec_status::success : exec_status::memory_fault;
+
+                uint64_t result = a;
+                switch (mnemonic)
+                {
+                    case codec::m_shl:
+                    {
+                        result = (a << count) & mask;
+
+                        const bool carry = count <= bits && (a >> (bits - count)) & 1;
+                        set_result_flags(result, bits);
+                        set_flag(flag_cf, carry);
+                        set_flag(flag_of, sign_of(result, bits) != carry);
+                        set_flag(flag_af, false);
+                        break;
+                    }
+                    case codec::m_shr:
+                    {
+                        result = a >> count;
+
+                        set_result_flags(result, bits);
+                        set_flag(flag_cf, (a >> (count - 1)) & 1);
+                        set_flag(flag_of, sign_of(a, bits));
+                        set_flag(flag_af, false);
+                        break;
+                    }
+                    case codec::m_sar:
+                    {
+                        const int64_t value = sign_extend(a, bits);
+                        result = static_cast<uint64_t>(value >> std::min<uint64_t>(count, 63)) & mask;
+
+                        set_result_flags(result, bits);
+                        set_flag(flag_cf, (value >> std::min<uint64_t>(count - 1, 63)) & 1);
+                        set_flag(flag_of, false);
+                        set_flag(flag_af, false);
+                        break;
+                    }
+                    case codec::m_rol:
+                    case codec::m_ror:
+                    {
+                        const uint64_t rotate = count % bits;
+                        if (mnemonic == codec::m_rol)
+                            result = rotate ? (a << rotate | a >> (bits - rotate)) & mask : a;
+                        else
+                            result = rotate ? (a >> rotate | a << (bits - rotate)) & mask : a;
+
+                        if (mnemonic == codec::m_rol)
+                        {
+                            set_flag(flag_cf, result & 1);
+                            set_flag(flag_of, sign_of(result, bits) != static_cast<bool>(result & 1));
+                        }
+                        else
+                        {
+                            set_flag(flag_cf, sign_of(result, bits));
+                            set_flag(flag_of, sign_of(result, bits) != sign_of(result, bits - 1));
+                        }
+
+                        break;
+                    }
+                    default:
+                    {
+                        // rotating through carry works on bits + 1
+                        uint64_t rotate = count;
+                        if (bits == 8)
+                            rotate %= 9;
+                        else if (bits == 16)
+                            rotate %= 17;
+
+                        bool carry = get_flag(flag_cf);
+                        if (mnemonic == codec::m_rcr)
+                            set_flag(flag_of, sign_of(a, bits) != carry);
+
+                        for (uint64_t i = 0; i < rotate; i++)
+                        {
+                            if (mnemonic == codec::m_rcl)
+                            {
+                                const bool out = sign_of(result, bits);
+                                result = (result << 1 | carry) & mask;
+                                carry = out;
+                            }
+                            else
+                            {
+                                const bool out = result & 1;
+                                result = result >> 1 | static_cast<uint64_t>(carry) << (bits - 1);
+                                carry = out;
+                            }
+                        }
+
+                        set_flag(flag_cf, carry);
+                        if (mnemonic == codec::m_rcl)
+                            set_flag(flag_of, sign_of(result, bits) != carry);
+
+                        break;
+                    }
+                }
+
+                return write_operand(inst, ops[0], result) ? exec_status::success : exec_status::memory_fault;
+            }
+
+            case codec::m_imul:
+            {
+                // the single operand form works on rdx:rax like mul
+                if (inst.operand_count_visible != 1)
+                {
+                    const uint16_t bits = ops[0].size;
+                    const codec::dec::operand& first = inst.operand_count_visible == 3 ? ops[1] : ops[0];
+                    const codec::dec::operand& second = inst.operand_count_visible == 3 ? ops[2] : ops[1];
+
+                    uint64_t a, b;
+                    if (!read_operand(inst, first, a) || !read_operand(inst, second, b))
+                        return exec_status::memory_fault;
+
+                    uint64_t result;
+                    bool overflow;
+                    if (bits == 64)
+                    {
+                        uint64_t high;
+                        result = multiply_128(a, b, high);
+                        high -= (static_cast<int64_t>(a) < 0 ? b : 0) + (static_cast<int64_t>(b) < 0 ? a : 0);
+
+                        overflow = high != (static_cast<int64_t>(result) < 0 ? ~0ull : 0);
+                    }
+                    else
+                    {
+                        const int64_t product = sign_extend(a, bits) * sign_extend(b, bits);
+                        result = static_cast<uint64_t>(product) & size_mask(bits);
+
+                        overflow = sign_extend(result, bits) != product;
+                    }
+
+                    set_result_flags(result, bits);
+                    set_flag(flag_cf, overflow);
+                    set_flag(flag_of, overflow);
+                    set_flag(flag_af, false);
+
+                    write_reg(static_cast<codec::reg>(ops[0].reg.value), result);
+                    return exec_status::success;
+                }
+
+                [[fallthrough]];
+            }
+            case codec::m_mul:
+            case codec::m_div:
+            case codec::m_idiv:
+            {
+                const uint16_t bits = ops[0].size;
+                const uint64_t mask = size_mask(bits);
+                const bool is_signed = mnemonic == codec::m_imul || mnemonic == codec::m_idiv;
+
+                uint64_t source;
+                if (!read_operand(inst, ops[0], source))
+                    return exec_status::memory_fault;
+
+                source &= mask;
+
+                // the 8 bit forms keep both halves in ax
+                uint64_t low, high;
+                if (bits == 8)
+                {
+                    const uint64_t ax = read_reg(codec::ax);
+                    low = ax & 0xFF;
+                    high = ax >> 8;
+                }
+                else
+                {
+                    low = read_reg(codec::get_bit_version(codec::rax, static_cast<codec::reg_size>(bits)));
+                    high = read_reg(codec::get_bit_version(codec::rdx, static_cast<codec::reg_size>(bits)));
+                }
+
+                if (mnemonic == codec::m_mul || mnemonic == codec::m_imul)
+                {
+                    if (bits == 64)
+                    {
+                        low = multiply_128(low, source, high);
+                        if (is_signed)
+                            high -= (static_cast<int64_t>(source) < 0 ? read_reg(codec::rax) : 0) +
+                                (static_cast<int64_t>(read_reg(codec::rax)) < 0 ? source : 0);
+                    }
+                    else
+                    {
+                        const uint64_t product = is_signed
+                            ? static_cast<uint64_t>(sign_extend(low, bits) * sign_extend(source, bits))
+                            : low * source;
+
+                        low = product & mask;
+                        high = (product >> bits) & mask;
+                    }
+
+                    const bool overflow = is_signed
+                        ? high != (sign_of(low, bits) ? mask : 0)
+                        : high != 0;
+
+                    set_result_flags(low, bits);
+                    set_flag(flag_cf, overflow);
+                    set_flag(flag_of, overflow);
+                    set_flag(flag_af, false);
+                }
+                else
+                {
+                    if (source == 0)
+                        return exec_status::divide_error;
+
+                    uint64_t quotient, remainder;
+                    if (bits == 64)
+                    {
+                        if (is_signed)
+                        {
+                            const bool dividend_negative = static_cast<int64_t>(high) < 0;
+                            const bool divisor_negative = static_cast<int64_t>(source) < 0;
+
+                            if (dividend_negative)
+                                negate_128(high, low);
+
+                            const uint64_t divisor = divisor_negative ? 0 - source : source;
+                            if (high >= divisor)
+                                return exec_status::divide_error;
+
+                            quotient = divide_128(high, low, divisor, remainder);
+
+                            const bool quotient_negative = dividend_negative != divisor_negative;
+                            if (quotient > (quotient_negative ? 1ull << 63 : (1ull << 63) - 1))
+                                return exec_status::divide_error;
+
+                            if (quotient_negative)
+                                quotient = 0 - quotient;
+                            if (dividend_negative)
+                                remainder = 0 - remainder;
+                        }
+                        else
+                        {
+                            if (high >= source)
+                                return exec_status::divide_error;
+
+                            quotient = divide_128(high, low, source, remainder);
+                        }
+                    }
+                    else
+                    {
+                        const uint64_t dividend = high << bits | low;
+                        if (is_signed)
+                        {
+                            const int64_t numerator = sign_extend(dividend, bits * 2);
+                            const int64_t denominator = sign_extend(source, bits);
+
+                            // int64 min / -1 does not fit any of these widths either
+                            if (denominator == -1 && numerator == INT64_MIN)
+                                return exec_status::divide_error;
+
+                            const int64_t signed_quotient = numerator / denominator;
+                            if (signed_quotient < -static_cast<int64_t>(1ull << (bits - 1)) || signed_quotient > static_cast<int64_t>((1ull << (bits - 1)) - 1))
+                                return exec_status::divide_error;
+
+                            quotient = static_cast<uint64_t>(signed_quotient) & mask;
+                            remainder = static_cast<uint64_t>(numerator % denominator) & mask;
+                        }
+                        else
+                        {
+                            quotient = dividend / source;
+                            if (quotient > mask)
+                                return exec_status::divide_error;
+
+                            remainder = dividend % source;
+                        }
+                    }
+
+                    low = quotient;
+                    high = remainder;
+                }
+
+                if (bits == 8)
+                {
+                    write_reg(codec::ax, (high & 0xFF) << 8 | (low & 0xFF));
+                }
+                else
+                {
+                    write_reg(codec::get_bit_version(codec::rax, static_cast<codec::reg_size>(bits)), low);
+                    write_reg(codec::get_bit_version(codec::rdx, static_cast<codec::reg_size>(bits)), high);
+                }
+
+                return exec_status::success;
+            }
+
+            case codec::m_cbw:
+                write_reg(codec::ax, static_cast<uint64_t>(sign_extend(read_reg(codec::al), 8)) & 0xFFFF);
+                return exec_status::success;
+            case codec::m_cwde:
+                write_reg(codec::eax, static_cast<uint64_t>(sign_extend(read_reg(codec::ax), 16)) & 0xFFFFFFFF);
+                return exec_status::success;
+            case codec::m_cdqe:
+                write_reg(codec::rax, static_cast<uint64_t>(sign_extend(read_reg(codec::eax), 32)));
+                return exec_status::success;
+            case codec::m_cwd:
+                write_reg(codec::dx, sign_of(read_reg(codec::ax), 16) ? 0xFFFF : 0);
+                return exec_status::success;
+            case codec::m_cdq:
+                write_reg(codec::edx, sign_of(read_reg(codec::eax), 32) ? 0xFFFFFFFF : 0);
+                return exec_status::success;
+            case codec::m_cqo:
+                write_reg(codec::rdx, sign_of(read_reg(codec::rax), 64) ? ~0ull : 0);
+                return exec_status::success;
+
+            case codec::m_bswap:
+            {
+                const codec::reg target = static_cast<codec::reg>(ops[0].reg.value);
+                const uint64_t value = read_reg(target);
+                write_reg(target, ops[0].size == 64 ? std::byteswap(value) : std::byteswap(static_cast<uint32_t>(value)));
+                return exec_status::success;
+            }
+            case codec::m_bt:
+            case codec::m_bts:
+            case codec::m_btr:
+            case codec::m_btc:
+            {
+                const uint16_t bits = ops[0].size;
+
+                uint64_t offset;
+                if (!read_operand(inst, ops[1], offset))
+                    return exec_status::memory_fault;
+
+                // a register offset into memory can reach outside of the operand
+                codec::dec::operand target = ops[0];
+                if (target.type == ZYDIS_OPERAND_TYPE_MEMORY && ops[1].type == ZYDIS_OPERAND_TYPE_REGISTER)
+                {
+                    const int64_t signed_offset = sign_extend(offset, ops[1].size);
+                    const int64_t element = signed_offset >= 0 ? signed_offset / bits : (signed_offset - bits + 1) / bits;
+                    target.mem.disp.value += element * (bits / 8);
+                }
+
+                const uint64_t bit = offset & (bits - 1);
+
+                uint64_t value;
+                if (!read_operand(inst, target, value))
+                    return exec_status::memory_fault;
+
+                set_flag(flag_cf, (value >> bit) & 1);
+                if (mnemonic == codec::m_bt)
+                    return exec_status::success;
+
+                if (mnemonic == codec::m_bts)
+                    value |= 1ull << bit;
+                else if (mnemonic == codec::m_btr)
+                    value &= ~(1ull << bit);
+                else
+                    value ^= 1ull << bit;
+
+                return write_operand(inst, target, value) ? exec_status::success : exec_status::memory_fault;
+            }
+            case codec::m_bsf:
+            case codec::m_bsr:
+            {
+                uint64_t value;
+                if (!read_operand(inst, ops[1], value))
+                    return exec_status::memory_fault;
+
+                value &= size_mask(ops[1].size);
+                set_flag(flag_zf, value == 0);
+
+                // the destination is left alone for a zero source
+                if (value == 0)
+                    return exec_status::success;
+
+                const uint64_t index = mnemonic == codec::m_bsf ? std::countr_zero(value) : 63 - std::countl_zero(value);
+                write_reg(static_cast<codec::reg>(ops[0].reg.value), index);
+                return exec_status::success;
+            }
+
+            case codec::m_clc:
+                set_flag(flag_cf, false);
+                return exec_status::success;
+            case codec::m_stc:
+                set_flag(flag_cf, true);
+                return exec_status::success;
+            case codec::m_cmc:
+                set_flag(flag_cf, !get_flag(flag_cf));
+                return exec_status::success;
+            case codec::m_cld:
+                set_flag(flag_df, false);
+                return exec_status::success;
+            case codec::m_std:
+                set_flag(flag_df, true);
+                return exec_status::success;
+            case codec::m_lahf:
+                write_reg(codec::ah, (state.rflags & 0xD5) | 0x2);
+                return exec_status::success;
+            case codec::m_sahf:
+                state.rflags = (state.rflags & ~0xD5ull) | (read_reg(codec::ah) & 0xD5) | 0x2;
+                return exec_status::success;
+
+            case codec::m_cmovo:
+            case codec::m_cmovno:
+            case codec::m_cmovb:
+            case codec::m_cmovnb:
+            case codec::m_cmovz:
+            case codec::m_cmovnz:
+            case codec::m_cmovbe:
+            case codec::m_cmovnbe:
+            case codec::m_cmovs:
+            case codec::m_cmovns:
+            case codec::m_cmovp:
+            case codec::m_cmovnp:
+            case codec::m_cmovl:
+            case codec::m_cmovnl:
+            case codec::m_cmovle:
+            case codec::m_cmovnle:
+            {
+                uint64_t value;
+                if (!read_operand(inst, ops[1], value))
+                    return exec_status::memory_fault;
+
+                // a 32 bit destination gets zero extended even when nothing moves
+                const codec::reg target = static_cast<codec::reg>(ops[0].reg.value);
+                write_reg(target, test_condition(mnemonic) ? value : read_reg(target));
+                return exec_status::success;
+            }
+            case codec::m_seto:
+            case codec::m_setno:
+            case codec::m_setb:
+            case codec::m_setnb:
+            case codec::m_setz:
+            case codec::m_setnz:
+            case codec::m_setbe:
+            case codec::m_setnbe:
+            case codec::m_sets:
+            case codec::m_setns:
+            case codec::m_setp:
+            case codec::m_setnp:
+            case codec::m_setl:
+            case codec::m_setnl:
+            case codec::m_setle:
+            case codec::m_setnle:
+                return write_operand(inst, ops[0], test_condition(mnemonic)) ? exec_status::success : exec_status::memory_fault;
+
+            case codec::m_push:
+            {
+                uint64_t value;
+                if (!read_operand(inst, ops[0], value))
+                    return exec_status::memory_fault;
+
+                return push(value, inst.operand_width / 8) ? exec_status::success : exec_status::memory_fault;
+            }
+            case codec::m_pop:
+            {
+                uint64_t value;
+                if (!pop(value, inst.operand_width / 8) || !write_operand(inst, ops[0], value))
+                    return exec_status::memory_fault;
+
+                return exec_status::success;
+            }
+            case codec::m_pushfq:
+                return push(state.rflags & ~flag_tf) ? exec_status::success : exec_status::memory_fault;
+            case codec::m_popfq:
+            {
+                uint64_t value;
+                if (!pop(value))
+                    return exec_status::memory_fault;
+
+                // user mode can only change the status flags, df, tf, ac and id
+                constexpr uint64_t writable = 0x0DD5 | flag_tf | 0x40000 | 0x200000;
+                state.rflags = (state.rflags & ~writable) | (value & writable) | 0x2;
+                return exec_status::success;
+            }
+            case codec::m_leave:
+            {
+                state.gpr[ZYDIS_REGISTER_RSP - ZYDIS_REGISTER_RAX] = state.gpr[ZYDIS_REGISTER_RBP - ZYDIS_REGISTER_RAX];
+
+                uint64_t value;
+                if (!pop(value))
+                    return exec_status::memory_fault;
+
+                state.gpr[ZYDIS_REGISTER_RBP - ZYDIS_REGISTER_RAX] = value;
+                return exec_status::success;
+            }
+
+            case codec::m_jmp:
+            case codec::m_call:
+            {
+                uint64_t target;
+                if (ops[0].type == ZYDIS_OPERAND_TYPE_IMMEDIATE)
+                    target = state.rip + ops[0].imm.value.s;
+                else if (!read_operand(inst, ops[0], target))
+                    return exec_status::memory_fault;
+
+                if (mnemonic == codec::m_call && !push(state.rip))
+                    return exec_status::memory_fault;
+
+                state.rip = target;
+                return exec_status::success;
+            }
+            case codec::m_ret:
+            {
+                uint64_t target;
+                if (!pop(target))
+                    return exec_status::memory_fault;
+
+                if (inst.operand_count_visible)
+                    state.gpr[ZYDIS_REGISTER_RSP - ZYDIS_REGISTER_RAX] += ops[0].imm.value.u;
+
+                state.rip = target;
+                return exec_status::success;
+            }
+            case codec::m_jo:
+            case codec::m_jno:
+            case codec::m_jb:
+            case codec::m_jnb:
+            case codec::m_jz:
+            case codec::m_jnz:
+            case codec::m_jbe:
+            case codec::m_jnbe:
+            case codec::m_js:
+            case codec::m_jns:
+            case codec::m_jp:
+            case codec::m_jnp:
+            case codec::m_jl:
+            case codec::m_jnl:
+            case codec::m_jle:
+            case codec::m_jnle:
+            {
+                if (test_condition(mnemonic))
+                    state.rip += ops[0].imm.value.s;
+
+                return exec_status::success;
+            }
+            case codec::m_jrcxz:
+            case codec::m_jecxz:
+            {
+                const uint64_t count = read_reg(mnemonic == codec::m_jrcxz ? codec::rcx : codec::ecx);
+                if (count == 0)
+                    state.rip += ops[0].imm.value.s;
+
+                return exec_status::success;
+            }
+
+            case codec::m_movsb:
+            case codec::m_movsw:
+            case codec::m_movsq:
+            case codec::m_stosb:
+            case codec::m_stosw:
+            case codec::m_stosd:
+            case codec::m_stosq:
+            case codec::m_lodsb:
+            case codec::m_lodsw:
+            case codec::m_lodsd:
+            case codec::m_lodsq:
+                return execute_string(decode);
+            case codec::m_movsd:
+            {
+                // movsd is both the string move and the scalar double move
+                if (ops[0].type == ZYDIS_OPERAND_TYPE_MEMORY && ops[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+                    return execute_string(decode);
+
+                return execute_sse(decode);
+            }
+
+            default:
+                return execute_sse(decode);
+        }
+    }
+
+    exec_status interpreter::execute_string(const codec::dec::inst_info& decode)
+    {
+        const codec::dec::inst& inst = decode.instruction;
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+
+        const uint16_t bytes = decode.operands[0].size / 8;
+        const int64_t step = get_flag(flag_df) ? -static_cast<int64_t>(bytes) : bytes;
+
+        uint64_t& rsi = state.gpr[ZYDIS_REGISTER_RSI - ZYDIS_REGISTER_RAX];
+        uint64_t& rdi = state.gpr[ZYDIS_REGISTER_RDI - ZYDIS_REGISTER_RAX];
+        uint64_t& rcx = state.gpr[ZYDIS_REGISTER_RCX - ZYDIS_REGISTER_RAX];
+
+        const bool rep = inst.attributes & ZYDIS_ATTRIB_HAS_REP;
+        const codec::reg accumulator = codec::get_bit_version(codec::rax, static_cast<codec::reg_size>(bytes * 8));
+
+        for (uint64_t remaining = rep ? rcx : 1; remaining; remaining--)
+        {
+            uint64_t value = 0;
+            switch (mnemonic)
+            {
+                case codec::m_stosb:
+                case codec::m_stosw:
+                case codec::m_stosd:
+                case codec::m_stosq:
+                {
+                    value = read_reg(accumulator);
+                    if (!write_memory(rdi, &value, bytes))
+                        return exec_status::memory_fault;
+
+                    rdi += step;
+                    break;
+                }
+                case codec::m_lodsb:
+                case codec::m_lodsw:
+                case codec::m_lodsd:
+                case codec::m_lodsq:
+                {
+                    if (!read_memory(rsi, &value, bytes))
+                        return exec_status::memory_fault;
+
+                    write_reg(accumulator, value);
+                    rsi += step;
+                    break;
+                }
+                default:
+                {
+                    if (!read_memory(rsi, &value, bytes) || !write_memory(rdi, &value, bytes))
+                        return exec_status::memory_fault;
+
+                    rsi += step;
+                    rdi += step;
+                    break;
+                }
+            }
+
+            if (rep)
+                rcx = remaining - 1;
+        }
+
+        return exec_status::success;
+    }
+
+    exec_status interpreter::execute_sse(const codec::dec::inst_info& decode)
+    {
+        const codec::dec::inst& inst = decode.instruction;
+        const codec::dec::operand* ops = decode.operands;
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+
+        // every form handled here has an xmm register on one side
+        xmm_value destination = { }, source = { };
+        const bool destination_xmm = is_xmm(ops[0]);
+        if (destination_xmm)
+            destination = state.xmm[xmm_index(ops[0])];
+
+        if (inst.operand_count_visible > 1 && !read_vector(inst, ops[1], source))
+            return exec_status::memory_fault;
+
+        auto write_destination = [&](const xmm_value& value)
+        {
+            return write_vector(inst, ops[0], value) ? exec_status::success : exec_status::memory_fault;
+        };
+
+        switch (mnemonic)
+        {
+            case codec::m_movdqu:
+            case codec::m_movdqa:
+            case codec::m_movups:
+            case codec::m_movaps:
+            case codec::m_movupd:
+            case codec::m_movapd:
+                return write_destination(source);
+
+            case codec::m_movq:
+            case codec::m_movd:
+            {
+                const uint64_t mask = mnemonic == codec::m_movq ? ~0ull : 0xFFFFFFFF;
+                if (destination_xmm)
+                    return write_destination({ source[0] & mask, 0 });
+
+                return write_operand(inst, ops[0], source[0] & mask) ? exec_status::success : exec_status::memory_fault;
+            }
+            case codec::m_movss:
+            case codec::m_movsd:
+            {
+                const uint64_t mask = mnemonic == codec::m_movsd ? ~0ull : 0xFFFFFFFF;
+                if (!destination_xmm)
+                    return write_operand(inst, ops[0], source[0] & mask) ? exec_status::success : exec_status::memory_fault;
+
+                // loads clear the rest of the register, register moves merge into it
+                if (ops[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+                    return write_destination({ source[0] & mask, 0 });
+
+                return write_destination({ (destination[0] & ~mask) | (source[0] & mask), destination[1] });
+            }
+
+            case codec::m_pxor:
+            case codec::m_xorps:
+            case codec::m_xorpd:
+                return write_destination({ destination[0] ^ source[0], destination[1] ^ source[1] });
+            case codec::m_pand:
+            case codec::m_andps:
+            case codec::m_andpd:
+                return write_destination({ destination[0] & source[0], destination[1] & source[1] });
+            case codec::m_pandn:
+            case codec::m_andnps:
+            case codec::m_andnpd:
+                return write_destination({ ~destination[0] & source[0], ~destination[1] & source[1] });
+            case codec::m_por:
+            case codec::m_orps:
+            case codec::m_orpd:
+                return write_destination({ destination[0] | source[0], destination[1] | source[1] });
+
+            case codec::m_pinsrq:
+            {
+                destination[ops[2].imm.value.u & 1] = source[0];
+                return write_destination(destination);
+            }
+            case codec::m_pextrq:
+            {
+                const xmm_value& value = state.xmm[xmm_index(ops[1])];
+                return write_operand(inst, ops[0], value[ops[2].imm.value.u & 1]) ? exec_status::success : exec_status::memory_fault;
+            }
+            case codec::m_punpcklqdq:
+                return write_destination({ destination[0], source[0] });
+            case codec::m_punpcklbw:
+            {
+                xmm_value result = { };
+                for (int i = 0; i < 8; i++)
+                {
+                    const uint64_t low = (destination[0] >> (i * 8)) & 0xFF;
+                    const uint64_t high = (source[0] >> (i * 8)) & 0xFF;
+
+                    const int position = i * 2;
+                    result[position / 8] |= low << (position % 8 * 8);
+                    result[(position + 1) / 8] |= high << ((position + 1) % 8 * 8);
+                }
+
+                return write_destination(result);
+            }
+            case codec::m_pshufd:
+            {
+                const uint64_t order = ops[2].imm.value.u;
+                auto dword = [&](const uint64_t index) { return (source[index / 2] >> (index % 2 * 32)) & 0xFFFFFFFF; };
+
+                return write_destination({
+                    dword(order & 3) | dword((order >> 2) & 3) << 32,
+                    dword((order >> 4) & 3) | dword((order >> 6) & 3) << 32
+                });
+            }
+            case codec::m_pshuflw:
+            {
+                const uint64_t order = ops[2].imm.value.u;
+
+                uint64_t low = 0;
+                for (int i = 0; i < 4; i++)
+                    low |= ((source[0] >> (((order >> (i * 2)) & 3) * 16)) & 0xFFFF) << (i * 16);
+
+                return write_destination({ low, source[1] });
+            }
+
+            case codec::m_addsd:
+            case codec::m_subsd:
+            case codec::m_mulsd:
+            case codec::m_divsd:
+            case codec::m_minsd:
+            case codec::m_maxsd:
+            case codec::m_sqrtsd:
+            {
+                const double a = as_double(destination[0]);
+                const double b = as_double(source[0]);
+
+                double result;
+                switch (mnemonic)
+                {
+                    case codec::m_addsd: result = a + b; break;
+                    case codec::m_subsd: result = a - b; break;
+                    case codec::m_mulsd: result = a * b; break;
+                    case codec::m_divsd: result = a / b; break;
+                    case codec::m_minsd: result = a < b ? a : b; break;
+                    case codec::m_maxsd: result = a > b ? a : b; break;
+                    default: result = std::sqrt(b); break;
+                }
+
+                return write_destination({ from_double(result), destination[1] });
+            }
+            case codec::m_addss:
+            case codec::m_subss:
+            case codec::m_mulss:
+            case codec::m_divss:
+            case codec::m_minss:
+            case codec::m_maxss:
+            case codec::m_sqrtss:
+            {
+                const float a = as_float(destination[0]);
+                const float b = as_float(source[0]);
+
+                float result;
+                switch (mnemonic)
+                {
+                    case codec::m_addss: result = a + b; break;
+                    case codec::m_subss: result = a - b; break;
+                    case codec::m_mulss: result = a * b; break;
+                    case codec::m_divss: result = a / b; break;
+                    case codec::m_minss: result = a < b ? a : b; break;
+                    case codec::m_maxss: result = a > b ? a : b; break;
+                    default: result = std::sqrt(b); break;
+                }
+
+                return write_destination({ (destination[0] & ~0xFFFFFFFFull) | from_float(result), destination[1] });
+            }
+
+            case codec::m_comisd:
+            case codec::m_ucomisd:
+            case codec::m_comiss:
+            case codec::m_ucomiss:
+            {
+                const bool is_double = mnemonic == codec::m_comisd || mnemonic == codec::m_ucomisd;
+                const double a = is_double ? as_double(destination[0]) : as_float(destination[0]);
+                const double b = is_double ? as_double(source[0]) : as_float(source[0]);
+
+                const bool unordered = std::isnan(a) || std::isnan(b);
+                set_flag(flag_zf, unordered || a == b);
+                set_flag(flag_pf, unordered);
+                set_flag(flag_cf, unordered || a < b);
+                set_flag(flag_of, false);
+                set_flag(flag_sf, false);
+                set_flag(flag_af, false);
+
+                return exec_status::success;
+            }
+
+            case codec::m_cvtsi2sd:
+            case codec::m_cvtsi2ss:
+            {
+                const int64_t value = sign_extend(source[0], ops[1].size);
+                if (mnemonic == codec::m_cvtsi2sd)
+                    return write_destination({ from_double(static_cast<double>(value)), destination[1] });
+
+                return write_destination({ (destination[0] & ~0xFFFFFFFFull) | from_float(static_cast<float>(value)), destination[1] });
+            }
+            case codec::m_cvttsd2si:
+            case codec::m_cvtsd2si:
+            case codec::m_cvttss2si:
+            case codec::m_cvtss2si:
+            {
+                const bool is_double = mnemonic == codec::m_cvttsd2si || mnemonic == codec::m_cvtsd2si;
+                const bool truncate = mnemonic == codec::m_cvttsd2si || mnemonic == codec::m_cvttss2si;
+
+                const double value = is_double ? as_double(source[0]) : as_float(source[0]);
+                write_reg(static_cast<codec::reg>(ops[0].reg.value), convert_to_integer(value, ops[0].size, truncate));
+
+                return exec_status::success;
+            }
+            case codec::m_cvtsd2ss:
+                return write_destination({ (destination[0] & ~0xFFFFFFFFull) | from_float(static_cast<float>(as_double(source[0]))), destination[1] });
+            case codec::m_cvtss2sd:
+                return write_destination({ from_double(as_float(source[0])), destination[1] });
+
+            default:
+                return exec_status::unsupported_instruction;
+        }
+    }
+
+    uint64_t interpreter::read_reg(const codec::reg reg) const
+    {
+        const ZydisRegister target = static_cast<ZydisRegister>(reg);
+        switch (ZydisRegisterGetClass(target))
+        {
+            case ZYDIS_REGCLASS_GPR8:
+            case ZYDIS_REGCLASS_GPR16:
+            case ZYDIS_REGCLASS_GPR32:
+            case ZYDIS_REGCLASS_GPR64:
+            {
+                const ZydisRegister enclosing = ZydisRegisterGetLargestEnclosing(ZYDIS_MACHINE_MODE_LONG_64, target);
+                const uint64_t value = state.gpr[enclosing - ZYDIS_REGISTER_RAX];
+                if (codec::is_upper_8(reg))
+                    return (value >> 8) & 0xFF;
+
+                return value & size_mask(ZydisRegisterGetWidth(ZYDIS_MACHINE_MODE_LONG_64, target));
+            }
+            case ZYDIS_REGCLASS_XMM:
+                return state.xmm[target - ZYDIS_REGISTER_XMM0][0];
+            case ZYDIS_REGCLASS_FLAGS:
+                return state.rflags;
+            case ZYDIS_REGCLASS_IP:
+                return state.rip;
+            default:
+                return 0;
+        }
+    }
+
+    void interpreter::write_reg(const codec::reg reg, const uint64_t value)
+    {
+        const ZydisRegister target = static_cast<ZydisRegister>(reg);
+        switch (ZydisRegisterGetClass(target))
+        {
+            case ZYDIS_REGCLASS_GPR8:
+            case ZYDIS_REGCLASS_GPR16:
+            case ZYDIS_REGCLASS_GPR32:
+            case ZYDIS_REGCLASS_GPR64:
+            {
+                const ZydisRegister enclosing = ZydisRegisterGetLargestEnclosing(ZYDIS_MACHINE_MODE_LONG_64, target);
+                uint64_t& current = state.gpr[enclosing - ZYDIS_REGISTER_RAX];
+
+                if (codec::is_upper_8(reg))
+                {
+                    current = (current & ~0xFF00ull) | (value & 0xFF) << 8;
+                    break;
+                }
+
+                // 32 bit writes clear the upper half, smaller ones merge
+                const uint16_t width = ZydisRegisterGetWidth(ZYDIS_MACHINE_MODE_LONG_64, target);
+                if (width >= 32)
+                    current = value & size_mask(width);
+                else
+                    current = (current & ~size_mask(width)) | (value & size_mask(width));
+
+                break;
+            }
+            case ZYDIS_REGCLASS_XMM:
+                state.xmm[target - ZYDIS_REGISTER_XMM0] = { value, 0 };
+                break;
+            case ZYDIS_REGCLASS_FLAGS:
+                state.rflags = value | 0x2;
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint64_t interpreter::get_address(const codec::dec::inst& inst, const codec::dec::operand& operand) const
+    {
+        const codec::dec::op_mem& mem_op = operand.mem;
+
+        uint64_t address = 0;
+        if (mem_op.base == ZYDIS_REGISTER_RIP)
+            address = state.rip;
+        else if (mem_op.base != ZYDIS_REGISTER_NONE)
+            address = read_reg(static_cast<codec::reg>(mem_op.base));
+
+        if (mem_op.index != ZYDIS_REGISTER_NONE)
+            address += read_reg(static_cast<codec::reg>(mem_op.index)) * mem_op.scale;
+
+        address += static_cast<uint64_t>(mem_op.disp.value);
+        if (inst.address_width == 32)
+            address &= 0xFFFFFFFF;
+
+        if (mem_op.type != ZYDIS_MEMOP_TYPE_AGEN)
+        {
+            if (mem_op.segment == ZYDIS_REGISTER_FS)
+                address += state.fs_base;
+            else if (mem_op.segment == ZYDIS_REGISTER_GS)
+                address += state.gs_base;
+        }
+
+        return address;
+    }
+
+    bool interpreter::read_operand(const codec::dec::inst& inst, const codec::dec::operand& operand, uint64_t& value)
+    {
+        switch (operand.type)
+        {
+            case ZYDIS_OPERAND_TYPE_REGISTER:
+                value = read_reg(static_cast<codec::reg>(operand.reg.value));
+                return true;
+            case ZYDIS_OPERAND_TYPE_MEMORY:
+                value = 0;
+                return read_memory(get_address(inst, operand), &value, std::min<uint16_t>(operand.size, 64) / 8);
+            case ZYDIS_OPERAND_TYPE_IMMEDIATE:
+                value = operand.imm.is_signed ? static_cast<uint64_t>(operand.imm.value.s) : operand.imm.value.u;
+                return true;
+            default:
+                value = 0;
+                return false;
+        }
+    }
+
+    bool interpreter::write_operand(const codec::dec::inst& inst, const codec::dec::operand& operand, const uint64_t value)
+    {
+        switch (operand.type)
+        {
+            case ZYDIS_OPERAND_TYPE_REGISTER:
+                write_reg(static_cast<codec::reg>(operand.reg.value), value);
+                return true;
+            case ZYDIS_OPERAND_TYPE_MEMORY:
+                return write_memory(get_address(inst, operand), &value, std::min<uint16_t>(operand.size, 64) / 8);
+            default:
+                return false;
+        }
+    }
+
+    bool interpreter::read_vector(const codec::dec::inst& inst, const codec::dec::operand& operand, xmm_value& value)
+    {
+        value = { };
+        if (is_xmm(operand))
+        {
+            value = state.xmm[xmm_index(operand)];
+            return true;
+        }
+
+        if (operand.type == ZYDIS_OPERAND_TYPE_MEMORY)
+            return read_memory(get_address(inst, operand), value.data(), std::min<uint16_t>(operand.size, 128) / 8);
+
+        return read_operand(inst, operand, value[0]);
+    }
+
+    bool interpreter::write_vector(const codec::dec::inst& inst, const codec::dec::operand& operand, const xmm_value& value)
+    {
+        if (is_xmm(operand))
+        {
+            state.xmm[xmm_index(operand)] = value;
+            return true;
+        }
+
+        if (operand.type == ZYDIS_OPERAND_TYPE_MEMORY)
+            return write_memory(get_address(inst, operand), value.data(), std::min<uint16_t>(operand.size, 128) / 8);
+
+        return write_operand(inst, operand, value[0]);
+    }
+
+    bool interpreter::read_memory(const uint64_t address, void* buffer, const uint64_t size)
+    {
+        if (mem.read(address, buffer, size))
+            return true;
+
+        fault_address = address;
+        return false;
+    }
+
+    bool interpreter::write_memory(const uint64_t address, const void* buffer, const uint64_t size)
+    {
+        if (!mem.write(address, buffer, size))
+        {
+            fault_address = address;
+            return false;
+        }
+
+        // code that gets written over has to be decoded again
+        if (code_pages.contains(address & ~(memory::page_size - 1)) || code_pages.contains((address + size - 1) & ~(memory::page_size - 1)))
+            decode_cache.clear();
+
+        return true;
+    }
+
+    bool interpreter::push(const uint64_t value, const uint16_t bytes)
+    {
+        uint64_t& rsp = state.gpr[ZYDIS_REGISTER_RSP - ZYDIS_REGISTER_RAX];
+        if (!write_memory(rsp - bytes, &value, bytes))
+            return false;
+
+        rsp -= bytes;
+        return true;
+    }
+
+    bool interpreter::pop(uint64_t& value, const uint16_t bytes)
+    {
+        uint64_t& rsp = state.gpr[ZYDIS_REGISTER_RSP - ZYDIS_REGISTER_RAX];
+
+        value = 0;
+        if (!read_memory(rsp, &value, bytes))
+            return false;
+
+        rsp += bytes;
+        return true;
+    }
+
+    bool interpreter::test_condition(const codec::mnemonic mnemonic) const
+    {
+        const bool cf = get_flag(flag_cf);
+        const bool pf = get_flag(flag_pf);
+        const bool zf = get_flag(flag_zf);
+        const bool sf = get_flag(flag_sf);
+        const bool of = get_flag(flag_of);
+
+        switch (mnemonic)
+        {
+            case codec::m_jo: case codec::m_cmovo: case codec::m_seto: return of;
+            case codec::m_jno: case codec::m_cmovno: case codec::m_setno: return !of;
+            case codec::m_jb: case codec::m_cmovb: case codec::m_setb: return cf;
+            case codec::m_jnb: case codec::m_cmovnb: case codec::m_setnb: return !cf;
+            case codec::m_jz: case codec::m_cmovz: case codec::m_setz: return zf;
+            case codec::m_jnz: case codec::m_cmovnz: case codec::m_setnz: return !zf;
+            case codec::m_jbe: case codec::m_cmovbe: case codec::m_setbe: return cf || zf;
+            case codec::m_jnbe: case codec::m_cmovnbe: case codec::m_setnbe: return !cf && !zf;
+            case codec::m_js: case codec::m_cmovs: case codec::m_sets: return sf;
+            case codec::m_jns: case codec::m_cmovns: case codec::m_setns: return !sf;
+            case codec::m_jp: case codec::m_cmovp: case codec::m_setp: return pf;
+            case codec::m_jnp: case codec::m_cmovnp: case codec::m_setnp: return !pf;
+            case codec::m_jl: case codec::m_cmovl: case codec::m_setl: return sf != of;
+            case codec::m_jnl: case codec::m_cmovnl: case codec::m_setnl: return sf == of;
+            case codec::m_jle: case codec::m_cmovle: case codec::m_setle: return zf || sf != of;
+            case codec::m_jnle: case codec::m_cmovnle: case codec::m_setnle: return !zf && sf == of;
+            default:
+                VM_ASSERT("invalid condition mnemonic");
+                return false;
+        }
+    }
+
+    void interpreter::set_flag(const rflags_bit flag, const bool set)
+    {
+        if (set)
+            state.rflags |= flag;
+        else
+            state.rflags &= ~static_cast<uint64_t>(flag);
+    }
+
+    bool interpreter::get_flag(const rflags_bit flag) const
+    {
+        return state.rflags & flag;
+    }
+
+    void interpreter::set_result_flags(const uint64_t result, const uint16_t bits)
+    {
+        set_flag(flag_zf, (result & size_mask(bits)) == 0);
+        set_flag(flag_sf, sign_of(result, bits));
+        set_flag(flag_pf, std::popcount(static_cast<uint8_t>(result)) % 2 == 0);
+    }
+}
@@ -0,0 +1,133 @@
+#include "eaglevm-core/interpreter/memory.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace eagle::interp
+{
+    void memory::map(const uint64_t address, const uint64_t size)
+    {
+        if (size == 0)
+            return;
+
+        const uint64_t first = address & ~(page_size - 1);
+        const uint64_t last = (address + size - 1) & ~(page_size - 1);
+        for (uint64_t current = first; ; current += page_size)
+        {
+            get_page(current, true);
+            if (current == last)
+                break;
+        }
+    }
+
+    void memory::load(const uint64_t address, const void* data, const uint64_t size)
+    {
+        map(address, size);
+        write(address, data, size);
+    }
+
+    void memory::set_lazy(const bool lazy)
+    {
+        this->lazy = lazy;
+    }
+
+    bool memory::is_mapped(const uint64_t address, const uint64_t size) const
+    {
+        for (uint64_t offset = 0; offset < size; )
+        {
+            const uint64_t current = address + offset;
+            if (!get_page(current))
+                return false;
+
+            offset += page_size - (current & (page_size - 1));
+        }
+
+        return true;
+    }
+
+    bool memory::read(const uint64_t address, void* buffer, const uint64_t size)
+    {
+        uint8_t* output = static_cast<uint8_t*>(buffer);
+        for (uint64_t offset = 0; offset < size; )
+        {
+            const uint64_t current = address + offset;
+            const page* target = get_page(current, lazy);
+            if (!target)
+                return false;
+
+            const uint64_t page_offset = current & (page_size - 1);
+            const uint64_t chunk = std::min(size - offset, page_size - page_offset);
+            memcpy(output + offset, target->data() + page_offset, chunk);
+
+            offset += chunk;
+        }
+
+        return true;
+    }
+
+    bool memory::write(const uint64_t address, const void* buffer, const uint64_t size)
+    {
+        const uint8_t* input = static_cast<const uint8_t*>(buffer);
+        for (uint64_t offset = 0; offset < size; )
+        {
+            const uint64_t current = address + offset;
+            page* target = get_page(current, lazy);
+            if (!target)
+                return false;
+
+            const uint64_t page_offset = current & (page_size - 1);
+            const uint64_t chunk = std::min(size - offset, page_size - page_offset);
+            memcpy(target->data() + page_offset, input + offset, chunk);
+
+            offset += chunk;
+        }
+
+        return true;
+    }
+
+    uint64_t memory::fetch(const uint64_t address, void* buffer, const uint64_t size) const
+    {
+        uint8_t* output = static_cast<uint8_t*>(buffer);
+        uint64_t offset = 0;
+        while (offset < size)
+        {
+            const uint64_t current = address + offset;
+            const page* target = get_page(current);
+            if (!target)
+                break;
+
+            const uint64_t page_offset = current & (page_size - 1);
+            const uint64_t chunk = std::min(size - offset, page_size - page_offset);
+            memcpy(output + offset, target->data() + page_offset, chunk);
+
+            offset += chunk;
+        }
+
+        return offset;
+    }
+
+    memory::page* memory::get_page(const uint64_t address, const bool create)
+    {
+        const uint64_t key = address & ~(page_size - 1);
+        if (const auto it = pages.find(key); it != pages.end())
+            return it->second.get();
+
+        if (!create)
+            return nullptr;
+
+        auto& created = pages[key];
+        created = std::make_unique<page>();
+        created->fill(0);
+
+        return created.get();
+    }
+
+    const memory::page* memory::get_page(const uint64_t address) const
+    {
+        const uint64_t key = address & ~(page_size - 1);
+        if (const auto it = pages.find(key); it != pages.end())
+            return it->second.get();
+
+        return nullptr;
+    }
+}
@@ -1,6 +1,8 @@
 #include "eaglevm-core/obfuscation/mba/variable/mba_exp.h"
 #include "eaglevm-core/obfuscation/mba/variable/mba_xy.h"
 
+#include "eaglevm-core/util/assert.h"
+
 namespace eagle::mba
 {
     mba_var_exp::mba_var_exp()
@@ -113,7 +115,7 @@ namespace eagle::mba
                             }
                             else
                             {
-                                __debugbreak();
+                                VM_BREAK();
                             }
                         }
                     }
@@ -0,0 +1,111 @@
+#include "eaglevm-core/pe/mapped_image.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace eagle::pe
+{
+    mapped_image::~mapped_image()
+    {
+        close();
+    }
+
+    bool mapped_image::open(const std::string& path)
+    {
+        close();
+
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER file_size = { };
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            close();
+            return false;
+        }
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        view_size = static_cast<size_t>(file_size.QuadPart);
+#else
+        file = ::open(path.c_str(), O_RDONLY);
+        if (file == -1)
+            return false;
+
+        struct stat file_stat = { };
+        if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0)
+        {
+            close();
+            return false;
+        }
+
+        view_size = static_cast<size_t>(file_stat.st_size);
+        view = mmap(nullptr, view_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (view == MAP_FAILED)
+            view = nullptr;
+#endif
+
+        if (view == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void mapped_image::close()
+    {
+#ifdef _WIN32
+        if (view)
+            UnmapViewOfFile(view);
+
+        if (mapping)
+            CloseHandle(mapping);
+
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (view)
+            munmap(view, view_size);
+
+        if (file != -1)
+            ::close(file);
+
+        file = -1;
+#endif
+
+        view = nullptr;
+        view_size = 0;
+    }
+
+    const uint8_t* mapped_image::data() const
+    {
+        return static_cast<const uint8_t*>(view);
+    }
+
+    size_t mapped_image::size() const
+    {
+        return view_size;
+    }
+
+    win::image_x64_t* mapped_image::get_image() const
+    {
+        return static_cast<win::image_x64_t*>(view);
+    }
+}
@@ -0,0 +1,103 @@
+#include "eaglevm-core/pe/mapped_output.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace eagle::pe
+{
+    mapped_output::~mapped_output()
+    {
+        close();
+    }
+
+    bool mapped_output::create(const std::string& path, const size_t size)
+    {
+        close();
+
+        if (size == 0)
+            return false;
+
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        // the mapping grows the file to its full size
+        const uint64_t mapping_size = size;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(mapping_size >> 32), static_cast<DWORD>(mapping_size), nullptr);
+        if (mapping == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+        view_size = size;
+#else
+        file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file == -1)
+            return false;
+
+        if (ftruncate(file, static_cast<off_t>(size)) != 0)
+        {
+            close();
+            return false;
+        }
+
+        view_size = size;
+        view = mmap(nullptr, view_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        if (view == MAP_FAILED)
+            view = nullptr;
+#endif
+
+        if (view == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void mapped_output::close()
+    {
+#ifdef _WIN32
+        if (view)
+            UnmapViewOfFile(view);
+
+        if (mapping)
+            CloseHandle(mapping);
+
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (view)
+            munmap(view, view_size);
+
+        if (file != -1)
+            ::close(file);
+
+        file = -1;
+#endif
+
+        view = nullptr;
+        view_size = 0;
+    }
+
+    uint8_t* mapped_output::data() const
+    {
+        return static_cast<uint8_t*>(view);
+    }
+
+    size_t mapped_output::size() const
+    {
+        return view_size;
+    }
+}
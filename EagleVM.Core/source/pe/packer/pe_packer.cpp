@@ -91,11 +91,14 @@ namespace eagle::pe
                     if (current_byte + 4 > text.size())
                         break;
 
+                    // only sections which actually get text written into them are copied out of the input image
+                    std::vector<uint8_t>& bytes = data.materialize();
+
                     uint32_t target_value = *reinterpret_cast<uint32_t*>(&text[current_byte]);
-                    uint32_t current_value = *reinterpret_cast<uint32_t*>(&data[i]);
+                    uint32_t current_value = *reinterpret_cast<uint32_t*>(&bytes[i]);
 
                     // first we write the target
-                    *reinterpret_cast<uint32_t*>(&data[i]) = target_value;
+                    *reinterpret_cast<uint32_t*>(&bytes[i]) = target_value;
 
                     // then we find a way to get it back
                     const int32_t diff = target_value - current_value;
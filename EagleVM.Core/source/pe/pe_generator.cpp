@@ -1,10 +1,13 @@
 #include "eaglevm-core/pe/pe_generator.h"
+#include "eaglevm-core/pe/mapped_output.h"
 
 #include <cassert>
+#include <cstring>
 #include <ranges>
 
 #include "eaglevm-core/util/random.h"
 #include "eaglevm-core/util/assert.h"
+#include "eaglevm-core/util/profiler.h"
 
 namespace eagle::pe
 {
@@ -55,14 +58,9 @@ namespace eagle::pe
         // section headers
         //
 
-        // copy section headers
+        // copy section headers, the data stays in the image until something writes to it
         for (win::section_header_t section : parser->get_nt_headers()->sections())
-        {
-            std::vector<uint8_t> data(section.size_raw_data, 0);
-            memcpy(data.data(), parser->raw_to_ptr(section.ptr_raw_data), section.size_raw_data);
-
-            sections.emplace_back(section, data);
-        }
+            sections.emplace_back(section, section_data(parser->raw_to_ptr<uint8_t>(section.ptr_raw_data), section.size_raw_data));
 
         // shitty fix but this should stop references from getting reallocated
         sections.reserve(sections.size() + 3);
@@ -122,7 +120,7 @@ namespace eagle::pe
                     const uint32_t offset = va - section_start_va;
 
                     // replace the bytes at the offset with 0x90
-                    std::fill_n(data.begin() + offset, bytes, 0x90);
+                    std::fill_n(data.materialize().begin() + offset, bytes, 0x90);
                 }
             }
 
@@ -134,7 +132,7 @@ namespace eagle::pe
                     const uint32_t offset = va - section_start_va;
 
                     // replace the bytes at the offset with 0x90
-                    std::generate_n(data.begin() + offset, bytes, [&]
+                    std::generate_n(data.materialize().begin() + offset, bytes, [&]
                     {
                         return util::ran_device::get().gen_8();
                     });
@@ -150,7 +148,7 @@ namespace eagle::pe
                     const uint32_t offset = va - section_start_va;
 
                     // replace the bytes at the offset with the bytes from the vector
-                    std::ranges::copy(bytes_to_insert, data.begin() + offset);
+                    std::ranges::copy(bytes_to_insert, data.materialize().begin() + offset);
                 }
             }
         }
@@ -200,8 +198,10 @@ namespace eagle::pe
         return name;
     }
 
-    void pe_generator::save_file(const std::string& save_path)
+    bool pe_generator::save_file(const std::string& save_path)
     {
+        VM_PROFILE_SCOPE("pe.save_file");
+
         // account for binaries potentially placing sections in a different order virtually
         // NOTE: this isn't actually allowed by the spec and these binaries wouldn't load
         std::ranges::sort(sections, [](auto& a, auto& b)
@@ -248,12 +248,7 @@ namespace eagle::pe
             }
         }
 
-        // write the headers to the file
-        std::ofstream protected_binary(save_path, std::ios::binary);
-        protected_binary.write(reinterpret_cast<char*>(&dos_header), sizeof(dos_header));
-        protected_binary.write(reinterpret_cast<char*>(dos_stub.data()), dos_stub.size());
-        protected_binary.write(reinterpret_cast<char*>(&nt_headers), sizeof(nt_headers));
-
+        // fix up the section table before anything is written, the layout has to be final first
         for (auto& [section, data] : sections)
         {
             auto name = section.name.to_string();
@@ -291,7 +286,7 @@ namespace eagle::pe
                     aligned_data_size
                 );
 
-                __debugbreak();
+                VM_BREAK();
             }
 
             if (section.virtual_size == 0)
@@ -300,42 +295,44 @@ namespace eagle::pe
                     name.data()
                 );
             }
-
-            protected_binary.write(reinterpret_cast<char*>(&section), sizeof(section));
         }
 
-        // sort the sections by file offset to emit them in file order
-        std::ranges::sort(sections, [](auto& a, auto& b)
-        {
-            auto a_section = std::get<0>(a);
-            auto b_section = std::get<0>(b);
+        // the section table stays in virtual order but the data is laid out in file order
+        std::vector<const generator_section_t*> file_order;
+        file_order.reserve(sections.size());
+        for (const auto& section : sections)
+            file_order.push_back(&section);
 
-            return a_section.ptr_raw_data < b_section.ptr_raw_data;
+        std::ranges::sort(file_order, [](const auto* a, const auto* b)
+        {
+            return a->first.ptr_raw_data < b->first.ptr_raw_data;
         });
 
         // make sure the header is padded correctly
-        VM_ASSERT(protected_binary.tellp() <= header_size);
-        if (protected_binary.tellp() >= header_size)
+        const auto headers_end = sizeof(dos_header) + dos_stub.size() + sizeof(nt_headers) + sections.size() * sizeof(IMAGE_SECTION_HEADER);
+        VM_ASSERT(headers_end <= header_size);
+        if (headers_end > header_size)
         {
             printf("[!] header size adjustment went wrong...\n");
-            __debugbreak();
+            VM_BREAK();
         }
-        protected_binary.seekp(header_size, std::ios::beg);
 
-        for (auto& [section, data] : sections)
+        uint32_t file_size = header_size;
+        for (const auto* entry : file_order)
         {
+            const auto& [section, data] = *entry;
+
             // sanity checks
-            const auto current_offset = static_cast<uint32_t>(protected_binary.tellp());
             printf("[+] section %s -> 0x%X bytes (current offset: 0x%X)\n",
                 section.name.to_string().data(),
                 section.size_raw_data,
-                current_offset
+                file_size
             );
 
-            if (current_offset != section.ptr_raw_data)
+            if (file_size != section.ptr_raw_data)
             {
-                printf("[!] expected file offset 0x%X, got 0x%X\n", section.ptr_raw_data, current_offset);
-                __debugbreak();
+                printf("[!] expected file offset 0x%X, got 0x%X\n", section.ptr_raw_data, file_size);
+                VM_BREAK();
             }
 
             if (data.empty())
@@ -343,19 +340,42 @@ namespace eagle::pe
                 continue;
             }
 
-            // write the data
-            printf("    writing 0x%zX data bytes\n", data.size());
-            protected_binary.write(reinterpret_cast<char*>(data.data()), data.size());
+            const auto section_end = section.ptr_raw_data + (std::max)(section.size_raw_data, static_cast<uint32_t>(data.size()));
+            file_size = (std::max)(file_size, section_end);
+        }
+
+        // the output is created at its final size and starts out zeroed, so header and section padding is never written
+        mapped_output protected_binary;
+        if (!protected_binary.create(save_path, file_size))
+        {
+            printf("[!] failed to create %s (0x%X bytes)\n", save_path.c_str(), file_size);
+            return false;
+        }
+
+        uint8_t* output = protected_binary.data();
+
+        uint8_t* header = output;
+        header = std::copy_n(reinterpret_cast<const uint8_t*>(&dos_header), sizeof(dos_header), header);
+        header = std::ranges::copy(dos_stub, header).out;
+        header = std::copy_n(reinterpret_cast<const uint8_t*>(&nt_headers), sizeof(nt_headers), header);
+
+        for (const auto& section : sections | std::views::keys)
+            header = std::copy_n(reinterpret_cast<const uint8_t*>(&section), sizeof(section), header);
 
-            // align the section
-            const auto padding_size = section.size_raw_data - static_cast<uint32_t>(data.size());
-            if (padding_size > 0)
+        for (const auto* entry : file_order)
+        {
+            const auto& [section, data] = *entry;
+            if (data.empty())
             {
-                printf("    writing 0x%X padding bytes\n", padding_size);
-                std::vector<char> padding(padding_size);
-                protected_binary.write(padding.data(), padding.size());
+                continue;
             }
+
+            // views into the input image are copied straight from its mapping
+            printf("    writing 0x%zX data bytes\n", data.size());
+            std::copy_n(data.data(), data.size(), output + section.ptr_raw_data);
         }
+
+        return true;
     }
 
     void pe_generator::zero_memory_rva(uint32_t rva, uint32_t size)
@@ -370,7 +390,7 @@ namespace eagle::pe
         });
 
         uint32_t offset = rva - std::get<0>(*section).virtual_address;
-        std::vector<uint8_t>& section_buffer = std::get<1>(*section);
+        std::vector<uint8_t>& section_buffer = std::get<1>(*section).materialize();
 
         std::fill_n(section_buffer.begin() + offset, size, 0);
     }
@@ -408,14 +428,16 @@ namespace eagle::pe
                 uint32_t debug_data_rva = debug_data.VirtualAddress;
                 uint32_t debug_data_offset = debug_data_rva - section_start_va;
 
-                const auto debug_dir = reinterpret_cast<PIMAGE_DEBUG_DIRECTORY>(data.data() + debug_data_offset);
+                std::vector<uint8_t>& section_buffer = data.materialize();
+
+                const auto debug_dir = reinterpret_cast<PIMAGE_DEBUG_DIRECTORY>(section_buffer.data() + debug_data_offset);
                 for (int i = 0; i < debug_data.Size / sizeof(IMAGE_DEBUG_DIRECTORY); i++)
                 {
                     IMAGE_DEBUG_DIRECTORY* debug_entry = &debug_dir[i];
                     if (debug_entry->Type != IMAGE_DEBUG_TYPE_CODEVIEW)
                         continue;
 
-                    uint8_t* pdb_data = data.data() + debug_entry->PointerToRawData - section.ptr_raw_data;
+                    uint8_t* pdb_data = section_buffer.data() + debug_entry->PointerToRawData - section.ptr_raw_data;
                     memset(pdb_data, 0, debug_entry->SizeOfData);
 
                     debug_entry->PointerToRawData = target_raw;
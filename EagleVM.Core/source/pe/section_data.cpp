@@ -0,0 +1,51 @@
+#include "eaglevm-core/pe/section_data.h"
+
+namespace eagle::pe
+{
+    section_data::section_data(const uint8_t* view, const size_t size)
+        : view(view), view_size(size), materialized(false)
+    {
+    }
+
+    const uint8_t* section_data::data() const
+    {
+        return materialized ? buffer.data() : view;
+    }
+
+    size_t section_data::size() const
+    {
+        return materialized ? buffer.size() : view_size;
+    }
+
+    bool section_data::empty() const
+    {
+        return size() == 0;
+    }
+
+    std::vector<uint8_t>& section_data::materialize()
+    {
+        if (!materialized)
+        {
+            buffer.assign(view, view + view_size);
+            materialized = true;
+
+            view = nullptr;
+            view_size = 0;
+        }
+
+        return buffer;
+    }
+
+    bool section_data::is_materialized() const
+    {
+        return materialized;
+    }
+
+    section_data& section_data::operator+=(const std::vector<uint8_t>& bytes)
+    {
+        std::vector<uint8_t>& target = materialize();
+        target.insert(target.end(), bytes.begin(), bytes.end());
+
+        return *this;
+    }
+}
@@ -0,0 +1,172 @@
+#include "eaglevm-core/util/profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace eagle::util
+{
+    namespace
+    {
+        struct span
+        {
+            const char* name;
+            uint32_t thread;
+
+            profiler::clock::time_point start;
+            profiler::clock::time_point end;
+        };
+
+        std::atomic_bool enabled = false;
+        profiler::clock::time_point epoch = profiler::clock::now();
+
+        std::mutex profile_mutex;
+        std::vector<span> spans;
+        std::map<std::string, int64_t> counters;
+
+        std::atomic_uint32_t next_thread = 0;
+        thread_local const uint32_t thread_index = next_thread++;
+
+        int64_t to_us(const profiler::clock::duration duration)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        }
+
+        double to_ms(const profiler::clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+    }
+
+    void profiler::set_enabled(const bool enable)
+    {
+        if (enable && !enabled)
+            epoch = clock::now();
+
+        enabled = enable;
+    }
+
+    bool profiler::is_enabled()
+    {
+        return enabled;
+    }
+
+    void profiler::add_counter(const char* name, const int64_t value)
+    {
+        if (!enabled)
+            return;
+
+        std::lock_guard lock(profile_mutex);
+        counters[name] += value;
+    }
+
+    void profiler::add_span(const char* name, const clock::time_point start, const clock::time_point end)
+    {
+        if (!enabled)
+            return;
+
+        std::lock_guard lock(profile_mutex);
+        spans.emplace_back(name, thread_index, start, end);
+    }
+
+    std::string profiler::chrome_trace()
+    {
+        std::lock_guard lock(profile_mutex);
+
+        std::stringstream trace;
+        trace << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+        bool first = true;
+        clock::time_point last = epoch;
+        for (const auto& [name, thread, start, end] : spans)
+        {
+            trace << (first ? "" : ",") << R"({"name":")" << name << R"(","cat":"eaglevm","ph":"X","pid":1,"tid":)" << thread
+                << R"(,"ts":)" << to_us(start - epoch) << R"(,"dur":)" << to_us(end - start) << "}";
+
+            first = false;
+            last = std::max(last, end);
+        }
+
+        // counters are totals, they show up once at the end of the trace
+        for (const auto& [name, value] : counters)
+        {
+            trace << (first ? "" : ",") << R"({"name":")" << name << R"(","cat":"eaglevm","ph":"C","pid":1,"ts":)" << to_us(last - epoch)
+                << R"(,"args":{"value":)" << value << "}}";
+
+            first = false;
+        }
+
+        trace << "]}";
+        return trace.str();
+    }
+
+    std::string profiler::summary()
+    {
+        std::lock_guard lock(profile_mutex);
+
+        struct totals
+        {
+            uint64_t calls = 0;
+            clock::duration total{ };
+            clock::duration max{ };
+        };
+
+        std::map<std::string, totals> stages;
+        for (const auto& [name, thread, start, end] : spans)
+        {
+            totals& stage = stages[name];
+            stage.calls++;
+            stage.total += end - start;
+            stage.max = std::max(stage.max, end - start);
+        }
+
+        std::vector<std::pair<std::string, totals>> sorted(stages.begin(), stages.end());
+        std::ranges::sort(sorted, [](const auto& a, const auto& b) { return a.second.total > b.second.total; });
+
+        std::stringstream table;
+        table << std::fixed << std::setprecision(3);
+        table << std::left << std::setw(40) << "stage" << std::right << std::setw(10) << "calls" << std::setw(14) << "total ms"
+            << std::setw(12) << "avg ms" << std::setw(12) << "max ms" << "\n";
+
+        for (const auto& [name, stage] : sorted)
+        {
+            table << std::left << std::setw(40) << name << std::right << std::setw(10) << stage.calls << std::setw(14) << to_ms(stage.total)
+                << std::setw(12) << to_ms(stage.total) / stage.calls << std::setw(12) << to_ms(stage.max) << "\n";
+        }
+
+        if (!counters.empty())
+        {
+            table << "\n" << std::left << std::setw(40) << "counter" << std::right << std::setw(10) << "value" << "\n";
+            for (const auto& [name, value] : counters)
+                table << std::left << std::setw(40) << name << std::right << std::setw(10) << value << "\n";
+        }
+
+        return table.str();
+    }
+
+    void profiler::reset()
+    {
+        std::lock_guard lock(profile_mutex);
+        spans.clear();
+        counters.clear();
+
+        epoch = clock::now();
+    }
+
+    scoped_timer::scoped_timer(const char* name)
+        : name(name), active(profiler::is_enabled())
+    {
+        if (active)
+            start = profiler::clock::now();
+    }
+
+    scoped_timer::~scoped_timer()
+    {
+        if (active)
+            profiler::add_span(name, start, profiler::clock::now());
+    }
+}
@@ -30,19 +30,19 @@ namespace eagle::ir
         exit = other->exit;
     }
 
-    bool block_ir::insert_after(const base_command_ptr& command_ptr)
+    bool block_ir::insert_after(const base_command_ptr& target, const base_command_ptr& command_ptr)
     {
-        const auto it = get_iterator(command_ptr);
+        const auto it = get_iterator(target);
         if (it == commands.end())
             return false;
 
-        commands.insert(it, command_ptr);
+        commands.insert(it + 1, command_ptr);
         return true;
     }
 
-    bool block_ir::insert_before(const base_command_ptr& command_ptr)
+    bool block_ir::insert_before(const base_command_ptr& target, const base_command_ptr& command_ptr)
     {
-        const auto it = get_iterator(command_ptr);
+        const auto it = get_iterator(target);
         if (it == commands.end())
             return false;
 
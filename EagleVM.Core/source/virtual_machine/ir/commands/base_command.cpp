@@ -54,6 +54,14 @@ namespace eagle::ir
                 return "vm_exec_x86";
             case command_type::vm_exec_dynamic_x86:
                 return "vm_exec_dynamic_x86";
+            case command_type::vm_native_island:
+                return "vm_native_island";
+            case command_type::vm_call:
+                return "vm_call";
+            case command_type::vm_ret:
+                return "vm_ret";
+            case command_type::vm_string:
+                return "vm_string";
             case command_type::vm_rflags_load:
                 return "vm_rflags_load";
             case command_type::vm_rflags_store:
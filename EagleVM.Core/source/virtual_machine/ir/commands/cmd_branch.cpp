@@ -31,4 +31,14 @@ namespace eagle::ir
     {
         return info.front();
     }
+
+    void cmd_branch::set_virtual(const bool inside_vm)
+    {
+        virtual_branch = inside_vm;
+    }
+
+    bool cmd_branch::is_virtual() const
+    {
+        return virtual_branch;
+    }
 }
@@ -19,4 +19,14 @@ namespace eagle::ir
     {
         return r_class;
     }
+
+    void cmd_context_load::set_cache(const discrete_store_ptr& store)
+    {
+        cache = store;
+    }
+
+    discrete_store_ptr cmd_context_load::get_cache() const
+    {
+        return cache;
+    }
 }
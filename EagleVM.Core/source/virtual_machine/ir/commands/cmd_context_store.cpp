@@ -22,4 +22,14 @@ namespace eagle::ir
     {
         return size;
     }
+
+    void cmd_context_store::set_cache(const discrete_store_ptr& store)
+    {
+        cache = store;
+    }
+
+    discrete_store_ptr cmd_context_store::get_cache() const
+    {
+        return cache;
+    }
 }
@@ -9,19 +9,43 @@ std::string eagle::ir::command_to_string(const command_type cmd)
         case command_type::vm_exit:
             return "vm_exit";
         case command_type::vm_handler_call:
-            return "call";
+            return "vm_handler_call";
         case command_type::vm_reg_load:
-            return "reg_load";
+            return "vm_reg_load";
         case command_type::vm_reg_store:
-            return "reg_store";
+            return "vm_reg_store";
         case command_type::vm_push:
             return "vm_push";
         case command_type::vm_pop:
             return "vm_pop";
         case command_type::vm_mem_read:
-            return "read";
+            return "vm_mem_read";
         case command_type::vm_mem_write:
-            return "write";
+            return "vm_mem_write";
+        case command_type::vm_context_load:
+            return "vm_context_load";
+        case command_type::vm_context_store:
+            return "vm_context_store";
+        case command_type::vm_exec_x86:
+            return "vm_exec_x86";
+        case command_type::vm_exec_dynamic_x86:
+            return "vm_exec_dynamic_x86";
+        case command_type::vm_native_island:
+            return "vm_native_island";
+        case command_type::vm_call:
+            return "vm_call";
+        case command_type::vm_ret:
+            return "vm_ret";
+        case command_type::vm_string:
+            return "vm_string";
+        case command_type::vm_rflags_load:
+            return "vm_rflags_load";
+        case command_type::vm_rflags_store:
+            return "vm_rflags_store";
+        case command_type::vm_sx:
+            return "vm_sx";
+        case command_type::vm_branch:
+            return "vm_branch";
     }
 
     return "UNKNOWN";
@@ -1,5 +1,6 @@
 #include "eaglevm-core/virtual_machine/ir/ir_translator.h"
 
+#include <algorithm>
 #include <ranges>
 #include <unordered_set>
 
@@ -10,6 +11,8 @@
 
 #include "eaglevm-core/disassembler/disassembler.h"
 #include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/util/assert.h"
+#include "eaglevm-core/util/profiler.h"
 
 namespace eagle::ir
 {
@@ -20,6 +23,8 @@ namespace eagle::ir
 
     std::vector<preopt_block_ptr> ir_translator::translate(const bool split)
     {
+        VM_PROFILE_SCOPE("ir.translate");
+
         // we want to initialzie the entire map with bb translates
         for (dasm::basic_block_ptr block : dasm->blocks)
         {
@@ -157,6 +162,7 @@ namespace eagle::ir
                     is_in_vm = false;
                 }
 
+                native_fallbacks[mnemonic]++;
                 handle_block_command(decoded_inst, current_block, bb->get_index_rva(i));
             }
         }
@@ -245,12 +251,64 @@ namespace eagle::ir
         const dasm::block_end_reason end_reason = bb->get_end_reason();
         const uint8_t skips = end_reason == dasm::block_end ? 0 : 1;
 
+        auto enter_vm = [&]
+        {
+            if (current_state != x86_block)
+                return;
+
+            // the current block is a x86 block
+            const block_ptr previous = current_block;
+            block_info->add_body(current_block);
+
+            current_block = std::make_shared<block_ir>(false);
+            current_block->add_command(std::make_shared<cmd_vm_enter>());
+
+            previous->add_command(std::make_shared<cmd_branch>(current_block, exit_condition::jmp));
+        };
+
+        bool returned = false;
         for (uint32_t i = 0; i < bb->decoded_insts.size() - skips; i++)
         {
             // use il x86 translator to translate the instruction to il
             auto decoded_inst = bb->decoded_insts[i];
             auto& [inst, ops] = decoded_inst;
 
+            if (inst.mnemonic == ZYDIS_MNEMONIC_CALL)
+            {
+                // the call gets its own command so the return lands back inside the vm
+                const uint64_t current_rva = bb->get_index_rva(i);
+                const block_ptr call_block = std::make_shared<block_ir>(false);
+                if (const cmd_call_ptr call = create_call(decoded_inst, current_rva, call_block))
+                {
+                    enter_vm();
+                    current_block->copy_from(call_block);
+                    current_block->add_command(call);
+                    block_info->add_body(current_block);
+
+                    // a native callee returns to the vm enter, a virtual callee jumps straight to the body
+                    const block_ptr return_entry = call->get_return_entry();
+                    return_entry->add_command(std::make_shared<cmd_vm_enter>());
+                    return_entry->add_command(std::make_shared<cmd_branch>(call->get_return_body(), exit_condition::jmp));
+                    block_info->add_body(return_entry);
+
+                    current_block = call->get_return_body();
+                    current_state = vm_block;
+                    continue;
+                }
+            }
+            else if (inst.mnemonic == ZYDIS_MNEMONIC_RET && inst.meta.branch_type != ZYDIS_BRANCH_TYPE_FAR)
+            {
+                // ret is always the last instruction of its block
+                const uint16_t release_bytes = inst.operand_count_visible ? static_cast<uint16_t>(ops[0].imm.value.u) : 0;
+
+                enter_vm();
+                current_block->add_command(std::make_shared<cmd_ret>(release_bytes));
+
+                current_state = vm_block;
+                returned = true;
+                break;
+            }
+
             std::vector<handler_op> il_operands;
             handler::base_handler_gen_ptr handler_gen = nullptr;
 
@@ -295,20 +353,28 @@ namespace eagle::ir
 
                     // TODO: add way to scatter blocks instead of appending them to a single block
                     // this should probably be done post gen though
-                    if (current_state == x86_block)
-                    {
-                        // the current block is a x86 block
-                        const block_ptr previous = current_block;
-                        block_info->add_body(current_block);
+                    enter_vm();
 
-                        current_block = std::make_shared<block_ir>(false);
-                        current_block->add_command(std::make_shared<cmd_vm_enter>());
+                    current_block->copy_from(result_block);
+                    current_state = vm_block;
+                }
+            }
 
-                        previous->add_command(std::make_shared<cmd_branch>(current_block, exit_condition::jmp));
-                    }
+            if (!translate_sucess && current_state != x86_block)
+            {
+                // instructions which only touch gprs and rflags can run natively without leaving the vm
+                std::vector<codec::reg> island_registers;
+                std::vector<codec::reg> island_written;
+                bool island_flags = false;
+
+                if (get_island_registers(decoded_inst, island_registers, island_written, island_flags))
+                {
+                    current_block->add_command(std::make_shared<cmd_native_island>(
+                        get_native_request(decoded_inst, bb->get_index_rva(i)), island_registers, island_written, island_flags));
+                    native_islands[mnemonic]++;
 
-                    current_block->copy_from(result_block);
                     current_state = vm_block;
+                    continue;
                 }
             }
 
@@ -341,10 +407,18 @@ namespace eagle::ir
                 // handler does not exist
                 // we need to execute the original instruction
 
+                native_fallbacks[mnemonic]++;
                 handle_block_command(decoded_inst, current_block, bb->get_index_rva(i));
             }
         }
 
+        if (returned)
+        {
+            // nothing falls through a ret so the exit stays empty
+            block_info->add_body(current_block);
+            return block_info;
+        }
+
         // jump to exiting block
         current_block->add_command(std::make_shared<cmd_branch>(exit, exit_condition::jmp));
         block_info->add_body(current_block);
@@ -449,142 +523,157 @@ namespace eagle::ir
         const std::vector<preopt_block_ptr>& extern_call_blocks
     )
     {
-        std::unordered_map<uint32_t, std::vector<preopt_block_ptr>> vm_groups;
-        for (const auto& [block, vm_id] : block_vms)
-            vm_groups[vm_id].push_back(block);
+        VM_PROFILE_SCOPE("ir.optimize");
 
-        // remove vm enter block if every reference to vm enter block uses the same vm
-        for (auto& [vm_id, blocks] : vm_groups)
+        // blocks passed in here may come from any translator, so everything is looked up by the block itself
+        std::unordered_map<block_ptr, uint32_t> block_vm;
+        std::unordered_map<block_ptr, preopt_block_ptr> head_owner;
+        for (const auto& [preopt_block, vm_id] : block_vms)
         {
-            // check entery of every block
-            for (const preopt_block_ptr& preopt_block : blocks)
+            if (preopt_block->has_head())
             {
-                const block_ptr search_enter = preopt_block->get_head();
-                const std::vector redirect_body = preopt_block->get_body();
+                block_vm[preopt_block->get_head()] = vm_id;
+                head_owner[preopt_block->get_head()] = preopt_block;
+            }
 
-                bool vm_enter_unremovable = false;
-                std::vector<cmd_branch_ptr> search_enter_refs;
+            for (const block_ptr& body : preopt_block->get_body())
+                block_vm[body] = vm_id;
 
-                // check if there are any external calls
-                // if there are, we cannot remove vm enter
-                for (auto& external : extern_call_blocks)
-                {
-                    if (preopt_block == external)
-                    {
-                        vm_enter_unremovable = true;
-                        goto UNREMOVABLE;
-                    }
-                }
+            block_vm[preopt_block->get_tail()] = vm_id;
+        }
 
-                // go through each preopt block
-                for (auto& [search_vm_id, other_blocks] : vm_groups)
-                {
-                    // go through each block
-                    for (const preopt_block_ptr& search_preopt_block : other_blocks)
-                    {
-                        // the only blocks that can reference our search block are body and exit
-                        std::vector<block_ptr> search_blocks;
-                        search_blocks.append_range(search_preopt_block->get_body());
-                        search_blocks.push_back(search_preopt_block->get_tail());
+        // remove vm exit block if every branching block uses the same vm
+        std::vector<cmd_branch_ptr> in_vm_branches;
+        for (const auto& [preopt_block, vm_id] : block_vms)
+        {
+            const block_ptr preopt_exit = preopt_block->get_tail();
+            const cmd_branch_ptr branch = preopt_exit->get_branch();
+            if (!branch)
+                continue;
 
-                        for (const block_ptr& search_block : search_blocks)
-                        {
-                            const cmd_branch_ptr branch = search_block->get_branch();
-                            auto check_block = [&](const il_exit_result& exit_result)
-                            {
-                                if (std::holds_alternative<block_ptr>(exit_result))
-                                {
-                                    const block_ptr exit_block = std::get<block_ptr>(exit_result);
-                                    if (exit_block == search_enter && search_vm_id != vm_id)
-                                        vm_enter_unremovable = true;
-                                    else
-                                        search_enter_refs.emplace_back(branch);
-                                }
-                            };
-
-                            check_block(branch->get_condition_default());
-                            check_block(branch->get_condition_special());
-
-                            if (vm_enter_unremovable)
-                                goto UNREMOVABLE;
-                        }
-                    }
-                }
+            auto is_same_vm = [&](const il_exit_result& exit_result)
+            {
+                // if one of the exits is an rva then we have to exit no matter what : (
+                if (!std::holds_alternative<block_ptr>(exit_result))
+                    return false;
 
-            UNREMOVABLE:
+                const auto it = block_vm.find(std::get<block_ptr>(exit_result));
+                return it != block_vm.end() && it->second == vm_id;
+            };
 
-                if (!vm_enter_unremovable)
-                {
-                    // we found that we can replace each branch to the block with a branch to the body
-                    for (const auto& branch_ref : search_enter_refs)
-                    {
-                        auto rewrite_branch = [&](il_exit_result& exit_result)
-                        {
-                            if (std::holds_alternative<block_ptr>(exit_result))
-                                exit_result = redirect_body.front();
-                        };
+            const bool check_one = is_same_vm(branch->get_condition_default());
+            const bool check_two = is_same_vm(branch->get_condition_special());
 
-                        rewrite_branch(branch_ref->get_condition_default());
-                        rewrite_branch(branch_ref->get_condition_special());
-                    }
+            if (check_one && check_two)
+            {
+                // this means all exits are of the same vm
+                const size_t command_count = preopt_exit->get_command_count();
+                VM_ASSERT(command_count <= 2 && command_count > 0, "preoptimized exit should not have more than 2 obfuscation");
+
+                if (command_count == 2)
+                {
+                    // this means we should have a vm exit command
+                    VM_ASSERT(preopt_exit->get_command(0)->get_command_type() == command_type::vm_exit, "invalid command, expected exit");
+                    preopt_exit->remove_command(0);
+                    branch->set_virtual(true);
 
-                    preopt_block->clear_head();
+                    in_vm_branches.push_back(branch);
                 }
             }
         }
 
-        // remove vm exit block if every branching block uses the same vm
-        for (auto& [vm_id, blocks] : vm_groups)
+        // a branch that stays inside the vm has to skip the vm enter of its target
+        for (const cmd_branch_ptr& branch : in_vm_branches)
         {
-            // check entery of every block
-            for (const preopt_block_ptr& preopt_block : blocks)
+            auto skip_enter = [&](il_exit_result& exit_result)
             {
-                const block_ptr preopt_exit = preopt_block->get_tail();
-                const cmd_branch_ptr branch = preopt_exit->get_branch();
+                if (!std::holds_alternative<block_ptr>(exit_result))
+                    return;
+
+                const auto it = head_owner.find(std::get<block_ptr>(exit_result));
+                if (it == head_owner.end())
+                    return;
 
-                // now we want to check if the current vm group has all the exits of this preopt
-                std::vector<preopt_block_ptr>& curr_vm_group = vm_groups[vm_id];
-                auto is_same_vm = [&](const il_exit_result& exit_result)
+                const std::vector<block_ptr> redirect_body = it->second->get_body();
+                if (!redirect_body.empty())
+                    exit_result = redirect_body.front();
+            };
+
+            skip_enter(branch->get_condition_default());
+            skip_enter(branch->get_condition_special());
+        }
+
+        // calls into the same vm jump straight into the callee body
+        std::vector<cmd_call_ptr> calls;
+        for (const auto& [preopt_block, vm_id] : block_vms)
+        {
+            for (const block_ptr& body : preopt_block->get_body())
+            {
+                for (size_t i = 0; i < body->get_command_count(); i++)
                 {
-                    if (std::holds_alternative<block_ptr>(exit_result))
-                    {
-                        const block_ptr exit_block = std::get<block_ptr>(exit_result);
-                        for (const auto& search_preopt : curr_vm_group)
-                        {
-                            std::vector<block_ptr> all_search_blocks;
-                            all_search_blocks.push_back(search_preopt->get_head());
-                            all_search_blocks.append_range(search_preopt->get_body());
-                            all_search_blocks.push_back(search_preopt->get_tail());
+                    const base_command_ptr& command = body->get_command(i);
+                    if (command->get_command_type() != command_type::vm_call)
+                        continue;
 
-                            if (std::ranges::find(all_search_blocks, exit_block) != all_search_blocks.end())
-                                return true;
-                        }
-                    }
+                    const cmd_call_ptr call = std::static_pointer_cast<cmd_call>(command);
+                    calls.push_back(call);
 
-                    // if one of the exits is an rva then we have to exit no matter what : (
-                    // otherwise the search would fall through to this fail
-                    return false;
-                };
+                    il_exit_result& target = call->get_target();
+                    if (!std::holds_alternative<block_ptr>(target))
+                        continue;
 
-                const bool check_one = is_same_vm(branch->get_condition_default());
-                const bool check_two = is_same_vm(branch->get_condition_special());
+                    const auto vm_it = block_vm.find(std::get<block_ptr>(target));
+                    const auto owner_it = head_owner.find(std::get<block_ptr>(target));
+                    if (vm_it == block_vm.end() || vm_it->second != vm_id || owner_it == head_owner.end())
+                        continue;
 
-                if (check_one && check_two)
-                {
-                    // this means all exits are of the same vm
-                    const size_t command_count = preopt_exit->get_command_count();
-                    VM_ASSERT(command_count <= 2 && command_count > 0, "preoptimized exit should not have more than 2 obfuscation");
+                    const std::vector<block_ptr> callee_body = owner_it->second->get_body();
+                    if (callee_body.empty())
+                        continue;
 
-                    if (command_count == 2)
-                    {
-                        // this means we should have a vm exit command
-                        const base_command_ptr& cmd = preopt_exit->remove_command(0);
-                        VM_ASSERT(cmd->get_command_type() == command_type::vm_exit, "invalid command, expected exit");
-                    }
+                    target = callee_body.front();
+                    call->set_virtual(true);
                 }
             }
         }
 
+        // remove vm enter block if nothing jumps to it anymore
+        std::unordered_set<block_ptr> referenced;
+        for (const cmd_call_ptr& call : calls)
+            if (std::holds_alternative<block_ptr>(call->get_target()))
+                referenced.insert(std::get<block_ptr>(call->get_target()));
+
+        for (const auto& [preopt_block, _] : block_vms)
+        {
+            // the only blocks that can reference a vm enter are body and exit
+            std::vector<block_ptr> search_blocks = preopt_block->get_body();
+            search_blocks.push_back(preopt_block->get_tail());
+
+            for (const block_ptr& search_block : search_blocks)
+            {
+                const cmd_branch_ptr branch = search_block->get_branch();
+                if (!branch)
+                    continue;
+
+                for (const il_exit_result& exit_result : { branch->get_condition_default(), branch->get_condition_special() })
+                    if (std::holds_alternative<block_ptr>(exit_result))
+                        referenced.insert(std::get<block_ptr>(exit_result));
+            }
+        }
+
+        for (const auto& [preopt_block, _] : block_vms)
+        {
+            if (!preopt_block->has_head() || preopt_block->get_body().empty())
+                continue;
+
+            // external calls enter from native code and always need the vm enter
+            if (std::ranges::find(extern_call_blocks, preopt_block) != extern_call_blocks.end())
+                continue;
+
+            if (!referenced.contains(preopt_block->get_head()))
+                preopt_block->clear_head();
+        }
+
         // merge blocks together
         return flatten(block_vms, block_tracker);
     }
@@ -603,6 +692,16 @@ namespace eagle::ir
         return bb_map[basic_block];
     }
 
+    std::map<codec::mnemonic, uint32_t> ir_translator::get_native_fallbacks() const
+    {
+        return native_fallbacks;
+    }
+
+    std::map<codec::mnemonic, uint32_t> ir_translator::get_native_islands() const
+    {
+        return native_islands;
+    }
+
     exit_condition ir_translator::get_exit_condition(const codec::mnemonic mnemonic)
     {
         switch (mnemonic)
@@ -660,50 +759,161 @@ namespace eagle::ir
     }
 
     void ir_translator::handle_block_command(codec::dec::inst_info decoded_inst, const block_ptr& current_block, const uint64_t current_rva)
+    {
+        current_block->add_command(std::make_shared<cmd_x86_exec>(get_native_request(decoded_inst, current_rva)));
+    }
+
+    cmd_call_ptr ir_translator::create_call(const codec::dec::inst_info& decoded_inst, const uint64_t current_rva,
+        const block_ptr& call_block)
+    {
+        auto& [inst, ops] = decoded_inst;
+        if (inst.meta.branch_type == ZYDIS_BRANCH_TYPE_FAR)
+            return nullptr;
+
+        const block_ptr return_entry = std::make_shared<block_ir>(false);
+        const block_ptr return_body = std::make_shared<block_ir>(false);
+        const codec::dynamic_instruction request = get_native_request(decoded_inst, current_rva);
+
+        switch (ops[0].type)
+        {
+            case ZYDIS_OPERAND_TYPE_IMMEDIATE:
+            {
+                auto [target_rva, _] = codec::calc_relative_rva(decoded_inst, current_rva);
+
+                // calls to the start of a block in this segment can be linked to the virtualized callee
+                il_exit_result target = target_rva;
+                if (dasm->get_jump_location(target_rva) == dasm::jump_inside_segment)
+                {
+                    const dasm::basic_block_ptr target_block = dasm->get_block(target_rva);
+                    if (target_block && target_block->start_rva == target_rva)
+                        target = bb_map[target_block]->get_head();
+                }
+
+                return std::make_shared<cmd_call>(target, return_entry, return_body, request);
+            }
+            case ZYDIS_OPERAND_TYPE_REGISTER:
+            case ZYDIS_OPERAND_TYPE_MEMORY:
+            {
+                if (inst.operand_width != 64)
+                    return nullptr;
+
+                // the lifter pushes the absolute target which the call pops again
+                lifter::call lifter(decoded_inst, current_rva);
+                if (!lifter.translate_to_il(current_rva))
+                    return nullptr;
+
+                call_block->copy_from(lifter.get_block());
+                return std::make_shared<cmd_call>(return_entry, return_body, request);
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    codec::dynamic_instruction ir_translator::get_native_request(codec::dec::inst_info decoded_inst, const uint64_t current_rva)
     {
         if (codec::has_relative_operand(decoded_inst))
         {
             auto [target_address, op_i] = codec::calc_relative_rva(decoded_inst, current_rva);
-            current_block->add_command(
-                std::make_shared<cmd_x86_exec>
-                (
-                    [decoded_inst, target_address, op_i](const uint32_t rva)
-                    {
-                        // Decode instruction to an encode request
-                        codec::enc::req encode_request = codec::decode_to_encode(decoded_inst);
-                        codec::enc::op& op = encode_request.operands[op_i];
+            return codec::recompile_promise(
+                [decoded_inst, target_address, op_i](const uint32_t rva)
+                {
+                    // Decode instruction to an encode request
+                    codec::enc::req encode_request = codec::decode_to_encode(decoded_inst);
+                    codec::enc::op& op = encode_request.operands[op_i];
 
-                        // Adjust the operand based on its type
-                        switch (op.type)
+                    // Adjust the operand based on its type
+                    switch (op.type)
+                    {
+                        case ZYDIS_OPERAND_TYPE_MEMORY:
                         {
-                            case ZYDIS_OPERAND_TYPE_MEMORY:
-                            {
-                                // Adjust memory displacement
-                                op.mem.displacement = target_address - rva;
-                                break;
-                            }
-                            case ZYDIS_OPERAND_TYPE_IMMEDIATE:
-                            {
-                                // Adjust immediate value
-                                op.imm.s = target_address - rva;
-                                break;
-                            }
-                            default:
-                            {
-                                // Break on unexpected operand type
-                                __debugbreak();
-                            }
+                            // Adjust memory displacement
+                            op.mem.displacement = target_address - rva;
+                            break;
+                        }
+                        case ZYDIS_OPERAND_TYPE_IMMEDIATE:
+                        {
+                            // Adjust immediate value
+                            op.imm.s = target_address - rva;
+                            break;
+                        }
+                        default:
+                        {
+                            // Break on unexpected operand type
+                            VM_BREAK();
                         }
-
-                        return encode_request;
                     }
-                )
+
+                    return encode_request;
+                }
             );
         }
-        else
+
+        return codec::decode_to_encode(decoded_inst);
+    }
+
+    bool ir_translator::get_island_registers(const codec::dec::inst_info& decoded_inst, std::vector<codec::reg>& registers,
+        std::vector<codec::reg>& written, bool& flags)
+    {
+        auto& [inst, ops] = decoded_inst;
+        auto add_register = [&](const codec::reg reg, const bool write)
         {
-            current_block->add_command(std::make_shared<cmd_x86_exec>(decoded_inst));
+            const codec::reg_class reg_class = codec::get_reg_class(reg);
+            if (reg_class != codec::gpr_64 && reg_class != codec::gpr_32 && reg_class != codec::gpr_16 && reg_class != codec::gpr_8)
+                return false;
+
+            // rsp is used to address the context while the instruction runs
+            const codec::reg full_reg = codec::get_bit_version(reg, codec::gpr_64);
+            if (full_reg == codec::rsp)
+                return false;
+
+            if (std::ranges::find(registers, full_reg) == registers.end())
+                registers.push_back(full_reg);
+
+            if (write && std::ranges::find(written, full_reg) == written.end())
+                written.push_back(full_reg);
+
+            return true;
+        };
+
+        for (int i = 0; i < inst.operand_count; i++)
+        {
+            const codec::dec::operand& op = ops[i];
+            if (op.type == ZYDIS_OPERAND_TYPE_REGISTER)
+            {
+                if (op.reg.value == ZYDIS_REGISTER_RFLAGS ||
+                    op.reg.value == ZYDIS_REGISTER_EFLAGS ||
+                    op.reg.value == ZYDIS_REGISTER_FLAGS)
+                {
+                    flags = true;
+                    continue;
+                }
+
+                if (!add_register(static_cast<codec::reg>(op.reg.value), op.actions & ZYDIS_OPERAND_ACTION_MASK_WRITE))
+                    return false;
+            }
+            else if (op.type == ZYDIS_OPERAND_TYPE_MEMORY)
+            {
+                // rip relative operands are fixed up by the native request
+                if (op.mem.base != ZYDIS_REGISTER_NONE && op.mem.base != ZYDIS_REGISTER_RIP)
+                    if (!add_register(static_cast<codec::reg>(op.mem.base), false))
+                        return false;
+
+                if (op.mem.index != ZYDIS_REGISTER_NONE)
+                    if (!add_register(static_cast<codec::reg>(op.mem.index), false))
+                        return false;
+            }
+            else if (op.type == ZYDIS_OPERAND_TYPE_POINTER)
+            {
+                return false;
+            }
         }
+
+        if (inst.cpu_flags && (inst.cpu_flags->tested | inst.cpu_flags->modified | inst.cpu_flags->set_0 |
+            inst.cpu_flags->set_1 | inst.cpu_flags->undefined))
+            flags = true;
+
+        return true;
     }
 
     void preopt_block::init(dasm::basic_block_ptr block)
@@ -0,0 +1,211 @@
+#include "eaglevm-core/virtual_machine/ir/passes/constant_fold.h"
+#include "eaglevm-core/virtual_machine/ir/commands/include.h"
+
+namespace eagle::ir
+{
+    static bool get_immediate(const base_command_ptr& command, uint64_t& value, ir_size& size)
+    {
+        if (command->get_command_type() != command_type::vm_push)
+            return false;
+
+        // addresses get relocated, only plain immediates are known
+        const cmd_push_ptr push = std::static_pointer_cast<cmd_push>(command);
+        if (push->get_push_type() != info_type::immediate)
+            return false;
+
+        value = push->get_value_immediate();
+        size = push->get_size();
+        return true;
+    }
+
+    static cmd_handler_call_ptr get_handler_call(const base_command_ptr& command)
+    {
+        if (command->get_command_type() != command_type::vm_handler_call)
+            return nullptr;
+
+        // operand signature calls are the lifted instruction itself and produce flags we have to keep
+        const cmd_handler_call_ptr call = std::static_pointer_cast<cmd_handler_call>(command);
+        if (call->is_operand_sig())
+            return nullptr;
+
+        switch (call->get_mnemonic())
+        {
+            case codec::m_add:
+            case codec::m_sub:
+            case codec::m_imul:
+                return call;
+            default:
+                return nullptr;
+        }
+    }
+
+    static uint64_t truncate(const uint64_t value, const ir_size size)
+    {
+        const uint16_t bits = static_cast<uint16_t>(size);
+        if (bits >= 64)
+            return value;
+
+        return value & ((1ull << bits) - 1);
+    }
+
+    static uint64_t sign_extend(const uint64_t value, const ir_size from, const ir_size to)
+    {
+        const uint16_t bits = static_cast<uint16_t>(from);
+        if (bits >= 64)
+            return value;
+
+        const uint64_t sign = 1ull << (bits - 1);
+        const uint64_t extended = (truncate(value, from) ^ sign) - sign;
+
+        return truncate(extended, to);
+    }
+
+    static bool fits_imm32(const uint64_t value)
+    {
+        const int64_t signed_value = static_cast<int64_t>(value);
+        return signed_value >= INT32_MIN && signed_value <= INT32_MAX;
+    }
+
+    void constant_fold::run(const block_ptr& block)
+    {
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (size_t i = 0; i < block->get_command_count(); i++)
+            {
+                // identity goes before the handler fold so an add of 0 does not become an instruction
+                if (fold_sign_extend(block, i) || fold_immediates(block, i) || fold_identity(block, i) || fold_handler_call(block, i))
+                    changed = true;
+            }
+        }
+    }
+
+    bool constant_fold::fold_sign_extend(const block_ptr& block, const size_t i)
+    {
+        if (i + 1 >= block->get_command_count())
+            return false;
+
+        uint64_t value;
+        ir_size size;
+        if (!get_immediate(block->get_command(i), value, size))
+            return false;
+
+        const base_command_ptr& next = block->get_command(i + 1);
+        if (next->get_command_type() != command_type::vm_sx)
+            return false;
+
+        const cmd_sx_ptr sx = std::static_pointer_cast<cmd_sx>(next);
+        if (sx->get_current() != size)
+            return false;
+
+        block->get_command(i) = std::make_shared<cmd_push>(sign_extend(value, size, sx->get_target()), sx->get_target());
+        block->remove_command(i + 1);
+
+        return true;
+    }
+
+    bool constant_fold::fold_immediates(const block_ptr& block, const size_t i)
+    {
+        if (i + 2 >= block->get_command_count())
+            return false;
+
+        uint64_t first, second;
+        ir_size first_size, second_size;
+        if (!get_immediate(block->get_command(i), first, first_size) || !get_immediate(block->get_command(i + 1), second, second_size))
+            return false;
+
+        const cmd_handler_call_ptr call = get_handler_call(block->get_command(i + 2));
+        if (!call)
+            return false;
+
+        const handler_sig signature = call->get_handler_signature();
+        if (signature.size() != 2 || signature[0] != first_size || signature[1] != second_size || first_size != second_size)
+            return false;
+
+        // the handler computes deeper op top
+        uint64_t result;
+        switch (call->get_mnemonic())
+        {
+            case codec::m_add:
+                result = first + second;
+                break;
+            case codec::m_sub:
+                result = first - second;
+                break;
+            case codec::m_imul:
+                result = first * second;
+                break;
+            default:
+                return false;
+        }
+
+        block->get_command(i) = std::make_shared<cmd_push>(truncate(result, first_size), first_size);
+        block->remove_command(i + 2);
+        block->remove_command(i + 1);
+
+        return true;
+    }
+
+    bool constant_fold::fold_identity(const block_ptr& block, const size_t i)
+    {
+        if (i + 1 >= block->get_command_count())
+            return false;
+
+        uint64_t value;
+        ir_size size;
+        if (!get_immediate(block->get_command(i), value, size))
+            return false;
+
+        const cmd_handler_call_ptr call = get_handler_call(block->get_command(i + 1));
+        if (!call)
+            return false;
+
+        const handler_sig signature = call->get_handler_signature();
+        if (signature.size() != 2 || signature[1] != size)
+            return false;
+
+        const bool identity = call->get_mnemonic() == codec::m_imul ? value == 1 : value == 0;
+        if (!identity)
+            return false;
+
+        block->remove_command(i + 1);
+        block->remove_command(i);
+
+        return true;
+    }
+
+    bool constant_fold::fold_handler_call(const block_ptr& block, const size_t i)
+    {
+        if (i + 1 >= block->get_command_count())
+            return false;
+
+        uint64_t value;
+        ir_size size;
+        if (!get_immediate(block->get_command(i), value, size))
+            return false;
+
+        const cmd_handler_call_ptr call = get_handler_call(block->get_command(i + 1));
+        if (!call)
+            return false;
+
+        // the instruction is encoded with a sign extended imm32
+        const handler_sig signature = call->get_handler_signature();
+        if (size != ir_size::bit_64 || signature != handler_sig{ ir_size::bit_64, ir_size::bit_64 } || !fits_imm32(value))
+            return false;
+
+        const discrete_store_ptr value_store = discrete_store::create(ir_size::bit_64);
+
+        base_command_ptr instruction;
+        if (call->get_mnemonic() == codec::m_imul)
+            instruction = std::make_shared<cmd_x86_dynamic>(codec::m_imul, value_store, value_store, value);
+        else
+            instruction = std::make_shared<cmd_x86_dynamic>(call->get_mnemonic(), value_store, value);
+
+        block->get_command(i) = std::make_shared<cmd_pop>(value_store, ir_size::bit_64);
+        block->get_command(i + 1) = instruction;
+        block->insert_after(instruction, std::make_shared<cmd_push>(value_store, ir_size::bit_64)->release(value_store));
+
+        return true;
+    }
+}
@@ -0,0 +1,216 @@
+#include "eaglevm-core/virtual_machine/ir/passes/context_dataflow.h"
+#include "eaglevm-core/virtual_machine/ir/commands/include.h"
+
+namespace eagle::ir
+{
+    static bool is_tracked(const codec::reg reg)
+    {
+        // rsp is also read through vsp, so we cannot see every use of it
+        switch (codec::get_reg_class(reg))
+        {
+            case codec::gpr_64:
+            case codec::gpr_32:
+            case codec::gpr_16:
+            case codec::gpr_8:
+                return codec::get_bit_version(reg, codec::gpr_64) != codec::rsp;
+            default:
+                return false;
+        }
+    }
+
+    static std::pair<uint16_t, uint16_t> get_bit_range(const codec::reg reg)
+    {
+        if (codec::is_upper_8(reg))
+            return { 8, 16 };
+
+        return { 0, static_cast<uint16_t>(codec::get_reg_size(reg)) };
+    }
+
+    static bool same_register(const codec::reg first, const codec::reg second)
+    {
+        // xmm registers share ids with gprs, the class has to be checked before the id
+        if ((codec::get_reg_class(first) == codec::xmm_128) != (codec::get_reg_class(second) == codec::xmm_128))
+            return false;
+
+        return codec::get_bit_version(first, codec::gpr_64) == codec::get_bit_version(second, codec::gpr_64);
+    }
+
+    static bool overlaps(const codec::reg first, const codec::reg second)
+    {
+        if (!same_register(first, second))
+            return false;
+
+        const auto [first_start, first_end] = get_bit_range(first);
+        const auto [second_start, second_end] = get_bit_range(second);
+
+        return first_start < second_end && second_start < first_end;
+    }
+
+    static bool covers(const codec::reg outer, const codec::reg inner)
+    {
+        if (!same_register(outer, inner))
+            return false;
+
+        const auto [outer_start, outer_end] = get_bit_range(outer);
+        const auto [inner_start, inner_end] = get_bit_range(inner);
+
+        return outer_start <= inner_start && inner_end <= outer_end;
+    }
+
+    static bool is_barrier(const base_command_ptr& command)
+    {
+        // anything that leaves the vm reads the entire context and may clobber cached temps
+        // dynamic instructions only ever get temps from the main pool so they are left out
+        switch (command->get_command_type())
+        {
+            case command_type::vm_enter:
+            case command_type::vm_exit:
+            case command_type::vm_exec_x86:
+            case command_type::vm_native_island:
+            case command_type::vm_call:
+            case command_type::vm_ret:
+            case command_type::vm_string:
+            case command_type::vm_branch:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    context_dataflow::context_dataflow(const uint8_t max_cached)
+        : max_cached(max_cached)
+    {
+    }
+
+    void context_dataflow::run(const block_ptr& block) const
+    {
+        remove_dead_stores(block);
+        if (max_cached)
+            cache_context_values(block);
+    }
+
+    void context_dataflow::remove_dead_stores(const block_ptr& block)
+    {
+        for (size_t i = 0; i < block->get_command_count(); i++)
+        {
+            const base_command_ptr command = block->get_command(i);
+            if (command->get_command_type() != command_type::vm_context_store)
+                continue;
+
+            const cmd_context_store_ptr store = std::static_pointer_cast<cmd_context_store>(command);
+            const codec::reg target = store->get_reg();
+            if (!is_tracked(target))
+                continue;
+
+            bool dead = false;
+            for (size_t j = i + 1; j < block->get_command_count(); j++)
+            {
+                const base_command_ptr& next = block->get_command(j);
+                if (is_barrier(next))
+                    break;
+
+                if (next->get_command_type() == command_type::vm_context_load)
+                {
+                    const cmd_context_load_ptr load = std::static_pointer_cast<cmd_context_load>(next);
+                    if (overlaps(load->get_reg(), target))
+                        break;
+                }
+                else if (next->get_command_type() == command_type::vm_context_store)
+                {
+                    const cmd_context_store_ptr overwrite = std::static_pointer_cast<cmd_context_store>(next);
+                    if (covers(overwrite->get_reg(), target))
+                    {
+                        dead = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!dead)
+                continue;
+
+            // the value still has to come off the stack, it just never gets written
+            const ir_size value_size = static_cast<ir_size>(store->get_value_size());
+            const discrete_store_ptr discard = discrete_store::create(value_size);
+
+            block->get_command(i) = std::make_shared<cmd_pop>(discard, value_size)->release(discard);
+        }
+    }
+
+    void context_dataflow::cache_context_values(const block_ptr& block) const
+    {
+        // index of the last use of every cache that has been handed out
+        std::vector<size_t> cache_ends;
+
+        for (size_t i = 0; i < block->get_command_count(); i++)
+        {
+            const base_command_ptr command = block->get_command(i);
+
+            codec::reg target = codec::reg::none;
+            if (command->get_command_type() == command_type::vm_context_load)
+            {
+                target = std::static_pointer_cast<cmd_context_load>(command)->get_reg();
+            }
+            else if (command->get_command_type() == command_type::vm_context_store)
+            {
+                const cmd_context_store_ptr store = std::static_pointer_cast<cmd_context_store>(command);
+                const codec::reg_size reg_size = codec::get_reg_size(store->get_reg());
+                const codec::reg_size value_size = store->get_value_size();
+
+                // the popped value has to describe the whole register, 32 bit values are zero extended
+                if (value_size == reg_size || (reg_size == codec::bit_64 && value_size == codec::bit_32))
+                    target = store->get_reg();
+            }
+
+            if (target == codec::reg::none || !is_tracked(target))
+                continue;
+
+            std::vector<size_t> reuses;
+            for (size_t j = i + 1; j < block->get_command_count(); j++)
+            {
+                const base_command_ptr& next = block->get_command(j);
+                if (is_barrier(next))
+                    break;
+
+                if (next->get_command_type() == command_type::vm_context_load)
+                {
+                    const cmd_context_load_ptr load = std::static_pointer_cast<cmd_context_load>(next);
+                    if (load->get_reg() == target)
+                        reuses.push_back(j);
+                }
+                else if (next->get_command_type() == command_type::vm_context_store)
+                {
+                    const cmd_context_store_ptr store = std::static_pointer_cast<cmd_context_store>(next);
+                    if (overlaps(store->get_reg(), target))
+                        break;
+                }
+            }
+
+            if (reuses.empty())
+                continue;
+
+            std::erase_if(cache_ends, [i](const size_t end) { return end < i; });
+            if (cache_ends.size() >= max_cached)
+                continue;
+
+            cache_ends.push_back(reuses.back());
+
+            const ir_size cache_size = static_cast<ir_size>(codec::get_reg_size(target));
+            const discrete_store_ptr cache = discrete_store::create(cache_size);
+
+            if (command->get_command_type() == command_type::vm_context_load)
+                std::static_pointer_cast<cmd_context_load>(command)->set_cache(cache);
+            else
+                std::static_pointer_cast<cmd_context_store>(command)->set_cache(cache);
+
+            for (const size_t reuse : reuses)
+            {
+                const base_command_ptr push = std::make_shared<cmd_push>(cache, cache_size);
+                if (reuse == reuses.back())
+                    push->release(cache);
+
+                block->get_command(reuse) = push;
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#include "eaglevm-core/virtual_machine/ir/profile_guide.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <ranges>
+#include <sstream>
+
+#include "eaglevm-core/disassembler/basic_block.h"
+
+namespace eagle::ir
+{
+    bool block_profile::load(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+            return false;
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream line_stream(line);
+
+            std::string rva_string, count_string;
+            if (!(line_stream >> rva_string) || rva_string.starts_with('#'))
+                continue;
+
+            if (!(line_stream >> count_string))
+                return false;
+
+            // base 0 accepts both hex with a prefix and decimal
+            char* rva_end = nullptr;
+            char* count_end = nullptr;
+
+            const uint64_t rva = std::strtoull(rva_string.c_str(), &rva_end, 0);
+            const uint64_t count = std::strtoull(count_string.c_str(), &count_end, 0);
+            if (*rva_end != '\0' || *count_end != '\0')
+                return false;
+
+            add(rva, count);
+        }
+
+        return true;
+    }
+
+    void block_profile::add(const uint64_t rva, const uint64_t count)
+    {
+        counts[rva] += count;
+    }
+
+    uint64_t block_profile::get_count(const uint64_t rva) const
+    {
+        const auto it = counts.find(rva);
+        return it == counts.end() ? 0 : it->second;
+    }
+
+    bool block_profile::empty() const
+    {
+        return counts.empty();
+    }
+
+    double profile_plan::get_heavy_slowdown() const
+    {
+        return native_cost ? heavy_cost / native_cost : 0.0;
+    }
+
+    double profile_plan::get_planned_slowdown() const
+    {
+        return native_cost ? planned_cost / native_cost : 0.0;
+    }
+
+    profile_guide::profile_guide(block_profile profile, const double slowdown_budget, const profile_costs costs)
+        : profile(std::move(profile)), slowdown_budget(slowdown_budget), costs(costs)
+    {
+    }
+
+    void profile_guide::set_block_costs(block_profile cycles)
+    {
+        block_costs = std::move(cycles);
+    }
+
+    profile_plan profile_guide::plan(const std::vector<region_ptr>& regions) const
+    {
+        struct candidate
+        {
+            preopt_block_ptr block;
+            double heavy_cost;
+            double light_cost;
+        };
+
+        profile_plan result;
+        std::vector<candidate> candidates;
+
+        for (const region_ptr& region : regions)
+        {
+            for (const preopt_block_ptr& block : region->blocks | std::views::keys)
+            {
+                const dasm::basic_block_ptr original = block->get_original_block();
+
+                const uint64_t count = profile.get_count(original->start_rva);
+                if (count == 0)
+                    continue;
+
+                const double executions = static_cast<double>(count);
+                const double commands = static_cast<double>(get_command_count(block));
+
+                // hot blocks of a region share a vm, so the transition is only paid when the block stays heavy
+                double heavy_cost = executions * (commands * costs.heavy_command + costs.transition);
+                double light_cost = executions * commands * costs.light_command;
+
+                if (const uint64_t cycles = block_costs.get_count(original->start_rva))
+                {
+                    heavy_cost = executions * static_cast<double>(cycles);
+                    light_cost = heavy_cost * costs.light_command / costs.heavy_command;
+                }
+
+                result.native_cost += executions * static_cast<double>(original->decoded_insts.size());
+                result.heavy_cost += heavy_cost;
+
+                candidates.emplace_back(block, heavy_cost, light_cost);
+            }
+        }
+
+        // the most expensive blocks save the most when they are made light
+        std::ranges::sort(candidates, std::greater{ }, [](const candidate& entry)
+        {
+            return entry.heavy_cost - entry.light_cost;
+        });
+
+        result.planned_cost = result.heavy_cost;
+        for (const candidate& entry : candidates)
+        {
+            if (result.planned_cost <= slowdown_budget * result.native_cost)
+                break;
+
+            result.planned_cost -= entry.heavy_cost - entry.light_cost;
+            result.hot_blocks.insert(entry.block);
+        }
+
+        return result;
+    }
+
+    size_t profile_guide::get_command_count(const preopt_block_ptr& block)
+    {
+        size_t count = block->get_tail()->get_command_count();
+        if (block->has_head())
+            count += block->get_head()->get_command_count();
+
+        for (const block_ptr& body : block->get_body())
+            count += body->get_command_count();
+
+        return count;
+    }
+}
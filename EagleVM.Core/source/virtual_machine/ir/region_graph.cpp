@@ -0,0 +1,227 @@
+#include "eaglevm-core/virtual_machine/ir/region_graph.h"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_set>
+
+#include "eaglevm-core/disassembler/disassembler.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_branch.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_call.h"
+#include "eaglevm-core/util/assert.h"
+
+namespace eagle::ir
+{
+    region_ptr region_graph::add_region(const dasm::segment_dasm_ptr& dasm, const std::shared_ptr<ir_translator>& translator,
+        const preopt_block_vec& blocks, const preopt_block_ptr& entry)
+    {
+        const region_ptr new_region = std::make_shared<region>();
+        new_region->dasm = dasm;
+        new_region->translator = translator;
+        new_region->entry = entry;
+
+        for (const preopt_block_ptr& block : blocks)
+        {
+            const uint32_t vm_id = static_cast<uint32_t>(vm_parent.size());
+            vm_parent.push_back(vm_id);
+
+            new_region->blocks.emplace_back(block, vm_id);
+        }
+
+        regions.push_back(new_region);
+        return new_region;
+    }
+
+    uint32_t region_graph::link()
+    {
+        uint32_t linked = 0;
+        for (const region_ptr& source : regions)
+        {
+            for (const auto& [preopt_block, vm_id] : source->blocks)
+            {
+                for (const block_ptr& body : preopt_block->get_body())
+                {
+                    for (size_t i = 0; i < body->get_command_count(); i++)
+                    {
+                        const base_command_ptr command = body->get_command(i);
+                        if (command->get_command_type() != command_type::vm_call)
+                            continue;
+
+                        if (link_call(source, vm_id, std::static_pointer_cast<cmd_call>(command)))
+                            linked++;
+                    }
+                }
+
+                const block_ptr tail = preopt_block->get_tail();
+                if (!tail || !tail->get_branch())
+                    continue;
+
+                auto link_exit = [&](il_exit_result& exit_result)
+                {
+                    if (!std::holds_alternative<vmexit_rva>(exit_result))
+                        return;
+
+                    const auto [target, target_vm] = find_block(std::get<vmexit_rva>(exit_result), source);
+                    if (!target || !target->has_head())
+                        return;
+
+                    // the head still holds the vm enter, optimize will skip it once the exit is gone
+                    exit_result = target->get_head();
+                    merge_vms(vm_id, target_vm);
+
+                    linked++;
+                };
+
+                const cmd_branch_ptr branch = tail->get_branch();
+                link_exit(branch->get_condition_default());
+                link_exit(branch->get_condition_special());
+            }
+        }
+
+        return linked;
+    }
+
+    bool region_graph::link_call(const region_ptr& source, const uint32_t vm_id, const cmd_call_ptr& call)
+    {
+        if (call->is_dynamic())
+            return false;
+
+        il_exit_result& call_target = call->get_target();
+        if (std::holds_alternative<block_ptr>(call_target))
+        {
+            // the translator already resolved calls inside the same region
+            const block_ptr head = std::get<block_ptr>(call_target);
+            for (const auto& [target, target_vm] : source->blocks)
+            {
+                if (target->get_head() != head)
+                    continue;
+
+                merge_vms(vm_id, target_vm);
+                merge_returns(source, vm_id);
+                return true;
+            }
+
+            return false;
+        }
+
+        const auto [target, target_vm] = find_block(std::get<vmexit_rva>(call_target), source);
+        if (!target || !target->has_head())
+            return false;
+
+        call_target = target->get_head();
+        merge_vms(vm_id, target_vm);
+
+        for (const region_ptr& target_region : regions)
+            if (std::ranges::find(target_region->blocks, preopt_vm_id{ target, target_vm }) != target_region->blocks.end())
+                merge_returns(target_region, vm_id);
+
+        return true;
+    }
+
+    void region_graph::merge_returns(const region_ptr& target, const uint32_t vm_id)
+    {
+        // the return dispatch only knows the return sites of its own machine
+        for (const auto& [block, block_vm] : target->blocks)
+        {
+            for (const block_ptr& body : block->get_body())
+            {
+                const size_t command_count = body->get_command_count();
+                if (command_count && body->get_command(command_count - 1)->get_command_type() == command_type::vm_ret)
+                {
+                    merge_vms(vm_id, block_vm);
+                    break;
+                }
+            }
+        }
+    }
+
+    uint32_t region_graph::share_vm(const std::vector<preopt_block_ptr>& blocks)
+    {
+        VM_ASSERT(!blocks.empty(), "cannot share a vm between zero blocks");
+
+        const std::unordered_set<preopt_block_ptr> sharing(blocks.begin(), blocks.end());
+
+        std::optional<uint32_t> shared;
+        for (const region_ptr& current : regions)
+        {
+            for (const auto& [block, vm_id] : current->blocks)
+            {
+                if (!sharing.contains(block))
+                    continue;
+
+                if (shared)
+                    merge_vms(shared.value(), vm_id);
+                else
+                    shared = vm_id;
+            }
+        }
+
+        VM_ASSERT(shared.has_value(), "blocks do not belong to any region");
+        return find_vm(shared.value());
+    }
+
+    std::vector<preopt_vm_id> region_graph::get_block_vms()
+    {
+        std::vector<preopt_vm_id> block_vms;
+        for (const region_ptr& current : regions)
+            for (const auto& [block, vm_id] : current->blocks)
+                block_vms.emplace_back(block, find_vm(vm_id));
+
+        return block_vms;
+    }
+
+    std::vector<preopt_block_ptr> region_graph::get_entry_blocks() const
+    {
+        std::vector<preopt_block_ptr> entries;
+        for (const region_ptr& current : regions)
+            entries.push_back(current->entry);
+
+        return entries;
+    }
+
+    uint32_t region_graph::find_vm(const uint32_t vm_id)
+    {
+        uint32_t root = vm_id;
+        while (vm_parent[root] != root)
+            root = vm_parent[root];
+
+        // compress so later lookups are a single step
+        uint32_t current = vm_id;
+        while (vm_parent[current] != root)
+        {
+            const uint32_t next = vm_parent[current];
+            vm_parent[current] = root;
+            current = next;
+        }
+
+        return root;
+    }
+
+    void region_graph::merge_vms(const uint32_t first, const uint32_t second)
+    {
+        const uint32_t first_root = find_vm(first);
+        const uint32_t second_root = find_vm(second);
+        if (first_root != second_root)
+            vm_parent[std::max(first_root, second_root)] = std::min(first_root, second_root);
+    }
+
+    std::pair<preopt_block_ptr, uint32_t> region_graph::find_block(const uint64_t rva, const region_ptr& source) const
+    {
+        for (const region_ptr& target : regions)
+        {
+            if (target == source || target->dasm->get_jump_location(rva) != dasm::jump_inside_segment)
+                continue;
+
+            // jumps into the middle of a block would need the block split, those keep exiting
+            const dasm::basic_block_ptr basic_block = target->dasm->get_block(rva);
+            if (!basic_block || basic_block->start_rva != rva)
+                return { nullptr, 0 };
+
+            const preopt_block_ptr preopt = target->translator->map_preopt_block(basic_block);
+            for (const auto& [block, vm_id] : target->blocks)
+                if (block == preopt)
+                    return { block, vm_id };
+        }
+
+        return { nullptr, 0 };
+    }
+}
@@ -74,6 +74,9 @@ namespace eagle::ir::lifter
     translate_status base_x86_translator::encode_operand(codec::dec::op_reg op_reg, uint8_t idx)
     {
         block->add_command(std::make_shared<cmd_context_load>(static_cast<codec::reg>(op_reg.value)));
+
+        // rsp relative memory operands after this have to skip over the pushed register
+        stack_displacement += static_cast<uint16_t>(TOB(codec::get_reg_size(static_cast<codec::reg>(op_reg.value))));
         return translate_status::success;
     }
 
@@ -173,7 +176,7 @@ namespace eagle::ir::lifter
                 block->add_command({
                     std::make_shared<cmd_pop>(store, ir_size::bit_64),
                     std::make_shared<cmd_push>(store, ir_size::bit_64),
-                    std::make_shared<cmd_push>(store, ir_size::bit_64),
+                    std::make_shared<cmd_push>(store, ir_size::bit_64)->release(store),
                     std::make_shared<cmd_mem_read>(size)
                 });
 
@@ -7,17 +7,123 @@ namespace eagle::ir
 {
     std::unordered_map<codec::mnemonic, std::shared_ptr<handler::base_handler_gen>> instruction_handlers =
     {
+        { codec::m_adc, std::make_shared<handler::adc>() },
         { codec::m_add, std::make_shared<handler::add>() },
+        { codec::m_addsd, std::make_shared<handler::sse_arith>(codec::m_addsd) },
+        { codec::m_addss, std::make_shared<handler::sse_arith>(codec::m_addss) },
+        { codec::m_and, std::make_shared<handler::and_>() },
+        { codec::m_andnpd, std::make_shared<handler::sse_arith>(codec::m_andnpd) },
+        { codec::m_andnps, std::make_shared<handler::sse_arith>(codec::m_andnps) },
+        { codec::m_andpd, std::make_shared<handler::sse_arith>(codec::m_andpd) },
+        { codec::m_andps, std::make_shared<handler::sse_arith>(codec::m_andps) },
+        { codec::m_cmovb, std::make_shared<handler::cmovcc>(codec::m_cmovb) },
+        { codec::m_cmovbe, std::make_shared<handler::cmovcc>(codec::m_cmovbe) },
+        { codec::m_cmovl, std::make_shared<handler::cmovcc>(codec::m_cmovl) },
+        { codec::m_cmovle, std::make_shared<handler::cmovcc>(codec::m_cmovle) },
+        { codec::m_cmovnb, std::make_shared<handler::cmovcc>(codec::m_cmovnb) },
+        { codec::m_cmovnbe, std::make_shared<handler::cmovcc>(codec::m_cmovnbe) },
+        { codec::m_cmovnl, std::make_shared<handler::cmovcc>(codec::m_cmovnl) },
+        { codec::m_cmovnle, std::make_shared<handler::cmovcc>(codec::m_cmovnle) },
+        { codec::m_cmovno, std::make_shared<handler::cmovcc>(codec::m_cmovno) },
+        { codec::m_cmovnp, std::make_shared<handler::cmovcc>(codec::m_cmovnp) },
+        { codec::m_cmovns, std::make_shared<handler::cmovcc>(codec::m_cmovns) },
+        { codec::m_cmovnz, std::make_shared<handler::cmovcc>(codec::m_cmovnz) },
+        { codec::m_cmovo, std::make_shared<handler::cmovcc>(codec::m_cmovo) },
+        { codec::m_cmovp, std::make_shared<handler::cmovcc>(codec::m_cmovp) },
+        { codec::m_cmovs, std::make_shared<handler::cmovcc>(codec::m_cmovs) },
+        { codec::m_cmovz, std::make_shared<handler::cmovcc>(codec::m_cmovz) },
         { codec::m_cmp, std::make_shared<handler::cmp>() },
+        { codec::m_comisd, std::make_shared<handler::sse_compare>(codec::m_comisd) },
+        { codec::m_comiss, std::make_shared<handler::sse_compare>(codec::m_comiss) },
+        { codec::m_cvtsd2si, std::make_shared<handler::sse_convert>(codec::m_cvtsd2si) },
+        { codec::m_cvtsd2ss, std::make_shared<handler::sse_convert>(codec::m_cvtsd2ss) },
+        { codec::m_cvtsi2sd, std::make_shared<handler::sse_convert>(codec::m_cvtsi2sd) },
+        { codec::m_cvtsi2ss, std::make_shared<handler::sse_convert>(codec::m_cvtsi2ss) },
+        { codec::m_cvtss2sd, std::make_shared<handler::sse_convert>(codec::m_cvtss2sd) },
+        { codec::m_cvtss2si, std::make_shared<handler::sse_convert>(codec::m_cvtss2si) },
+        { codec::m_cvttsd2si, std::make_shared<handler::sse_convert>(codec::m_cvttsd2si) },
+        { codec::m_cvttss2si, std::make_shared<handler::sse_convert>(codec::m_cvttss2si) },
         { codec::m_dec, std::make_shared<handler::dec>() },
+        { codec::m_div, std::make_shared<handler::wide_arith>(codec::m_div) },
+        { codec::m_divsd, std::make_shared<handler::sse_arith>(codec::m_divsd) },
+        { codec::m_divss, std::make_shared<handler::sse_arith>(codec::m_divss) },
+        { codec::m_idiv, std::make_shared<handler::wide_arith>(codec::m_idiv) },
         { codec::m_imul, std::make_shared<handler::imul>() },
         { codec::m_inc, std::make_shared<handler::inc>() },
         { codec::m_lea, std::make_shared<handler::lea>() },
+        { codec::m_maxsd, std::make_shared<handler::sse_arith>(codec::m_maxsd) },
+        { codec::m_maxss, std::make_shared<handler::sse_arith>(codec::m_maxss) },
+        { codec::m_minsd, std::make_shared<handler::sse_arith>(codec::m_minsd) },
+        { codec::m_minss, std::make_shared<handler::sse_arith>(codec::m_minss) },
         { codec::m_mov, std::make_shared<handler::mov>() },
+        { codec::m_movapd, std::make_shared<handler::sse_mov>(codec::m_movapd) },
+        { codec::m_movaps, std::make_shared<handler::sse_mov>(codec::m_movaps) },
+        { codec::m_movd, std::make_shared<handler::sse_mov>(codec::m_movd) },
+        { codec::m_movdqa, std::make_shared<handler::sse_mov>(codec::m_movdqa) },
+        { codec::m_movdqu, std::make_shared<handler::sse_mov>(codec::m_movdqu) },
+        { codec::m_movq, std::make_shared<handler::sse_mov>(codec::m_movq) },
+        { codec::m_movsb, std::make_shared<handler::movs>() },
+        { codec::m_movsd, std::make_shared<handler::sse_mov>(codec::m_movsd) },
+        { codec::m_movsq, std::make_shared<handler::movs>() },
+        { codec::m_movss, std::make_shared<handler::sse_mov>(codec::m_movss) },
+        { codec::m_movsw, std::make_shared<handler::movs>() },
         { codec::m_movsx, std::make_shared<handler::movsx>() },
+        { codec::m_movsxd, std::make_shared<handler::movsx>() },
+        { codec::m_movupd, std::make_shared<handler::sse_mov>(codec::m_movupd) },
+        { codec::m_movups, std::make_shared<handler::sse_mov>(codec::m_movups) },
+        { codec::m_movzx, std::make_shared<handler::movzx>() },
+        { codec::m_mul, std::make_shared<handler::wide_arith>(codec::m_mul) },
+        { codec::m_mulsd, std::make_shared<handler::sse_arith>(codec::m_mulsd) },
+        { codec::m_mulss, std::make_shared<handler::sse_arith>(codec::m_mulss) },
+        { codec::m_neg, std::make_shared<handler::neg>() },
+        { codec::m_not, std::make_shared<handler::not_>() },
+        { codec::m_or, std::make_shared<handler::or_>() },
+        { codec::m_orpd, std::make_shared<handler::sse_arith>(codec::m_orpd) },
+        { codec::m_orps, std::make_shared<handler::sse_arith>(codec::m_orps) },
+        { codec::m_pand, std::make_shared<handler::sse_arith>(codec::m_pand) },
+        { codec::m_pandn, std::make_shared<handler::sse_arith>(codec::m_pandn) },
         { codec::m_pop, std::make_shared<handler::pop>() },
+        { codec::m_por, std::make_shared<handler::sse_arith>(codec::m_por) },
         { codec::m_push, std::make_shared<handler::push>() },
+        { codec::m_pxor, std::make_shared<handler::sse_arith>(codec::m_pxor) },
+        { codec::m_rol, std::make_shared<handler::rol>() },
+        { codec::m_ror, std::make_shared<handler::ror>() },
+        { codec::m_sar, std::make_shared<handler::sar>() },
+        { codec::m_sbb, std::make_shared<handler::sbb>() },
+        { codec::m_setb, std::make_shared<handler::setcc>(codec::m_setb) },
+        { codec::m_setbe, std::make_shared<handler::setcc>(codec::m_setbe) },
+        { codec::m_setl, std::make_shared<handler::setcc>(codec::m_setl) },
+        { codec::m_setle, std::make_shared<handler::setcc>(codec::m_setle) },
+        { codec::m_setnb, std::make_shared<handler::setcc>(codec::m_setnb) },
+        { codec::m_setnbe, std::make_shared<handler::setcc>(codec::m_setnbe) },
+        { codec::m_setnl, std::make_shared<handler::setcc>(codec::m_setnl) },
+        { codec::m_setnle, std::make_shared<handler::setcc>(codec::m_setnle) },
+        { codec::m_setno, std::make_shared<handler::setcc>(codec::m_setno) },
+        { codec::m_setnp, std::make_shared<handler::setcc>(codec::m_setnp) },
+        { codec::m_setns, std::make_shared<handler::setcc>(codec::m_setns) },
+        { codec::m_setnz, std::make_shared<handler::setcc>(codec::m_setnz) },
+        { codec::m_seto, std::make_shared<handler::setcc>(codec::m_seto) },
+        { codec::m_setp, std::make_shared<handler::setcc>(codec::m_setp) },
+        { codec::m_sets, std::make_shared<handler::setcc>(codec::m_sets) },
+        { codec::m_setz, std::make_shared<handler::setcc>(codec::m_setz) },
+        { codec::m_shl, std::make_shared<handler::shl>() },
+        { codec::m_shr, std::make_shared<handler::shr>() },
+        { codec::m_sqrtsd, std::make_shared<handler::sse_arith>(codec::m_sqrtsd) },
+        { codec::m_sqrtss, std::make_shared<handler::sse_arith>(codec::m_sqrtss) },
+        { codec::m_stosb, std::make_shared<handler::stos>() },
+        { codec::m_stosd, std::make_shared<handler::stos>() },
+        { codec::m_stosq, std::make_shared<handler::stos>() },
+        { codec::m_stosw, std::make_shared<handler::stos>() },
         { codec::m_sub, std::make_shared<handler::sub>() },
+        { codec::m_subsd, std::make_shared<handler::sse_arith>(codec::m_subsd) },
+        { codec::m_subss, std::make_shared<handler::sse_arith>(codec::m_subss) },
+        { codec::m_test, std::make_shared<handler::test>() },
+        { codec::m_ucomisd, std::make_shared<handler::sse_compare>(codec::m_ucomisd) },
+        { codec::m_ucomiss, std::make_shared<handler::sse_compare>(codec::m_ucomiss) },
+        { codec::m_xchg, std::make_shared<handler::xchg>() },
+        { codec::m_xor, std::make_shared<handler::xor_>() },
+        { codec::m_xorpd, std::make_shared<handler::sse_arith>(codec::m_xorpd) },
+        { codec::m_xorps, std::make_shared<handler::sse_arith>(codec::m_xorps) },
     };
 
     std::unordered_map<
@@ -26,16 +132,136 @@ namespace eagle::ir
     >
     instruction_lifters =
     {
+        { codec::m_adc, CREATE_LIFTER_GEN(adc) },
         { codec::m_add, CREATE_LIFTER_GEN(add) },
+        { codec::m_addsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_addss, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_and, CREATE_LIFTER_GEN(and_) },
+        { codec::m_andnpd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_andnps, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_andpd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_andps, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_cmovb, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovbe, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovl, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovle, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovnb, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovnbe, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovnl, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovnle, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovno, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovnp, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovns, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovnz, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovo, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovp, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovs, CREATE_LIFTER_GEN(cmovcc) },
+        { codec::m_cmovz, CREATE_LIFTER_GEN(cmovcc) },
         { codec::m_cmp, CREATE_LIFTER_GEN(cmp) },
+        { codec::m_comisd, CREATE_LIFTER_GEN(sse_compare) },
+        { codec::m_comiss, CREATE_LIFTER_GEN(sse_compare) },
+        { codec::m_cvtsd2si, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvtsd2ss, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvtsi2sd, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvtsi2ss, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvtss2sd, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvtss2si, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvttsd2si, CREATE_LIFTER_GEN(sse_convert) },
+        { codec::m_cvttss2si, CREATE_LIFTER_GEN(sse_convert) },
         { codec::m_dec, CREATE_LIFTER_GEN(dec) },
-        { codec::m_imul, CREATE_LIFTER_GEN(imul) },
+        { codec::m_div, CREATE_LIFTER_GEN(wide_arith) },
+        { codec::m_divsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_divss, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_idiv, CREATE_LIFTER_GEN(wide_arith) },
+        { codec::m_imul, [](codec::dec::inst_info decode, const uint64_t rva)
+        {
+            // the one operand form is the widening multiply
+            if (decode.instruction.operand_count_visible == 1)
+                return std::static_pointer_cast<lifter::base_x86_translator>(std::make_shared<lifter::wide_arith>(decode, rva));
+
+            return std::static_pointer_cast<lifter::base_x86_translator>(std::make_shared<lifter::imul>(decode, rva));
+        } },
         { codec::m_inc, CREATE_LIFTER_GEN(inc) },
         { codec::m_lea, CREATE_LIFTER_GEN(lea) },
+        { codec::m_maxsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_maxss, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_minsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_minss, CREATE_LIFTER_GEN(sse_arith) },
         { codec::m_mov, CREATE_LIFTER_GEN(mov) },
+        { codec::m_movapd, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movaps, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movd, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movdqa, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movdqu, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movq, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movsb, CREATE_LIFTER_GEN(movs) },
+        { codec::m_movsd, [](codec::dec::inst_info decode, const uint64_t rva)
+        {
+            // movsd is both the string move and the scalar double move
+            if (decode.operands[0].type == ZYDIS_OPERAND_TYPE_MEMORY && decode.operands[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+                return std::static_pointer_cast<lifter::base_x86_translator>(std::make_shared<lifter::movs>(decode, rva));
+
+            return std::static_pointer_cast<lifter::base_x86_translator>(std::make_shared<lifter::sse_mov>(decode, rva));
+        } },
+        { codec::m_movsq, CREATE_LIFTER_GEN(movs) },
+        { codec::m_movss, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movsw, CREATE_LIFTER_GEN(movs) },
         { codec::m_movsx, CREATE_LIFTER_GEN(movsx) },
+        { codec::m_movsxd, CREATE_LIFTER_GEN(movsx) },
+        { codec::m_movupd, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movups, CREATE_LIFTER_GEN(sse_mov) },
+        { codec::m_movzx, CREATE_LIFTER_GEN(movzx) },
+        { codec::m_mul, CREATE_LIFTER_GEN(wide_arith) },
+        { codec::m_mulsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_mulss, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_neg, CREATE_LIFTER_GEN(neg) },
+        { codec::m_not, CREATE_LIFTER_GEN(not_) },
+        { codec::m_or, CREATE_LIFTER_GEN(or_) },
+        { codec::m_orpd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_orps, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_pand, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_pandn, CREATE_LIFTER_GEN(sse_arith) },
         { codec::m_pop, CREATE_LIFTER_GEN(pop) },
+        { codec::m_por, CREATE_LIFTER_GEN(sse_arith) },
         { codec::m_push, CREATE_LIFTER_GEN(push) },
+        { codec::m_pxor, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_rol, CREATE_LIFTER_GEN(rol) },
+        { codec::m_ror, CREATE_LIFTER_GEN(ror) },
+        { codec::m_sar, CREATE_LIFTER_GEN(sar) },
+        { codec::m_sbb, CREATE_LIFTER_GEN(sbb) },
+        { codec::m_setb, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setbe, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setl, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setle, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setnb, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setnbe, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setnl, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setnle, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setno, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setnp, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setns, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setnz, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_seto, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setp, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_sets, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_setz, CREATE_LIFTER_GEN(setcc) },
+        { codec::m_shl, CREATE_LIFTER_GEN(shl) },
+        { codec::m_shr, CREATE_LIFTER_GEN(shr) },
+        { codec::m_sqrtsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_sqrtss, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_stosb, CREATE_LIFTER_GEN(stos) },
+        { codec::m_stosd, CREATE_LIFTER_GEN(stos) },
+        { codec::m_stosq, CREATE_LIFTER_GEN(stos) },
+        { codec::m_stosw, CREATE_LIFTER_GEN(stos) },
         { codec::m_sub, CREATE_LIFTER_GEN(sub) },
+        { codec::m_subsd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_subss, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_test, CREATE_LIFTER_GEN(test) },
+        { codec::m_ucomisd, CREATE_LIFTER_GEN(sse_compare) },
+        { codec::m_ucomiss, CREATE_LIFTER_GEN(sse_compare) },
+        { codec::m_xchg, CREATE_LIFTER_GEN(xchg) },
+        { codec::m_xor, CREATE_LIFTER_GEN(xor_) },
+        { codec::m_xorpd, CREATE_LIFTER_GEN(sse_arith) },
+        { codec::m_xorps, CREATE_LIFTER_GEN(sse_arith) },
     };
 }
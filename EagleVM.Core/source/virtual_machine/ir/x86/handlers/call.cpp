@@ -0,0 +1,9 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/call.h"
+
+namespace eagle::ir::lifter
+{
+    void call::finalize_translate_to_virtual()
+    {
+        // no handler call, the target pushed by the operand encoders is consumed by the call command itself
+    }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/cmovcc.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+
+namespace eagle::ir::handler
+{
+    cmovcc::cmovcc(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_16 }, { codec::op_none, codec::bit_16 } }, "cmovcc 16,16" },
+            { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_32 } }, "cmovcc 32,32" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_64 } }, "cmovcc 64,64" },
+        };
+
+        build_options = {
+            { { ir_size::bit_16, ir_size::bit_16 }, "cmovcc 16,16" },
+            { { ir_size::bit_32, ir_size::bit_32 }, "cmovcc 32,32" },
+            { { ir_size::bit_64, ir_size::bit_64 }, "cmovcc 64,64" },
+        };
+    }
+
+    ir_insts cmovcc::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+        VM_ASSERT(signature[0] == signature[1], "invalid signature. must contain same sized parameters");
+
+        ir_size target_size = signature.front();
+
+        const discrete_store_ptr vtemp = discrete_store::create(target_size);
+        const discrete_store_ptr vtemp2 = discrete_store::create(target_size);
+
+        return {
+            std::make_shared<cmd_pop>(vtemp, target_size),
+            std::make_shared<cmd_pop>(vtemp2, target_size),
+            std::make_shared<cmd_x86_dynamic>(mnemonic, vtemp2, vtemp),
+            std::make_shared<cmd_push>(vtemp2, target_size)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    void cmovcc::finalize_translate_to_virtual()
+    {
+        // the destination is always loaded so a false condition still writes it back unchanged
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        base_x86_translator::finalize_translate_to_virtual();
+
+        // 32 bit destinations get zero extended even when the move does not happen
+        codec::dec::operand first_op = operands[0];
+        codec::reg reg = static_cast<codec::reg>(first_op.reg.value);
+        if (static_cast<ir_size>(first_op.size) == ir_size::bit_32)
+            reg = codec::get_bit_version(first_op.reg.value, codec::gpr_64);
+
+        block->add_command(std::make_shared<cmd_context_store>(reg, static_cast<codec::reg_size>(first_op.size)));
+    }
+}
\ No newline at end of file
@@ -2,12 +2,19 @@
 
 #include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
 #include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_store.h"
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/wide_arith.h"
 
 namespace eagle::ir::handler
 {
     imul::imul()
     {
         valid_operands = {
+            // the one operand form writes rdx:rax, see wide_arith
+            { { { codec::op_none, codec::bit_8 } }, "imul 8" },
+            { { { codec::op_none, codec::bit_16 } }, "imul 16" },
+            { { { codec::op_none, codec::bit_32 } }, "imul 32" },
+            { { { codec::op_none, codec::bit_64 } }, "imul 64" },
+
             { { { codec::op_none, codec::bit_16 }, { codec::op_none, codec::bit_16 } }, "imul 16,16" },
             { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_32 } }, "imul 32,32" },
             { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_64 } }, "imul 64,64" },
@@ -22,6 +29,11 @@ namespace eagle::ir::handler
         };
 
         build_options = {
+            { { ir_size::bit_8 }, "imul 8" },
+            { { ir_size::bit_16 }, "imul 16" },
+            { { ir_size::bit_32 }, "imul 32" },
+            { { ir_size::bit_64 }, "imul 64" },
+
             { { ir_size::bit_16, ir_size::bit_16 }, "imul 16,16" },
             { { ir_size::bit_32, ir_size::bit_32 }, "imul 32,32" },
             { { ir_size::bit_64, ir_size::bit_64 }, "imul 64,64" },
@@ -30,6 +42,9 @@ namespace eagle::ir::handler
 
     ir_insts imul::gen_handler(handler_sig signature)
     {
+        if (signature.size() == 1)
+            return wide_arith(codec::m_imul).gen_handler(signature);
+
         VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
         VM_ASSERT(signature[0] == signature[1], "invalid signature. must contain same sized parameters");
 
@@ -0,0 +1,36 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/movs.h"
+
+namespace eagle::ir::handler
+{
+    movs::movs()
+    {
+        valid_operands = {
+            { { { codec::op_mem, codec::bit_8 }, { codec::op_mem, codec::bit_8 } }, "movs 8" },
+            { { { codec::op_mem, codec::bit_16 }, { codec::op_mem, codec::bit_16 } }, "movs 16" },
+            { { { codec::op_mem, codec::bit_32 }, { codec::op_mem, codec::bit_32 } }, "movs 32" },
+            { { { codec::op_mem, codec::bit_64 }, { codec::op_mem, codec::bit_64 } }, "movs 64" },
+        };
+
+        // the copy is done by the bulk string handlers of the machine so we dont need any build options
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    movs::movs(codec::dec::inst_info decode, const uint64_t rva)
+        : base_x86_translator(decode, rva), decoded_inst(decode)
+    {
+    }
+
+    bool movs::translate_to_il(uint64_t original_rva)
+    {
+        // segment overrides and 32 bit addressing would need more than the raw register values
+        if (inst.address_width != 64 || inst.attributes & ZYDIS_ATTRIB_HAS_SEGMENT)
+            return false;
+
+        const bool rep = inst.attributes & ZYDIS_ATTRIB_HAS_REP;
+        block->add_command(std::make_shared<cmd_string>(string_op::movs, get_op_width(), rep, codec::decode_to_encode(decoded_inst)));
+
+        return true;
+    }
+}
\ No newline at end of file
@@ -14,6 +14,9 @@ namespace eagle::ir::handler
 
             { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_16 } }, "movsx, 32,16" },
             { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_16 } }, "movsx, 64,16" },
+
+            // movsxd shares the lifter
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_32 } }, "movsx, 64,32" },
         };
     }
 }
@@ -0,0 +1,63 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/movzx.h"
+
+namespace eagle::ir::handler
+{
+    movzx::movzx()
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_16 }, { codec::op_none, codec::bit_8 } }, "movzx 16,8" },
+            { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_8 } }, "movzx 32,8" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_8 } }, "movzx 64,8" },
+
+            { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_16 } }, "movzx 32,16" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_16 } }, "movzx 64,16" },
+        };
+
+        build_options = {
+            { { ir_size::bit_16, ir_size::bit_8 }, "movzx 16,8" },
+            { { ir_size::bit_32, ir_size::bit_8 }, "movzx 32,8" },
+            { { ir_size::bit_64, ir_size::bit_8 }, "movzx 64,8" },
+
+            { { ir_size::bit_32, ir_size::bit_16 }, "movzx 32,16" },
+            { { ir_size::bit_64, ir_size::bit_16 }, "movzx 64,16" },
+        };
+    }
+
+    ir_insts movzx::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+
+        ir_size target_size = signature[0];
+        ir_size source_size = signature[1];
+
+        const discrete_store_ptr vtemp = discrete_store::create(source_size);
+        const discrete_store_ptr vtemp2 = discrete_store::create(target_size);
+
+        return {
+            std::make_shared<cmd_pop>(vtemp, source_size),
+            std::make_shared<cmd_x86_dynamic>(codec::m_movzx, vtemp2, vtemp),
+            std::make_shared<cmd_push>(vtemp2, target_size)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    void movzx::finalize_translate_to_virtual()
+    {
+        base_x86_translator::finalize_translate_to_virtual();
+
+        // always will be a reg
+        codec::dec::operand first_op = operands[0];
+        codec::reg reg = static_cast<codec::reg>(first_op.reg.value);
+        if (static_cast<ir_size>(first_op.size) == ir_size::bit_32)
+            reg = codec::get_bit_version(first_op.reg.value, codec::gpr_64);
+
+        block->add_command(std::make_shared<cmd_context_store>(reg, static_cast<codec::reg_size>(first_op.size)));
+    }
+
+    bool movzx::skip(const uint8_t idx)
+    {
+        return idx == 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/not.h"
+
+namespace eagle::ir::handler
+{
+    not_::not_()
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_8 } }, "not 8" },
+            { { { codec::op_none, codec::bit_16 } }, "not 16" },
+            { { { codec::op_none, codec::bit_32 } }, "not 32" },
+            { { { codec::op_none, codec::bit_64 } }, "not 64" },
+        };
+
+        build_options = {
+            { { ir_size::bit_8 }, "not 8" },
+            { { ir_size::bit_16 }, "not 16" },
+            { { ir_size::bit_32 }, "not 32" },
+            { { ir_size::bit_64 }, "not 64" },
+        };
+    }
+
+    ir_insts not_::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 1, "invalid signature. must contain 1 operand");
+        ir_size target_size = signature.front();
+
+        const discrete_store_ptr vtemp = discrete_store::create(target_size);
+
+        return {
+            std::make_shared<cmd_pop>(vtemp, target_size),
+            std::make_shared<cmd_x86_dynamic>(codec::m_not, vtemp),
+            std::make_shared<cmd_push>(vtemp, target_size)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    translate_mem_result not_::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return translate_mem_result::both;
+    }
+
+    void not_::finalize_translate_to_virtual()
+    {
+        // not does not touch rflags
+        base_x86_translator::finalize_translate_to_virtual();
+
+        codec::dec::operand first_op = operands[0];
+        if (first_op.type == ZYDIS_OPERAND_TYPE_REGISTER)
+        {
+            // register
+            codec::reg reg = static_cast<codec::reg>(first_op.reg.value);
+            if (static_cast<ir_size>(first_op.size) == ir_size::bit_32)
+                reg = codec::get_bit_version(first_op.reg.value, codec::gpr_64);
+
+            block->add_command(std::make_shared<cmd_context_store>(reg, static_cast<codec::reg_size>(first_op.size)));
+        }
+        else if (first_op.type == ZYDIS_OPERAND_TYPE_MEMORY)
+        {
+            ir_size value_size = static_cast<ir_size>(first_op.size);
+            block->add_command(std::make_shared<cmd_mem_write>(value_size, value_size));
+        }
+    }
+}
\ No newline at end of file
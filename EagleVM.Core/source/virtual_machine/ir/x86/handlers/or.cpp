@@ -0,0 +1,94 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/or.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_store.h"
+
+namespace eagle::ir::handler
+{
+    or_::or_()
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_8 }, { codec::op_none, codec::bit_8 } }, "or 8,8" },
+            { { { codec::op_none, codec::bit_16 }, { codec::op_none, codec::bit_16 } }, "or 16,16" },
+            { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_32 } }, "or 32,32" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_64 } }, "or 64,64" },
+
+            // sign extended handlers
+            { { { codec::op_none, codec::bit_16 }, { codec::op_imm, codec::bit_8 } }, "or 16,16" },
+            { { { codec::op_none, codec::bit_32 }, { codec::op_imm, codec::bit_8 } }, "or 32,32" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_imm, codec::bit_8 } }, "or 64,64" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_imm, codec::bit_32 } }, "or 64,64" },
+        };
+
+        build_options = {
+            { { ir_size::bit_8, ir_size::bit_8 }, "or 8,8" },
+            { { ir_size::bit_16, ir_size::bit_16 }, "or 16,16" },
+            { { ir_size::bit_32, ir_size::bit_32 }, "or 32,32" },
+            { { ir_size::bit_64, ir_size::bit_64 }, "or 64,64" },
+        };
+    }
+
+    ir_insts or_::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+        VM_ASSERT(signature[0] == signature[1], "invalid signature. must contain same sized parameters");
+
+        ir_size target_size = signature.front();
+
+        const discrete_store_ptr vtemp = discrete_store::create(target_size);
+        const discrete_store_ptr vtemp2 = discrete_store::create(target_size);
+
+        return {
+            std::make_shared<cmd_pop>(vtemp, target_size),
+            std::make_shared<cmd_pop>(vtemp2, target_size),
+            std::make_shared<cmd_x86_dynamic>(codec::m_or, vtemp2, vtemp),
+            std::make_shared<cmd_push>(vtemp2, target_size)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    translate_mem_result or_::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return idx == 0 ? translate_mem_result::both : base_x86_translator::translate_mem_action(op_mem, idx);
+    }
+
+    translate_status or_::encode_operand(codec::dec::op_imm op_imm, uint8_t)
+    {
+        codec::dec::operand second_op = operands[1];
+        codec::dec::operand first_op = operands[0];
+
+        ir_size imm_size = static_cast<ir_size>(second_op.size);
+        ir_size imm_size_target = static_cast<ir_size>(first_op.size);
+
+        block->add_command(std::make_shared<cmd_push>(op_imm.value.u, imm_size));
+        if (imm_size != imm_size_target)
+            block->add_command(std::make_shared<cmd_sx>(imm_size_target, imm_size));
+
+        return translate_status::success;
+    }
+
+    void or_::finalize_translate_to_virtual()
+    {
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        base_x86_translator::finalize_translate_to_virtual();
+        block->add_command(std::make_shared<cmd_rflags_store>());
+
+        codec::dec::operand first_op = operands[0];
+        if (first_op.type == ZYDIS_OPERAND_TYPE_REGISTER)
+        {
+            // register
+            codec::reg reg = static_cast<codec::reg>(first_op.reg.value);
+            if (static_cast<ir_size>(first_op.size) == ir_size::bit_32)
+                reg = codec::get_bit_version(first_op.reg.value, codec::gpr_64);
+
+            block->add_command(std::make_shared<cmd_context_store>(reg, static_cast<codec::reg_size>(first_op.size)));
+        }
+        else if (first_op.type == ZYDIS_OPERAND_TYPE_MEMORY)
+        {
+            ir_size value_size = static_cast<ir_size>(first_op.size);
+            block->add_command(std::make_shared<cmd_mem_write>(value_size, value_size));
+        }
+    }
+}
\ No newline at end of file
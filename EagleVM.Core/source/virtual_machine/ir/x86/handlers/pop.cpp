@@ -37,7 +37,7 @@ namespace eagle::ir::lifter
         ir_size size = get_op_width();
 
         discrete_store_ptr store = discrete_store::create(size);
-        block->add_command(std::make_shared<cmd_pop>(store, size));
+        block->add_command(std::make_shared<cmd_pop>(store, size)->release(store));
 
         auto first_op = operands[0];
         switch (first_op.type)
@@ -22,11 +22,6 @@ namespace eagle::ir::handler
 
 namespace eagle::ir::lifter
 {
-    translate_mem_result push::translate_mem_result()
-    {
-        return translate_mem_result::value;
-    }
-
     void push::finalize_translate_to_virtual()
     {
         // dont do anything because the operand encoders automatically push values
@@ -0,0 +1,90 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/rol.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_store.h"
+
+namespace eagle::ir::handler
+{
+    rol::rol()
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_8 }, { codec::op_none, codec::bit_8 } }, "rol 8,8" },
+            { { { codec::op_none, codec::bit_16 }, { codec::op_none, codec::bit_8 } }, "rol 16,8" },
+            { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_8 } }, "rol 32,8" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_8 } }, "rol 64,8" },
+
+            // implicit count of 1, the lifter pushes it
+            { { { codec::op_none, codec::bit_8 } }, "rol 8,8" },
+            { { { codec::op_none, codec::bit_16 } }, "rol 16,8" },
+            { { { codec::op_none, codec::bit_32 } }, "rol 32,8" },
+            { { { codec::op_none, codec::bit_64 } }, "rol 64,8" },
+        };
+
+        build_options = {
+            { { ir_size::bit_8, ir_size::bit_8 }, "rol 8,8" },
+            { { ir_size::bit_16, ir_size::bit_8 }, "rol 16,8" },
+            { { ir_size::bit_32, ir_size::bit_8 }, "rol 32,8" },
+            { { ir_size::bit_64, ir_size::bit_8 }, "rol 64,8" },
+        };
+    }
+
+    ir_insts rol::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+        VM_ASSERT(signature[1] == ir_size::bit_8, "invalid signature. count must be 8 bits");
+
+        ir_size target_size = signature.front();
+
+        const discrete_store_ptr vtemp = discrete_store::create(ir_size::bit_8);
+        const discrete_store_ptr vtemp2 = discrete_store::create(target_size);
+
+        // the machine moves the count into cl
+        return {
+            std::make_shared<cmd_pop>(vtemp, ir_size::bit_8),
+            std::make_shared<cmd_pop>(vtemp2, target_size),
+            std::make_shared<cmd_x86_dynamic>(codec::m_rol, vtemp2, vtemp),
+            std::make_shared<cmd_push>(vtemp2, target_size)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    translate_mem_result rol::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return idx == 0 ? translate_mem_result::both : base_x86_translator::translate_mem_action(op_mem, idx);
+    }
+
+    translate_status rol::encode_operand(codec::dec::op_imm op_imm, uint8_t)
+    {
+        block->add_command(std::make_shared<cmd_push>(op_imm.value.u & 0xFF, ir_size::bit_8));
+        return translate_status::success;
+    }
+
+    void rol::finalize_translate_to_virtual()
+    {
+        if (inst.operand_count_visible == 1)
+            block->add_command(std::make_shared<cmd_push>(1, ir_size::bit_8));
+
+        // a masked count of 0 leaves rflags alone, which works out since the guest flags are loaded
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        base_x86_translator::finalize_translate_to_virtual();
+        block->add_command(std::make_shared<cmd_rflags_store>());
+
+        codec::dec::operand first_op = operands[0];
+        if (first_op.type == ZYDIS_OPERAND_TYPE_REGISTER)
+        {
+            // register
+            codec::reg reg = static_cast<codec::reg>(first_op.reg.value);
+            if (static_cast<ir_size>(first_op.size) == ir_size::bit_32)
+                reg = codec::get_bit_version(first_op.reg.value, codec::gpr_64);
+
+            block->add_command(std::make_shared<cmd_context_store>(reg, static_cast<codec::reg_size>(first_op.size)));
+        }
+        else if (first_op.type == ZYDIS_OPERAND_TYPE_MEMORY)
+        {
+            ir_size value_size = static_cast<ir_size>(first_op.size);
+            block->add_command(std::make_shared<cmd_mem_write>(value_size, value_size));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/setcc.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+
+namespace eagle::ir::handler
+{
+    setcc::setcc(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_8 } }, "setcc 8" },
+        };
+
+        build_options = {
+            { { ir_size::bit_8 }, "setcc 8" },
+        };
+    }
+
+    ir_insts setcc::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 1, "invalid signature. must contain 1 operand");
+        VM_ASSERT(signature.front() == ir_size::bit_8, "invalid signature. setcc only writes 8 bits");
+
+        const discrete_store_ptr vtemp = discrete_store::create(ir_size::bit_8);
+
+        return {
+            std::make_shared<cmd_x86_dynamic>(mnemonic, vtemp),
+            std::make_shared<cmd_push>(vtemp, ir_size::bit_8)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    translate_mem_result setcc::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return translate_mem_result::address;
+    }
+
+    bool setcc::skip(const uint8_t idx)
+    {
+        return operands[idx].type == ZYDIS_OPERAND_TYPE_REGISTER;
+    }
+
+    void setcc::finalize_translate_to_virtual()
+    {
+        // condition is tested against the guest flags, nothing gets written back to them
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        base_x86_translator::finalize_translate_to_virtual();
+
+        codec::dec::operand first_op = operands[0];
+        if (first_op.type == ZYDIS_OPERAND_TYPE_REGISTER)
+        {
+            codec::reg reg = static_cast<codec::reg>(first_op.reg.value);
+            block->add_command(std::make_shared<cmd_context_store>(reg, codec::reg_size::bit_8));
+        }
+        else if (first_op.type == ZYDIS_OPERAND_TYPE_MEMORY)
+        {
+            block->add_command(std::make_shared<cmd_mem_write>(ir_size::bit_8, ir_size::bit_8));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_arith.h"
+
+#include "eaglevm-core/virtual_machine/ir/x86/util.h"
+
+namespace eagle::ir::handler
+{
+    sse_arith::sse_arith(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        // zydis sizes scalar register operands by their element so every width is accepted
+        // the lifter calls the handler with the sizes that actually end up on the stack
+        for (const codec::reg_size first : { codec::bit_32, codec::bit_64, codec::bit_128 })
+            for (const codec::reg_size second : { codec::bit_32, codec::bit_64, codec::bit_128 })
+                valid_operands.push_back({ { { codec::op_reg, first }, { codec::op_none, second } }, "sse_arith" });
+
+        build_options = {
+            { { ir_size::bit_128, ir_size::bit_32 }, "sse_arith 128,32" },
+            { { ir_size::bit_128, ir_size::bit_64 }, "sse_arith 128,64" },
+            { { ir_size::bit_128, ir_size::bit_128 }, "sse_arith 128,128" },
+        };
+    }
+
+    ir_insts sse_arith::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+        VM_ASSERT(signature[0] == ir_size::bit_128, "invalid signature. destination must be an xmm register");
+
+        const discrete_store_ptr vtemp = discrete_store::create(ir_size::bit_128);
+        const discrete_store_ptr vtemp2 = discrete_store::create(ir_size::bit_128);
+
+        ir_insts insts = pop_xmm_operand(vtemp, signature[1]);
+        insts.append_range(ir_insts{
+            std::make_shared<cmd_pop>(vtemp2, ir_size::bit_128),
+            std::make_shared<cmd_x86_dynamic>(mnemonic, vtemp2, vtemp),
+            std::make_shared<cmd_push>(vtemp2, ir_size::bit_128)
+        });
+
+        return insts;
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    bool sse_arith::translate_to_il(const uint64_t original_rva)
+    {
+        // mmx forms share these mnemonics
+        if (!is_sse_operands(operands, inst.operand_count_visible))
+            return false;
+
+        return base_x86_translator::translate_to_il(original_rva);
+    }
+
+    translate_mem_result sse_arith::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        // operand_width does not describe sse memory, the read is sized in finalize
+        return translate_mem_result::address;
+    }
+
+    void sse_arith::finalize_translate_to_virtual()
+    {
+        // even scalar destinations are loaded, the upper lanes are kept
+        const ir_size source_size = get_sse_operand_size(operands[1]);
+        if (operands[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+            block->add_command(std::make_shared<cmd_mem_read>(source_size));
+
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+        block->add_command(std::make_shared<cmd_handler_call>(mnemonic, handler_sig{ ir_size::bit_128, source_size }));
+
+        const codec::reg target_reg = static_cast<codec::reg>(operands[0].reg.value);
+        block->add_command(std::make_shared<cmd_context_store>(target_reg, codec::bit_128));
+    }
+}
\ No newline at end of file
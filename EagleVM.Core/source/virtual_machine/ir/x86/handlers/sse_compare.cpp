@@ -0,0 +1,69 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_compare.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_store.h"
+#include "eaglevm-core/virtual_machine/ir/x86/util.h"
+
+namespace eagle::ir::handler
+{
+    sse_compare::sse_compare(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        // same as sse_arith, the lifter picks the real sizes
+        for (const codec::reg_size first : { codec::bit_32, codec::bit_64, codec::bit_128 })
+            for (const codec::reg_size second : { codec::bit_32, codec::bit_64, codec::bit_128 })
+                valid_operands.push_back({ { { codec::op_reg, first }, { codec::op_none, second } }, "sse_compare" });
+
+        build_options = {
+            { { ir_size::bit_128, ir_size::bit_32 }, "sse_compare 128,32" },
+            { { ir_size::bit_128, ir_size::bit_64 }, "sse_compare 128,64" },
+            { { ir_size::bit_128, ir_size::bit_128 }, "sse_compare 128,128" },
+        };
+    }
+
+    ir_insts sse_compare::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+        VM_ASSERT(signature[0] == ir_size::bit_128, "invalid signature. first operand must be an xmm register");
+
+        const discrete_store_ptr vtemp = discrete_store::create(ir_size::bit_128);
+        const discrete_store_ptr vtemp2 = discrete_store::create(ir_size::bit_128);
+
+        ir_insts insts = pop_xmm_operand(vtemp, signature[1]);
+        insts.append_range(ir_insts{
+            std::make_shared<cmd_pop>(vtemp2, ir_size::bit_128),
+            std::make_shared<cmd_x86_dynamic>(mnemonic, vtemp2, vtemp)
+        });
+
+        return insts;
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    bool sse_compare::translate_to_il(const uint64_t original_rva)
+    {
+        if (!is_sse_operands(operands, inst.operand_count_visible))
+            return false;
+
+        return base_x86_translator::translate_to_il(original_rva);
+    }
+
+    translate_mem_result sse_compare::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return translate_mem_result::address;
+    }
+
+    void sse_compare::finalize_translate_to_virtual()
+    {
+        const ir_size source_size = get_sse_operand_size(operands[1]);
+        if (operands[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+            block->add_command(std::make_shared<cmd_mem_read>(source_size));
+
+        // comis and ucomis only write zf, pf and cf and clear the rest of the status flags
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        block->add_command(std::make_shared<cmd_handler_call>(mnemonic, handler_sig{ ir_size::bit_128, source_size }));
+        block->add_command(std::make_shared<cmd_rflags_store>());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_convert.h"
+
+#include "eaglevm-core/virtual_machine/ir/x86/util.h"
+
+namespace eagle::ir::handler
+{
+    sse_convert::sse_convert(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        // same as sse_arith, the lifter picks the real sizes
+        for (const codec::reg_size first : { codec::bit_32, codec::bit_64, codec::bit_128 })
+            for (const codec::reg_size second : { codec::bit_32, codec::bit_64, codec::bit_128 })
+                valid_operands.push_back({ { { codec::op_reg, first }, { codec::op_none, second } }, "sse_convert" });
+
+        build_options = {
+            // xmm destinations
+            { { ir_size::bit_128, ir_size::bit_32 }, "sse_convert 128,32" },
+            { { ir_size::bit_128, ir_size::bit_64 }, "sse_convert 128,64" },
+            { { ir_size::bit_128, ir_size::bit_128 }, "sse_convert 128,128" },
+
+            // gpr destinations
+            { { ir_size::bit_32, ir_size::bit_32 }, "sse_convert 32,32" },
+            { { ir_size::bit_32, ir_size::bit_64 }, "sse_convert 32,64" },
+            { { ir_size::bit_32, ir_size::bit_128 }, "sse_convert 32,128" },
+            { { ir_size::bit_64, ir_size::bit_32 }, "sse_convert 64,32" },
+            { { ir_size::bit_64, ir_size::bit_64 }, "sse_convert 64,64" },
+            { { ir_size::bit_64, ir_size::bit_128 }, "sse_convert 64,128" },
+        };
+    }
+
+    ir_insts sse_convert::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+
+        const ir_size dest_size = signature[0];
+        const ir_size source_size = signature[1];
+
+        // cvtsi2ss and cvtsi2sd take their integer straight from a gpr
+        ir_insts insts;
+        discrete_store_ptr source;
+        if (mnemonic == codec::m_cvtsi2ss || mnemonic == codec::m_cvtsi2sd)
+        {
+            source = discrete_store::create(source_size);
+            insts.push_back(std::make_shared<cmd_pop>(source, source_size));
+        }
+        else
+        {
+            source = discrete_store::create(ir_size::bit_128);
+            insts.append_range(pop_xmm_operand(source, source_size));
+        }
+
+        const discrete_store_ptr dest = discrete_store::create(dest_size);
+        if (dest_size == ir_size::bit_128)
+        {
+            // only the low lane is converted into, the rest of the destination stays
+            insts.push_back(std::make_shared<cmd_pop>(dest, ir_size::bit_128));
+        }
+
+        insts.append_range(ir_insts{
+            std::make_shared<cmd_x86_dynamic>(mnemonic, dest, source),
+            std::make_shared<cmd_push>(dest, dest_size)
+        });
+
+        return insts;
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    bool sse_convert::translate_to_il(const uint64_t original_rva)
+    {
+        // mmx forms share these mnemonics
+        if (!is_sse_operands(operands, inst.operand_count_visible))
+            return false;
+
+        return base_x86_translator::translate_to_il(original_rva);
+    }
+
+    translate_mem_result sse_convert::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return translate_mem_result::address;
+    }
+
+    bool sse_convert::skip(const uint8_t idx)
+    {
+        // gpr destinations are fully written
+        return idx == 0 && codec::get_reg_class(static_cast<codec::reg>(operands[0].reg.value)) != codec::xmm_128;
+    }
+
+    void sse_convert::finalize_translate_to_virtual()
+    {
+        const ir_size dest_size = get_sse_operand_size(operands[0]);
+        const ir_size source_size = get_sse_operand_size(operands[1]);
+        if (operands[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+            block->add_command(std::make_shared<cmd_mem_read>(source_size));
+
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+        block->add_command(std::make_shared<cmd_handler_call>(mnemonic, handler_sig{ dest_size, source_size }));
+
+        // 32 bit gpr destinations are zero extended
+        codec::reg target_reg = static_cast<codec::reg>(operands[0].reg.value);
+        if (dest_size == ir_size::bit_32)
+            target_reg = codec::get_bit_version(target_reg, codec::gpr_64);
+
+        block->add_command(std::make_shared<cmd_context_store>(target_reg, static_cast<codec::reg_size>(dest_size)));
+    }
+}
\ No newline at end of file
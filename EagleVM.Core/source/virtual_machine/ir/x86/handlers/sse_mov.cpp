@@ -0,0 +1,137 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/sse_mov.h"
+
+#include "eaglevm-core/virtual_machine/ir/x86/util.h"
+
+namespace eagle::ir::handler
+{
+    sse_mov::sse_mov(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        // same as sse_arith, the lifter picks the real sizes
+        for (const codec::reg_size first : { codec::bit_32, codec::bit_64, codec::bit_128 })
+            for (const codec::reg_size second : { codec::bit_32, codec::bit_64, codec::bit_128 })
+                valid_operands.push_back({ { { codec::op_none, first }, { codec::op_none, second } }, "sse_mov" });
+
+        // movsd shares its mnemonic with the string move
+        if (mnemonic == codec::m_movsd)
+            valid_operands.push_back({ { { codec::op_mem, codec::bit_32 }, { codec::op_mem, codec::bit_32 } }, "movs 32" });
+
+        // full width moves and stores to memory never call a handler
+        build_options = {
+            { { ir_size::bit_128, ir_size::bit_32 }, "sse_mov 128,32" },
+            { { ir_size::bit_128, ir_size::bit_64 }, "sse_mov 128,64" },
+            { { ir_size::bit_128, ir_size::bit_128 }, "sse_mov 128,128" },
+            { { ir_size::bit_32, ir_size::bit_128 }, "sse_mov 32,128" },
+            { { ir_size::bit_64, ir_size::bit_128 }, "sse_mov 64,128" },
+        };
+    }
+
+    ir_insts sse_mov::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+
+        const ir_size dest_size = signature[0];
+        const ir_size source_size = signature[1];
+
+        if (dest_size != ir_size::bit_128)
+        {
+            // movd and movq out of an xmm register
+            const discrete_store_ptr vtemp = discrete_store::create(ir_size::bit_128);
+            const discrete_store_ptr vtemp2 = discrete_store::create(dest_size);
+
+            return {
+                std::make_shared<cmd_pop>(vtemp, ir_size::bit_128),
+                std::make_shared<cmd_x86_dynamic>(dest_size == ir_size::bit_64 ? codec::m_movq : codec::m_movd, vtemp2, vtemp),
+                std::make_shared<cmd_push>(vtemp2, dest_size)
+            };
+        }
+
+        const discrete_store_ptr vtemp = discrete_store::create(ir_size::bit_128);
+        if (source_size != ir_size::bit_128)
+        {
+            // loads of a scalar zero everything above it
+            ir_insts insts = pop_xmm_operand(vtemp, source_size);
+            insts.push_back(std::make_shared<cmd_push>(vtemp, ir_size::bit_128));
+
+            return insts;
+        }
+
+        const discrete_store_ptr vtemp2 = discrete_store::create(ir_size::bit_128);
+        if (mnemonic == codec::m_movq)
+        {
+            return {
+                std::make_shared<cmd_pop>(vtemp, ir_size::bit_128),
+                std::make_shared<cmd_x86_dynamic>(codec::m_movq, vtemp2, vtemp),
+                std::make_shared<cmd_push>(vtemp2, ir_size::bit_128)
+            };
+        }
+
+        VM_ASSERT(mnemonic == codec::m_movss || mnemonic == codec::m_movsd, "full width moves do not have a handler");
+        return {
+            std::make_shared<cmd_pop>(vtemp, ir_size::bit_128),
+            std::make_shared<cmd_pop>(vtemp2, ir_size::bit_128),
+            std::make_shared<cmd_x86_dynamic>(mnemonic, vtemp2, vtemp),
+            std::make_shared<cmd_push>(vtemp2, ir_size::bit_128)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    bool sse_mov::translate_to_il(const uint64_t original_rva)
+    {
+        // mmx forms share these mnemonics
+        if (!is_sse_operands(operands, inst.operand_count_visible))
+            return false;
+
+        return base_x86_translator::translate_to_il(original_rva);
+    }
+
+    translate_mem_result sse_mov::translate_mem_action(const codec::dec::op_mem& op_mem, uint8_t idx)
+    {
+        return translate_mem_result::address;
+    }
+
+    bool sse_mov::skip(const uint8_t idx)
+    {
+        // register destinations are only read when the upper lanes survive
+        return idx == 0 && operands[0].type == ZYDIS_OPERAND_TYPE_REGISTER && !is_merge();
+    }
+
+    void sse_mov::finalize_translate_to_virtual()
+    {
+        const ir_size dest_size = get_sse_operand_size(operands[0]);
+        const ir_size source_size = get_sse_operand_size(operands[1]);
+
+        if (operands[0].type == ZYDIS_OPERAND_TYPE_MEMORY)
+        {
+            // the xmm register sits on top of the address, only the low bits of it get written
+            block->add_command(std::make_shared<cmd_mem_write>(ir_size::bit_128, dest_size));
+            return;
+        }
+
+        if (operands[1].type == ZYDIS_OPERAND_TYPE_MEMORY)
+            block->add_command(std::make_shared<cmd_mem_read>(source_size));
+
+        // movaps and friends push exactly what gets stored
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+        const bool full_move = dest_size == ir_size::bit_128 && source_size == ir_size::bit_128 && !is_merge() && mnemonic != codec::m_movq;
+        if (!full_move)
+            block->add_command(std::make_shared<cmd_handler_call>(mnemonic, handler_sig{ dest_size, source_size }));
+
+        codec::reg target_reg = static_cast<codec::reg>(operands[0].reg.value);
+        if (dest_size == ir_size::bit_32)
+            target_reg = codec::get_bit_version(target_reg, codec::gpr_64);
+
+        block->add_command(std::make_shared<cmd_context_store>(target_reg, static_cast<codec::reg_size>(dest_size)));
+    }
+
+    bool sse_mov::is_merge() const
+    {
+        const codec::mnemonic mnemonic = static_cast<codec::mnemonic>(inst.mnemonic);
+        if (mnemonic != codec::m_movss && mnemonic != codec::m_movsd)
+            return false;
+
+        return operands[0].type == ZYDIS_OPERAND_TYPE_REGISTER && operands[1].type == ZYDIS_OPERAND_TYPE_REGISTER;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/stos.h"
+
+namespace eagle::ir::handler
+{
+    stos::stos()
+    {
+        valid_operands = {
+            { { { codec::op_mem, codec::bit_8 }, { codec::op_reg, codec::bit_8 } }, "stos 8" },
+            { { { codec::op_mem, codec::bit_16 }, { codec::op_reg, codec::bit_16 } }, "stos 16" },
+            { { { codec::op_mem, codec::bit_32 }, { codec::op_reg, codec::bit_32 } }, "stos 32" },
+            { { { codec::op_mem, codec::bit_64 }, { codec::op_reg, codec::bit_64 } }, "stos 64" },
+        };
+
+        // the fill is done by the bulk string handlers of the machine so we dont need any build options
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    stos::stos(codec::dec::inst_info decode, const uint64_t rva)
+        : base_x86_translator(decode, rva), decoded_inst(decode)
+    {
+    }
+
+    bool stos::translate_to_il(uint64_t original_rva)
+    {
+        // es cannot be overridden but 32 bit addressing would still truncate rdi
+        if (inst.address_width != 64)
+            return false;
+
+        const bool rep = inst.attributes & ZYDIS_ATTRIB_HAS_REP;
+        block->add_command(std::make_shared<cmd_string>(string_op::stos, get_op_width(), rep, codec::decode_to_encode(decoded_inst)));
+
+        return true;
+    }
+}
\ No newline at end of file
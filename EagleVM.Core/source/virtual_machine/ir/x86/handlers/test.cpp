@@ -0,0 +1,72 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/test.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_store.h"
+
+namespace eagle::ir::handler
+{
+    test::test()
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_8 }, { codec::op_none, codec::bit_8 } }, "test 8,8" },
+            { { { codec::op_none, codec::bit_16 }, { codec::op_none, codec::bit_16 } }, "test 16,16" },
+            { { { codec::op_none, codec::bit_32 }, { codec::op_none, codec::bit_32 } }, "test 32,32" },
+            { { { codec::op_none, codec::bit_64 }, { codec::op_none, codec::bit_64 } }, "test 64,64" },
+
+            // sign extended handlers
+            { { { codec::op_none, codec::bit_64 }, { codec::op_imm, codec::bit_32 } }, "test 64,64" },
+        };
+
+        build_options = {
+            { { ir_size::bit_8, ir_size::bit_8 }, "test 8,8" },
+            { { ir_size::bit_16, ir_size::bit_16 }, "test 16,16" },
+            { { ir_size::bit_32, ir_size::bit_32 }, "test 32,32" },
+            { { ir_size::bit_64, ir_size::bit_64 }, "test 64,64" },
+        };
+    }
+
+    ir_insts test::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 2, "invalid signature. must contain 2 operands");
+        VM_ASSERT(signature[0] == signature[1], "invalid signature. must contain same sized parameters");
+
+        ir_size target_size = signature.front();
+
+        const discrete_store_ptr vtemp = discrete_store::create(target_size);
+        const discrete_store_ptr vtemp2 = discrete_store::create(target_size);
+
+        return {
+            std::make_shared<cmd_pop>(vtemp, target_size),
+            std::make_shared<cmd_pop>(vtemp2, target_size),
+            std::make_shared<cmd_x86_dynamic>(codec::m_test, vtemp2, vtemp)
+        };
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    void test::finalize_translate_to_virtual()
+    {
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        base_x86_translator::finalize_translate_to_virtual();
+        block->add_command(std::make_shared<cmd_rflags_store>());
+    }
+
+    translate_status test::encode_operand(codec::dec::op_imm op_imm, uint8_t idx)
+    {
+        codec::dec::operand second_op = operands[1];
+        codec::dec::operand first_op = operands[0];
+
+        ir_size imm_size = static_cast<ir_size>(second_op.size);
+        ir_size imm_size_target = static_cast<ir_size>(first_op.size);
+
+        // REX.W + A9 id	TEST RAX, imm32
+        // REX.W + F7 /0 id	TEST r/m64, imm32
+        block->add_command(std::make_shared<cmd_push>(op_imm.value.u, imm_size));
+        if (imm_size != imm_size_target)
+            block->add_command(std::make_shared<cmd_sx>(imm_size_target, imm_size));
+
+        stack_displacement += static_cast<uint16_t>(TOB(imm_size_target));
+        return translate_status::success;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/wide_arith.h"
+
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_load.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_rflags_store.h"
+
+namespace eagle::ir::handler
+{
+    wide_arith::wide_arith(const codec::mnemonic mnemonic)
+        : mnemonic(mnemonic)
+    {
+        valid_operands = {
+            { { { codec::op_none, codec::bit_8 } }, "wide 8" },
+            { { { codec::op_none, codec::bit_16 } }, "wide 16" },
+            { { { codec::op_none, codec::bit_32 } }, "wide 32" },
+            { { { codec::op_none, codec::bit_64 } }, "wide 64" },
+        };
+
+        build_options = {
+            { { ir_size::bit_8 }, "wide 8" },
+            { { ir_size::bit_16 }, "wide 16" },
+            { { ir_size::bit_32 }, "wide 32" },
+            { { ir_size::bit_64 }, "wide 64" },
+        };
+    }
+
+    ir_insts wide_arith::gen_handler(handler_sig signature)
+    {
+        VM_ASSERT(signature.size() == 1, "invalid signature. must contain 1 operand");
+
+        // division by zero or a quotient that does not fit raises #DE from inside the handler, same as native
+        const ir_size target_size = signature.front();
+        const discrete_store_ptr source = discrete_store::create(target_size);
+
+        if (target_size == ir_size::bit_8)
+        {
+            // the 8 bit forms keep everything in ax
+            const discrete_store_ptr ax = discrete_store::create(ir_size::bit_16);
+            return {
+                std::make_shared<cmd_pop>(source, target_size),
+                std::make_shared<cmd_pop>(ax, ir_size::bit_16),
+                std::make_shared<cmd_x86_dynamic>(mnemonic, source)->bind(codec::rax, ax),
+                std::make_shared<cmd_push>(ax, ir_size::bit_16)
+            };
+        }
+
+        const discrete_store_ptr low = discrete_store::create(target_size);
+        const discrete_store_ptr high = discrete_store::create(target_size);
+
+        ir_insts insts = {
+            std::make_shared<cmd_pop>(source, target_size),
+            std::make_shared<cmd_pop>(low, target_size),
+        };
+
+        // mul only writes rdx so there is nothing to pop for it
+        if (is_division(mnemonic))
+            insts.push_back(std::make_shared<cmd_pop>(high, target_size));
+
+        insts.append_range(ir_insts{
+            std::make_shared<cmd_x86_dynamic>(mnemonic, source)->bind(codec::rax, low)->bind(codec::rdx, high),
+            std::make_shared<cmd_push>(low, target_size),
+            std::make_shared<cmd_push>(high, target_size)
+        });
+
+        return insts;
+    }
+
+    bool wide_arith::is_division(const codec::mnemonic mnemonic)
+    {
+        return mnemonic == codec::m_div || mnemonic == codec::m_idiv;
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    bool wide_arith::translate_to_il(const uint64_t original_rva)
+    {
+        // the implicit operands go under the explicit one, top half first
+        const ir_size size = get_op_width();
+        if (size == ir_size::bit_8)
+        {
+            block->add_command(std::make_shared<cmd_context_load>(codec::ax));
+            stack_displacement += TOB(ir_size::bit_16);
+        }
+        else
+        {
+            const codec::reg_size reg_size = static_cast<codec::reg_size>(size);
+            if (handler::wide_arith::is_division(static_cast<codec::mnemonic>(inst.mnemonic)))
+            {
+                block->add_command(std::make_shared<cmd_context_load>(codec::get_bit_version(codec::rdx, reg_size)));
+                stack_displacement += TOB(size);
+            }
+
+            block->add_command(std::make_shared<cmd_context_load>(codec::get_bit_version(codec::rax, reg_size)));
+            stack_displacement += TOB(size);
+        }
+
+        return base_x86_translator::translate_to_il(original_rva);
+    }
+
+    void wide_arith::finalize_translate_to_virtual()
+    {
+        const ir_size size = get_op_width();
+
+        // mul and imul define cf and of, everything else is undefined and left to the real instruction
+        block->add_command(std::make_shared<cmd_rflags_load>());
+        block->add_command(std::make_shared<cmd_handler_call>(static_cast<codec::mnemonic>(inst.mnemonic), handler_sig{ size }));
+        block->add_command(std::make_shared<cmd_rflags_store>());
+
+        if (size == ir_size::bit_8)
+        {
+            block->add_command(std::make_shared<cmd_context_store>(codec::ax));
+            return;
+        }
+
+        // the top half is pushed last
+        const codec::reg_size reg_size = static_cast<codec::reg_size>(size);
+        if (size == ir_size::bit_32)
+        {
+            // 32 bit results zero the upper halves of rdx and rax
+            block->add_command(std::make_shared<cmd_context_store>(codec::rdx, codec::bit_32));
+            block->add_command(std::make_shared<cmd_context_store>(codec::rax, codec::bit_32));
+            return;
+        }
+
+        block->add_command(std::make_shared<cmd_context_store>(codec::get_bit_version(codec::rdx, reg_size)));
+        block->add_command(std::make_shared<cmd_context_store>(codec::get_bit_version(codec::rax, reg_size)));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "eaglevm-core/virtual_machine/ir/x86/handlers/xchg.h"
+
+namespace eagle::ir::handler
+{
+    xchg::xchg()
+    {
+        // memory forms carry an implicit lock, those are left to run natively
+        valid_operands = {
+            { { { codec::op_reg, codec::bit_8 }, { codec::op_reg, codec::bit_8 } }, "xchg 8,8" },
+            { { { codec::op_reg, codec::bit_16 }, { codec::op_reg, codec::bit_16 } }, "xchg 16,16" },
+            { { { codec::op_reg, codec::bit_32 }, { codec::op_reg, codec::bit_32 } }, "xchg 32,32" },
+            { { { codec::op_reg, codec::bit_64 }, { codec::op_reg, codec::bit_64 } }, "xchg 64,64" },
+        };
+
+        // the lifter swaps through the context directly so we dont need any build options
+    }
+}
+
+namespace eagle::ir::lifter
+{
+    void xchg::finalize_translate_to_virtual()
+    {
+        // the second operand is on top of the stack and goes into the first
+        for (const uint8_t idx : { 0, 1 })
+        {
+            codec::dec::operand op = operands[idx];
+            codec::reg reg = static_cast<codec::reg>(op.reg.value);
+            if (static_cast<ir_size>(op.size) == ir_size::bit_32)
+                reg = codec::get_bit_version(op.reg.value, codec::gpr_64);
+
+            block->add_command(std::make_shared<cmd_context_store>(reg, static_cast<codec::reg_size>(op.size)));
+        }
+
+        // no handler call required
+        // base_x86_translator::finalize_translate_to_virtual();
+    }
+}
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "eaglevm-core/virtual_machine/ir/x86/util.h"
 
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_pop.h"
+#include "eaglevm-core/virtual_machine/ir/commands/cmd_x86_dynamic.h"
+
 namespace eagle::ir
 {
-    ir_size ir::bits_to_ir_size(const uint16_t bit_count)
+    ir_size bits_to_ir_size(const uint16_t bit_count)
     {
         switch (bit_count)
         {
@@ -29,4 +33,50 @@ namespace eagle::ir
             }
         }
     }
+
+    ir_size get_sse_operand_size(const codec::dec::operand& operand)
+    {
+        if (operand.type == ZYDIS_OPERAND_TYPE_REGISTER)
+            return static_cast<ir_size>(codec::get_reg_size(static_cast<codec::reg>(operand.reg.value)));
+
+        return static_cast<ir_size>(operand.size);
+    }
+
+    bool is_sse_operands(const codec::dec::operand* operands, const uint8_t operand_count)
+    {
+        for (uint8_t i = 0; i < operand_count; i++)
+        {
+            if (operands[i].type != ZYDIS_OPERAND_TYPE_REGISTER)
+                continue;
+
+            switch (codec::get_reg_class(static_cast<codec::reg>(operands[i].reg.value)))
+            {
+                case codec::xmm_128:
+                case codec::gpr_64:
+                case codec::gpr_32:
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    ir_insts pop_xmm_operand(const discrete_store_ptr& destination, const ir_size source_size)
+    {
+        if (source_size == ir_size::bit_128)
+            return { std::make_shared<cmd_pop>(destination, ir_size::bit_128) };
+
+        VM_ASSERT(source_size == ir_size::bit_64 || source_size == ir_size::bit_32, "sse operands can only be 32, 64 or 128 bits");
+
+        // movd and movq clear everything above the scalar
+        const discrete_store_ptr scalar = discrete_store::create(source_size);
+        const codec::mnemonic move = source_size == ir_size::bit_64 ? codec::m_movq : codec::m_movd;
+
+        return {
+            std::make_shared<cmd_pop>(scalar, source_size),
+            std::make_shared<cmd_x86_dynamic>(move, destination, scalar)->release(scalar)
+        };
+    }
 }
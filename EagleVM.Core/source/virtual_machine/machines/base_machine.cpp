@@ -126,6 +126,18 @@ namespace eagle::virt
             case ir::command_type::vm_exec_dynamic_x86:
                 handle_cmd(code, std::static_pointer_cast<ir::cmd_x86_dynamic>(command));
                 break;
+            case ir::command_type::vm_native_island:
+                handle_cmd(code, std::static_pointer_cast<ir::cmd_native_island>(command));
+                break;
+            case ir::command_type::vm_call:
+                handle_cmd(code, std::static_pointer_cast<ir::cmd_call>(command));
+                break;
+            case ir::command_type::vm_ret:
+                handle_cmd(code, std::static_pointer_cast<ir::cmd_ret>(command));
+                break;
+            case ir::command_type::vm_string:
+                handle_cmd(code, std::static_pointer_cast<ir::cmd_string>(command));
+                break;
             case ir::command_type::vm_rflags_load:
                 handle_cmd(code, std::static_pointer_cast<ir::cmd_rflags_load>(command));
                 break;
@@ -0,0 +1,145 @@
+#include "eaglevm-core/virtual_machine/machines/eagle/cost_model.h"
+
+#include "eaglevm-core/codec/zydis_helper.h"
+
+using namespace eagle::codec;
+
+namespace eagle::virt::eg
+{
+    void container_cost::add(const container_cost& other)
+    {
+        instructions += other.instructions;
+        memory_ops += other.memory_ops;
+        indirect_jumps += other.indirect_jumps;
+        flags_ops += other.flags_ops;
+        handler_calls += other.handler_calls;
+        cycles += other.cycles;
+    }
+
+    cost_model::cost_model(const cost_weights weights)
+        : weights(weights)
+    {
+    }
+
+    void cost_model::add_handlers(const std::vector<asmb::code_container_ptr>& handlers,
+        const std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>>& handler_calls)
+    {
+        // a handler is entered through the labels bound in front of its first instruction
+        for (const asmb::code_container_ptr& handler : handlers)
+        {
+            for (const asmb::inst_label_v& segment : handler->get_instructions())
+            {
+                if (!std::holds_alternative<asmb::code_label_ptr>(segment))
+                    break;
+
+                handler_entries[std::get<asmb::code_label_ptr>(segment)] = handler;
+            }
+        }
+
+        this->handler_calls.insert(handler_calls.begin(), handler_calls.end());
+    }
+
+    container_cost cost_model::estimate(const asmb::code_container_ptr& container)
+    {
+        if (const auto it = estimates.find(container); it != estimates.end())
+            return it->second;
+
+        // handlers which end up calling themselves are only counted once
+        if (!visiting.insert(container).second)
+            return { };
+
+        container_cost cost = get_local_cost(container);
+        if (const auto it = handler_calls.find(container); it != handler_calls.end())
+        {
+            for (const asmb::code_label_ptr& label : it->second)
+            {
+                cost.handler_calls++;
+                if (const auto entry = handler_entries.find(label); entry != handler_entries.end())
+                    cost.add(estimate(entry->second));
+            }
+        }
+
+        visiting.erase(container);
+        estimates[container] = cost;
+
+        return cost;
+    }
+
+    container_cost cost_model::get_local_cost(const asmb::code_container_ptr& container) const
+    {
+        container_cost cost;
+        for (const asmb::inst_label_v& segment : container->get_instructions())
+        {
+            if (!std::holds_alternative<dynamic_instruction>(segment))
+                continue;
+
+            // only the shape of the instructions matters, so everything is generated as if it was placed at rva 0
+            std::visit([&](auto&& arg)
+            {
+                using T = std::decay_t<decltype(arg)>;
+                if constexpr (std::is_same_v<T, recompile_chunk>)
+                {
+                    std::vector<uint8_t> chunk = arg(0);
+                    for (const dec::inst_info& decode : get_instructions(chunk.data(), chunk.size()))
+                        add_instruction(cost, decode_to_encode(decode));
+                }
+                else if constexpr (std::is_same_v<T, recompile_promise>)
+                {
+                    add_instruction(cost, arg(0));
+                }
+                else
+                {
+                    add_instruction(cost, arg);
+                }
+            }, std::get<dynamic_instruction>(segment));
+        }
+
+        cost.cycles = static_cast<double>(cost.instructions) * weights.instruction +
+            static_cast<double>(cost.memory_ops) * weights.memory_op +
+            static_cast<double>(cost.indirect_jumps) * weights.indirect_jump +
+            static_cast<double>(cost.flags_ops) * weights.flags_op;
+
+        return cost;
+    }
+
+    void cost_model::add_instruction(container_cost& cost, const enc::req& request) const
+    {
+        cost.instructions++;
+
+        const auto target = static_cast<mnemonic>(request.mnemonic);
+        switch (target)
+        {
+            case m_pushfq:
+            case m_popfq:
+                cost.flags_ops++;
+                cost.memory_ops++;
+                return;
+            case m_push:
+            case m_pop:
+            case m_call:
+                cost.memory_ops++;
+                break;
+            case m_ret:
+                cost.memory_ops++;
+                cost.indirect_jumps++;
+                return;
+            default:
+                break;
+        }
+
+        bool memory_operand = false;
+        bool register_operand = false;
+        for (uint8_t i = 0; i < request.operand_count; i++)
+        {
+            memory_operand |= request.operands[i].type == ZYDIS_OPERAND_TYPE_MEMORY;
+            register_operand |= request.operands[i].type == ZYDIS_OPERAND_TYPE_REGISTER;
+        }
+
+        // lea only computes the address
+        if (memory_operand && target != m_lea)
+            cost.memory_ops++;
+
+        if ((target == m_jmp || target == m_call) && (memory_operand || register_operand))
+            cost.indirect_jumps++;
+    }
+}
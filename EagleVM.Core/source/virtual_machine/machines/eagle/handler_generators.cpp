@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <utility>
 #include <ranges>
 
 #include "eaglevm-core/virtual_machine/machines/eagle/handler_manager.h"
 #include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/util/profiler.h"
 #include "eaglevm-core/util/random.h"
 
 #include "eaglevm-core/virtual_machine/ir/x86/base_handler_gen.h"
@@ -25,11 +27,19 @@ namespace eagle::virt::eg
 {
     std::vector<asmb::code_container_ptr> handler_manager::build_handlers()
     {
+        VM_PROFILE_SCOPE("eg.build_handlers");
+
         std::vector<asmb::code_container_ptr> handlers;
 
         handlers.push_back(build_vm_enter());
         handlers.push_back(build_vm_exit());
 
+        // these are only used by calls and rets, vm return has to be built after every block registered its return sites
+        if (vm_exit_call.get_tagged())
+            handlers.push_back(build_vm_exit_call());
+        if (vm_return.get_tagged())
+            handlers.push_back(build_vm_return());
+
         handlers.push_back(build_rflags_load());
         handlers.push_back(build_rflags_store());
 
@@ -37,6 +47,8 @@ namespace eagle::virt::eg
 
         handlers.append_range(build_pop());
         handlers.append_range(build_push());
+        handlers.append_range(build_vm_branch());
+        handlers.append_range(build_string_handlers());
 
         for (auto& container : register_load_handlers | std::views::keys)
             handlers.push_back(container);
@@ -47,6 +59,10 @@ namespace eagle::virt::eg
         for (auto& container : register_store_handlers | std::views::keys)
             handlers.push_back(container);
 
+        // tables go last, every handler has been lifted by now
+        handlers.append_range(build_thread_tables());
+
+        util::profiler::add_counter("eg.handler_containers", handlers.size());
         return handlers;
     }
 
@@ -54,6 +70,7 @@ namespace eagle::virt::eg
     {
         auto [container, label] = vm_enter.get_pair();
         container->bind(label);
+        add_profile_counter(container, label, "vm_enter");
 
         // TODO: this is a temporary fix before i add stack overrun checks
         // we allocate the registers for the virtual machine 20 pushes after the current stack
@@ -75,7 +92,7 @@ namespace eagle::virt::eg
                 {
                     container->add({
                         encode(m_lea, ZREG(rsp), ZMEMBD(rsp, -16, TOB(bit_64))),
-                        encode(m_movq, ZMEMBD(rsp, 0, TOB(bit_128)), ZREG(reg))
+                        encode(m_movdqu, ZMEMBD(rsp, 0, TOB(bit_128)), ZREG(reg))
                     });
                 }
                 else
@@ -141,7 +158,9 @@ namespace eagle::virt::eg
             call_vm_handler(container, std::get<0>(store_register(gpr, target_reg)));
         }
 
-        create_vm_return(container);
+        // the return address was placed on the call stack above, this is the same for every dispatch mode
+        increment_profile_counter(container);
+        create_stack_return(container);
         return container;
     }
 
@@ -149,6 +168,61 @@ namespace eagle::virt::eg
     {
         auto [container, label] = vm_exit.get_pair();
         container->bind(label);
+        add_profile_counter(container, label, "vm_exit");
+
+        create_vm_exit(container, { });
+        return container;
+    }
+
+    asmb::code_container_ptr handler_manager::build_vm_exit_call()
+    {
+        auto [container, label] = vm_exit_call.get_pair();
+        container->bind(label);
+        add_profile_counter(container, label, "vm_exit_call");
+
+        // r10 and r11 are volatile and never carry an argument, the callee cannot expect anything in them
+        // rax stays because __chkstk and the cfg dispatch take their input in it
+        create_vm_exit(container, { r10, r11 });
+        return container;
+    }
+
+    asmb::code_container_ptr handler_manager::build_vm_return()
+    {
+        auto [container, label] = vm_return.get_pair();
+        container->bind(label);
+
+        add_profile_counter(container, label, "vm_return");
+        increment_profile_counter(container);
+
+        const reg return_address = regs->get_reserved_temp(0);
+        for (const auto& [entry, body] : return_sites)
+        {
+            // mov VIP, entry_rva
+            // lea VIP, [VBASE + VIP]
+            // cmp VTEMP, VIP
+            // je body              ; the call came from this vm, skip the vm enter of the return block
+            container->add(RECOMPILE(encode(m_mov, ZREG(VIP), ZLABEL(entry))));
+            container->add(encode(m_lea, ZREG(VIP), ZMEMBI(VBASE, VIP, 1, TOB(bit_64))));
+            container->add(encode(m_cmp, ZREG(return_address), ZREG(VIP)));
+            container->add(RECOMPILE(encode(m_jz, ZJMPR(body))));
+        }
+
+        // the return address belongs to native code or another vm, leave through a regular exit
+        // sub VTEMP, VBASE
+        // mov VCSRET, VTEMP
+        container->add({
+            encode(m_sub, ZREG(return_address), ZREG(VBASE)),
+            encode(m_mov, ZREG(VCSRET), ZREG(return_address)),
+        });
+        add_handler_call(container, get_vm_exit());
+        container->add(RECOMPILE(encode(m_jmp, ZJMPR(get_vm_exit()))));
+
+        return container;
+    }
+
+    void handler_manager::create_vm_exit(const asmb::code_container_ptr& container, const std::vector<reg>& skipped_regs)
+    {
+        increment_profile_counter(container);
 
         reg temp = regs_64_context->get_any();
 
@@ -177,6 +251,9 @@ namespace eagle::virt::eg
 
         for (const auto& gpr : gprs)
         {
+            if (std::ranges::find(skipped_regs, gpr) != skipped_regs.end())
+                continue;
+
             scope_register_manager scope = regs_64_context->create_scope();
             reg target_reg = scope.reserve();
 
@@ -218,14 +295,13 @@ namespace eagle::virt::eg
         // the rsp that we setup earlier before popping all the regs
         container->add(encode(m_pop, ZREG(rsp)));
         container->add(encode(m_jmp, ZMEMBD(rsp, -8, TOB(bit_64))));
-
-        return container;
     }
 
     asmb::code_container_ptr handler_manager::build_rflags_load()
     {
         auto [container, label] = vm_rflags_load.get_pair();
         container->bind(label);
+        add_profile_counter(container, label, "rflags_load");
 
         container->add({
             encode(m_lea, ZREG(rsp), ZMEMBD(rsp, -8, TOB(bit_64))),
@@ -240,6 +316,7 @@ namespace eagle::virt::eg
     {
         auto [container, label] = vm_rflags_store.get_pair();
         container->bind(label);
+        add_profile_counter(container, label, "rflags_store");
 
         container->add({
             encode(m_pushfq),
@@ -257,11 +334,14 @@ namespace eagle::virt::eg
         {
             auto& [container, label] = variant_handler;
             container->bind(label);
+            add_profile_counter(container, label, std::string("push ") + reg_to_string(target_temp));
 
+            // xmm values are pushed whole
             const reg_size reg_size = get_reg_size(target_temp);
+            const mnemonic move = get_reg_class(target_temp) == xmm_128 ? m_movdqu : m_mov;
             container->add({
                 encode(m_lea, ZREG(VSP), ZMEMBD(VSP, -TOB(reg_size), TOB(bit_64))),
-                encode(m_mov, ZMEMBD(VSP, 0, TOB(reg_size)), ZREG(target_temp))
+                encode(move, ZMEMBD(VSP, 0, TOB(reg_size)), ZREG(target_temp))
             });
 
             create_vm_return(container);
@@ -278,10 +358,12 @@ namespace eagle::virt::eg
         {
             auto& [container, label] = variant_handler;
             container->bind(label);
+            add_profile_counter(container, label, std::string("pop ") + reg_to_string(target_temp));
 
             const reg_size reg_size = get_reg_size(target_temp);
+            const mnemonic move = get_reg_class(target_temp) == xmm_128 ? m_movdqu : m_mov;
             container->add({
-                encode(m_mov, ZREG(target_temp), ZMEMBD(VSP, 0, TOB(reg_size))),
+                encode(move, ZREG(target_temp), ZMEMBD(VSP, 0, TOB(reg_size))),
                 encode(m_lea, ZREG(VSP), ZMEMBD(VSP, TOB(reg_size), 8)),
             });
 
@@ -292,6 +374,279 @@ namespace eagle::virt::eg
         return context_stores;
     }
 
+    std::vector<asmb::code_container_ptr> handler_manager::build_vm_branch()
+    {
+        std::vector<asmb::code_container_ptr> branches;
+        for (auto& [condition, variant_handler] : vm_branch)
+        {
+            auto& [container, label] = variant_handler;
+            container->bind(label);
+
+            add_profile_counter(container, label, "vm_branch " + std::to_string(static_cast<int>(condition)));
+            increment_profile_counter(container);
+
+            // VIP is free to use as scratch, it gets overwritten by the jump anyway
+            // the virtual rflags sit right below rsp, same place the rflags handlers use
+            const reg taken = regs->get_reserved_temp(0);
+            const reg fall_through = regs->get_reserved_temp(1);
+            container->add(encode(m_mov, ZREG(VIP), ZMEMBD(rsp, -8, TOB(bit_64))));
+
+            // each condition is reduced to a mask that is tested against VIP
+            // when set is true the branch is taken if any masked bit is set, otherwise if none are
+            uint32_t mask = 0;
+            bool set = true;
+
+            switch (condition)
+            {
+                case ir::exit_condition::jo:
+                    mask = 0x800;
+                    break;
+                case ir::exit_condition::jno:
+                    mask = 0x800;
+                    set = false;
+                    break;
+                case ir::exit_condition::jb:
+                    mask = 0x1;
+                    break;
+                case ir::exit_condition::jnb:
+                    mask = 0x1;
+                    set = false;
+                    break;
+                case ir::exit_condition::jz:
+                    mask = 0x40;
+                    break;
+                case ir::exit_condition::jnz:
+                    mask = 0x40;
+                    set = false;
+                    break;
+                case ir::exit_condition::jbe:
+                    mask = 0x41;
+                    break;
+                case ir::exit_condition::jnbe:
+                    mask = 0x41;
+                    set = false;
+                    break;
+                case ir::exit_condition::js:
+                    mask = 0x80;
+                    break;
+                case ir::exit_condition::jns:
+                    mask = 0x80;
+                    set = false;
+                    break;
+                case ir::exit_condition::jp:
+                    mask = 0x4;
+                    break;
+                case ir::exit_condition::jnp:
+                    mask = 0x4;
+                    set = false;
+                    break;
+                case ir::exit_condition::jl:
+                case ir::exit_condition::jnl:
+                {
+                    // shr VIP, 4            ; OF lands on bit 7
+                    // xor VIP, [rsp - 8]    ; bit 7 = SF ^ OF
+                    container->add({
+                        encode(m_shr, ZREG(VIP), ZIMMS(4)),
+                        encode(m_xor, ZREG(VIP), ZMEMBD(rsp, -8, TOB(bit_64))),
+                    });
+
+                    mask = 0x80;
+                    set = condition == ir::exit_condition::jl;
+                    break;
+                }
+                case ir::exit_condition::jle:
+                case ir::exit_condition::jnle:
+                {
+                    // same as above, then move SF ^ OF onto ZF and merge the real ZF in
+                    container->add({
+                        encode(m_shr, ZREG(VIP), ZIMMS(4)),
+                        encode(m_xor, ZREG(VIP), ZMEMBD(rsp, -8, TOB(bit_64))),
+                        encode(m_and, ZREG(VIP), ZIMMS(0x80)),
+                        encode(m_shr, ZREG(VIP), ZIMMS(1)),
+                        encode(m_or, ZREG(VIP), ZMEMBD(rsp, -8, TOB(bit_64))),
+                    });
+
+                    mask = 0x40;
+                    set = condition == ir::exit_condition::jle;
+                    break;
+                }
+                default:
+                {
+                    VM_ASSERT("condition cannot be evaluated from rflags");
+                    break;
+                }
+            }
+
+            // test VIP, mask
+            // cmovcc taken, fall_through   ; replace the taken rva when the condition fails
+            // lea VIP, [VBASE + taken]
+            // jmp VIP
+            container->add({
+                encode(m_test, ZREG(VIP), ZIMMS(mask)),
+                encode(set ? m_cmovz : m_cmovnz, ZREG(taken), ZREG(fall_through)),
+                encode(m_lea, ZREG(VIP), ZMEMBI(VBASE, taken, 1, TOB(bit_64))),
+                encode(m_jmp, ZREG(VIP)),
+            });
+
+            branches.push_back(container);
+        }
+
+        return branches;
+    }
+
+    std::vector<asmb::code_container_ptr> handler_manager::build_string_handlers()
+    {
+        std::vector<asmb::code_container_ptr> handlers;
+        for (auto& [key, variant_handler] : string_handlers)
+        {
+            const auto [op, size] = key;
+            auto& [container, label] = variant_handler;
+            container->bind(label);
+
+            const std::string op_name = op == ir::string_op::movs ? "movs " : "stos ";
+            add_profile_counter(container, label, op_name + std::to_string(size));
+
+            const reg destination = regs->get_reserved_temp(0);
+            const reg source = regs->get_reserved_temp(1);
+            const reg count = regs->get_reserved_temp(2);
+            const reg chunk = regs->get_reserved_temp_xmm(0);
+
+            // VIP is free to use as scratch, the return overwrites it anyway
+            const reg element = get_bit_version(VIP, size);
+            const int32_t element_bytes = TOB(size);
+            const bool is_movs = op == ir::string_op::movs;
+
+            const asmb::code_label_ptr chunk_loop = asmb::code_label::create("string chunk");
+            const asmb::code_label_ptr forward_loop = asmb::code_label::create("string forward");
+            const asmb::code_label_ptr backward_loop = asmb::code_label::create("string backward");
+            const asmb::code_label_ptr done = asmb::code_label::create("string done");
+
+            // test [rsp - 8], df   ; the guest direction flag lives in the virtual rflags
+            // jnz backward_loop    ; backwards copies are rare, they go one element at a time
+            container->add(encode(m_test, ZMEMBD(rsp, -8, TOB(bit_64)), ZIMMS(0x400)));
+            container->add(RECOMPILE(encode(m_jnz, ZJMPR(backward_loop))));
+
+            if (is_movs)
+            {
+                // mov VIP, destination
+                // sub VIP, source
+                // cmp VIP, 16
+                // jb forward_loop      ; a destination less than a chunk after the source reads its own writes
+                container->add({
+                    encode(m_mov, ZREG(VIP), ZREG(destination)),
+                    encode(m_sub, ZREG(VIP), ZREG(source)),
+                    encode(m_cmp, ZREG(VIP), ZIMMS(16)),
+                });
+                container->add(RECOMPILE(encode(m_jb, ZJMPR(forward_loop))));
+            }
+            else
+            {
+                // broadcast the stored value to every lane of the chunk
+                container->add(encode(m_movq, ZREG(chunk), ZREG(source)));
+                switch (size)
+                {
+                    case bit_8:
+                        container->add(encode(m_punpcklbw, ZREG(chunk), ZREG(chunk)));
+                        [[fallthrough]];
+                    case bit_16:
+                        container->add({
+                            encode(m_pshuflw, ZREG(chunk), ZREG(chunk), ZIMMS(0)),
+                            encode(m_punpcklqdq, ZREG(chunk), ZREG(chunk)),
+                        });
+                        break;
+                    case bit_32:
+                        container->add(encode(m_pshufd, ZREG(chunk), ZREG(chunk), ZIMMS(0)));
+                        break;
+                    default:
+                        container->add(encode(m_punpcklqdq, ZREG(chunk), ZREG(chunk)));
+                        break;
+                }
+            }
+
+            // moves 16 or 8 bytes at once through the chunk register while enough elements are left
+            auto add_chunk_step = [&](const int32_t chunk_bytes, const asmb::code_label_ptr& next)
+            {
+                const int32_t chunk_elements = chunk_bytes / element_bytes;
+                const mnemonic chunk_mov = chunk_bytes == 16 ? m_movdqu : m_movq;
+
+                // cmp count, chunk_elements
+                // jb next
+                container->add(encode(m_cmp, ZREG(count), ZIMMS(chunk_elements)));
+                container->add(RECOMPILE(encode(m_jb, ZJMPR(next))));
+
+                if (is_movs)
+                    container->add(encode(chunk_mov, ZREG(chunk), ZMEMBD(source, 0, chunk_bytes)));
+
+                container->add({
+                    encode(chunk_mov, ZMEMBD(destination, 0, chunk_bytes), ZREG(chunk)),
+                    encode(m_lea, ZREG(destination), ZMEMBD(destination, chunk_bytes, TOB(bit_64))),
+                    encode(m_lea, ZREG(count), ZMEMBD(count, -chunk_elements, TOB(bit_64))),
+                });
+
+                if (is_movs)
+                    container->add(encode(m_lea, ZREG(source), ZMEMBD(source, chunk_bytes, TOB(bit_64))));
+            };
+
+            container->bind(chunk_loop);
+            if (element_bytes < 8)
+            {
+                // after the 16 byte loop there is at most one 8 byte chunk left
+                const asmb::code_label_ptr half_chunk = asmb::code_label::create("string half chunk");
+
+                add_chunk_step(16, half_chunk);
+                container->add(RECOMPILE(encode(m_jmp, ZJMPR(chunk_loop))));
+
+                container->bind(half_chunk);
+                add_chunk_step(8, forward_loop);
+            }
+            else
+            {
+                add_chunk_step(16, forward_loop);
+                container->add(RECOMPILE(encode(m_jmp, ZJMPR(chunk_loop))));
+            }
+
+            // whatever is left goes one element at a time
+            auto add_element_loop = [&](const asmb::code_label_ptr& loop, const int32_t step)
+            {
+                container->bind(loop);
+
+                // test count, count
+                // jz done
+                container->add(encode(m_test, ZREG(count), ZREG(count)));
+                container->add(RECOMPILE(encode(m_jz, ZJMPR(done))));
+
+                if (is_movs)
+                {
+                    container->add({
+                        encode(m_mov, ZREG(element), ZMEMBD(source, 0, element_bytes)),
+                        encode(m_mov, ZMEMBD(destination, 0, element_bytes), ZREG(element)),
+                        encode(m_lea, ZREG(source), ZMEMBD(source, step, TOB(bit_64))),
+                    });
+                }
+                else
+                {
+                    container->add(encode(m_mov, ZMEMBD(destination, 0, element_bytes), ZREG(get_bit_version(source, size))));
+                }
+
+                container->add({
+                    encode(m_lea, ZREG(destination), ZMEMBD(destination, step, TOB(bit_64))),
+                    encode(m_lea, ZREG(count), ZMEMBD(count, -1, TOB(bit_64))),
+                });
+                container->add(RECOMPILE(encode(m_jmp, ZJMPR(loop))));
+            };
+
+            add_element_loop(forward_loop, element_bytes);
+            add_element_loop(backward_loop, -element_bytes);
+
+            container->bind(done);
+            create_vm_return(container);
+
+            handlers.push_back(container);
+        }
+
+        return handlers;
+    }
+
     std::vector<asmb::code_container_ptr> handler_manager::build_instruction_handlers()
     {
         std::vector<asmb::code_container_ptr> container;
@@ -306,14 +661,69 @@ namespace eagle::virt::eg
             ir::block_ptr ir_block = std::make_shared<ir::block_ir>();
             ir_block->add_command(handler_ir);
 
+            // calls made by the handler body have to keep the cursor of the caller
+            building_nested_handler = true;
+
             const std::shared_ptr<machine> machine = machine_inst.lock();
             const asmb::code_container_ptr handler = machine->lift_block(ir_block);
             handler->bind_start(label);
 
+            building_nested_handler = false;
+
+            add_profile_counter(handler, label, std::string(mnemonic_to_string(mnemonic)) + " " + handler_id);
+
             create_vm_return(handler);
             container.push_back(handler);
         }
 
         return container;
     }
+
+    asmb::code_container_ptr handler_manager::build_profile_counters() const
+    {
+        if (profile_counters.empty())
+            return nullptr;
+
+        const asmb::code_container_ptr container = asmb::code_container::create("profile counters " + std::to_string(profile_counters.size()));
+        for (const profile_counter& counter : profile_counters)
+        {
+            container->bind(counter.counter);
+            container->add(RECOMPILE_CHUNK([](uint64_t)
+            {
+                return std::vector<uint8_t>(8, 0);
+            }));
+        }
+
+        return container;
+    }
+
+    std::vector<asmb::code_container_ptr> handler_manager::build_thread_tables() const
+    {
+        std::vector<asmb::code_container_ptr> containers;
+        for (const thread_table_ptr& table : thread_table_order)
+        {
+            const asmb::code_container_ptr container = asmb::code_container::create("thread table " + std::to_string(table->entries.size()));
+            container->bind(table->label);
+
+            // each entry is the rva of a continuation, handlers add VBASE themselves
+            container->add(RECOMPILE_CHUNK([table](uint64_t)
+            {
+                std::vector<uint8_t> data;
+                data.reserve(table->entries.size() * 8);
+
+                for (const asmb::code_label_ptr& entry : table->entries)
+                {
+                    const uint64_t rva = entry->get_relative_address();
+                    for (int i = 0; i < 8; i++)
+                        data.push_back(static_cast<uint8_t>(rva >> i * 8));
+                }
+
+                return data;
+            }));
+
+            containers.push_back(container);
+        }
+
+        return containers;
+    }
 }
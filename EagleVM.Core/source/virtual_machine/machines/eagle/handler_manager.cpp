@@ -60,6 +60,7 @@ namespace eagle::virt::eg
         out->bind(label);
 
         register_load_handlers.push_back(handler);
+        add_profile_counter(out, label, std::string("load ") + reg_to_string(register_to_load));
 
         const reg target_register = load_destination;
 
@@ -94,6 +95,7 @@ namespace eagle::virt::eg
         out->bind(label);
 
         register_load_handlers.push_back(handler);
+        add_profile_counter(out, label, std::string("load_complex ") + reg_to_string(register_to_load));
 
         // find the mapped ranges required to build the register that we want
         // shuffle the ranges because we will rebuild it at random
@@ -298,6 +300,7 @@ namespace eagle::virt::eg
         out->bind(label);
 
         register_store_handlers.push_back(handler);
+        add_profile_counter(out, label, std::string("store ") + reg_to_string(register_to_store_into));
 
         // find the mapped ranges required to build the register that we want
         // shuffle the ranges because we will rebuild it at random
@@ -332,6 +335,7 @@ namespace eagle::virt::eg
         out->bind(label);
 
         register_store_handlers.push_back(handler);
+        add_profile_counter(out, label, std::string("store_complex ") + reg_to_string(register_to_store_into));
 
         // find the mapped ranges required to build the register that we want
         // shuffle the ranges because we will rebuild it at random
@@ -632,6 +636,7 @@ namespace eagle::virt::eg
         out->bind(label);
 
         complex_resolve_handlers.push_back(handler);
+        add_profile_counter(out, label, "resolve_complex");
 
         std::vector<std::pair<reg_range, reg_range>> mappings = load_info.complex_mapping;
         // std::ranges::shuffle(mappings, util::get_ran_device().gen);
@@ -720,7 +725,7 @@ namespace eagle::virt::eg
         VM_ASSERT(mnemonic != m_pop, "pop retreival through get_instruction_handler is blocked. use get_pop");
         VM_ASSERT(mnemonic != m_push, "push retreival through get_instruction_handler is blocked. use get_push");
 
-        const std::tuple key = std::tie(mnemonic, handler_sig);
+        const std::pair key(mnemonic, handler_sig);
         for (const auto& [tuple, code_label] : tagged_instruction_handlers)
             if (tuple == key)
                 return code_label;
@@ -740,9 +745,36 @@ namespace eagle::virt::eg
         return get_instruction_handler(mnemonic, signature);
     }
 
-    void handler_manager::call_vm_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label) const
+    void handler_manager::call_vm_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label)
     {
         VM_ASSERT(label != nullptr, "code cannot be an invalid code label");
+        add_handler_call(container, label);
+
+        if (settings->threaded_dispatch)
+            call_threaded_handler(container, label);
+        else
+            call_stack_handler(container, label);
+    }
+
+    void handler_manager::add_handler_call(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label)
+    {
+        // most handlers are only built after every call to them was lifted, so calls are kept by label
+        handler_calls[container].push_back(label);
+    }
+
+    const std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>>& handler_manager::get_handler_calls() const
+    {
+        return handler_calls;
+    }
+
+    void handler_manager::invalidate_dispatch_cursor(const asmb::code_container_ptr& container) const
+    {
+        if (const auto it = thread_tables.find(container); it != thread_tables.end())
+            it->second->cursor_valid = false;
+    }
+
+    void handler_manager::call_stack_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label) const
+    {
         const asmb::code_label_ptr return_label = asmb::code_label::create("caller return");
         const asmb::code_label_ptr begin_label = asmb::code_label::create("caller " + label->get_name());
 
@@ -763,6 +795,65 @@ namespace eagle::virt::eg
         container->bind(return_label);
     }
 
+    void handler_manager::call_threaded_handler(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label)
+    {
+        const thread_table_ptr table = get_thread_table(container);
+
+        // nothing was emitted since the previous handler returned, so that handler can go straight into this one
+        if (table->cursor_valid && !table->entries.empty() && container->get_segment_count() == table->last_return_segment)
+            table->entries.back() = label;
+
+        const asmb::code_label_ptr return_label = asmb::code_label::create("caller return");
+        const asmb::code_label_ptr begin_label = asmb::code_label::create("caller " + label->get_name());
+
+        container->bind(begin_label);
+        if (!table->cursor_valid)
+        {
+            if (table->nested && !table->cursor_saved)
+            {
+                // lea VCS, [VCS - 8]       ; keep the cursor of whoever called this handler
+                // mov [VCS], VCSRET
+                container->add(encode(m_lea, ZREG(VCS), ZMEMBD(VCS, -8, TOB(bit_64))));
+                container->add(encode(m_mov, ZMEMBD(VCS, 0, TOB(bit_64)), ZREG(VCSRET)));
+                table->cursor_saved = true;
+            }
+
+            // lea VCSRET, [VBASE + table + entry]  ; point the cursor at the entry for this call
+            const asmb::code_label_ptr table_label = table->label;
+            const int64_t entry_offset = 8 * static_cast<int64_t>(table->entries.size());
+            container->add(RECOMPILE(encode(m_lea, ZREG(VCSRET), ZMEMBD(VBASE, table_label->get_relative_address() + entry_offset, TOB(bit_64)))));
+
+            table->cursor_valid = true;
+        }
+
+        // lea VIP, [VBASE + rva]
+        // jmp VIP
+        container->add(RECOMPILE(encode(m_mov, ZREG(VIP), ZIMMS(label->get_relative_address()))));
+        container->add(RECOMPILE(encode(m_lea, ZREG(VIP), ZMEMBI(VBASE, VIP, 1, TOB(bit_64)))));
+        container->add(encode(m_jmp, ZREG(VIP)));
+
+        // the handler reads this from the table when it returns
+        container->bind(return_label);
+
+        table->entries.push_back(return_label);
+        table->last_return_segment = container->get_segment_count();
+    }
+
+    thread_table_ptr handler_manager::get_thread_table(const asmb::code_container_ptr& container)
+    {
+        if (const auto it = thread_tables.find(container); it != thread_tables.end())
+            return it->second;
+
+        thread_table_ptr table = std::make_shared<thread_table>();
+        table->label = asmb::code_label::create("thread table");
+        table->nested = building_nested_handler;
+
+        thread_tables[container] = table;
+        thread_table_order.push_back(table);
+
+        return table;
+    }
+
     asmb::code_label_ptr handler_manager::get_vm_enter()
     {
         vm_enter.tag();
@@ -775,6 +866,23 @@ namespace eagle::virt::eg
         return vm_exit.get_label();
     }
 
+    asmb::code_label_ptr handler_manager::get_vm_exit_call()
+    {
+        vm_exit_call.tag();
+        return vm_exit_call.get_label();
+    }
+
+    asmb::code_label_ptr handler_manager::get_vm_return()
+    {
+        vm_return.tag();
+        return vm_return.get_label();
+    }
+
+    void handler_manager::add_return_site(const asmb::code_label_ptr& entry, const asmb::code_label_ptr& body)
+    {
+        return_sites.emplace_back(entry, body);
+    }
+
     asmb::code_label_ptr handler_manager::get_rlfags_load()
     {
         vm_rflags_load.tag();
@@ -787,6 +895,30 @@ namespace eagle::virt::eg
         return vm_rflags_store.get_label();
     }
 
+    asmb::code_label_ptr handler_manager::get_string_handler(const ir::string_op op, const reg_size size)
+    {
+        const std::pair key(op, size);
+        if (!string_handlers.contains(key))
+            string_handlers[key] = { asmb::code_container::create(), asmb::code_label::create() };
+
+        return std::get<1>(string_handlers[key]);
+    }
+
+    asmb::code_label_ptr handler_manager::get_vm_branch(const ir::exit_condition condition)
+    {
+        if (!vm_branch.contains(condition))
+            vm_branch[condition] = { asmb::code_container::create(), asmb::code_label::create() };
+
+        return std::get<1>(vm_branch[condition]);
+    }
+
+    int32_t handler_manager::get_context_displacement(const reg target_reg) const
+    {
+        // rsp was placed right after the saved rflags in vm enter
+        const auto [disp, _] = regs->get_stack_displacement(target_reg);
+        return static_cast<int32_t>(disp) - 8 * vm_stack_regs;
+    }
+
     reg handler_manager::get_push_working_register() const
     {
         VM_ASSERT(!settings->randomize_working_register, "can only return a working register if randomization is disabled");
@@ -827,6 +959,84 @@ namespace eagle::virt::eg
     }
 
     void handler_manager::create_vm_return(const asmb::code_container_ptr& container) const
+    {
+        // VIP gets overwritten by the return either way
+        increment_profile_counter(container);
+
+        if (!settings->threaded_dispatch)
+        {
+            create_stack_return(container);
+            return;
+        }
+
+        if (const auto it = thread_tables.find(container); it != thread_tables.end() && it->second->cursor_saved)
+        {
+            // mov VCSRET, [VCS]        ; restore the cursor of whoever called this handler
+            // lea VCS, [VCS + 8]
+            container->add(encode(m_mov, ZREG(VCSRET), ZMEMBD(VCS, 0, TOB(bit_64))));
+            container->add(encode(m_lea, ZREG(VCS), ZMEMBD(VCS, 8, TOB(bit_64))));
+        }
+
+        // mov VIP, [VCSRET]            ; read the next entry from the callers table
+        // lea VCSRET, [VCSRET + 8]     ; move the cursor forward
+        container->add(encode(m_mov, ZREG(VIP), ZMEMBD(VCSRET, 0, TOB(bit_64))));
+        container->add(encode(m_lea, ZREG(VCSRET), ZMEMBD(VCSRET, 8, TOB(bit_64))));
+
+        // lea VIP, [VBASE + VIP]  ; add rva to base
+        // jmp VIP
+        container->add(encode(m_lea, ZREG(VIP), ZMEMBI(VBASE, VIP, 1, TOB(bit_64))));
+        container->add(encode(m_jmp, ZREG(VIP)));
+    }
+
+    void handler_manager::add_profile_counter(const asmb::code_container_ptr& container, const asmb::code_label_ptr& label,
+        const std::string& name)
+    {
+        if (!settings->profile_handlers)
+            return;
+
+        VM_ASSERT(!profiled_containers.contains(container), "handler already has a profile counter");
+
+        profiled_containers[container] = profile_counters.size();
+        profile_counters.push_back({ name, label, asmb::code_label::create("profile counter " + name), { } });
+    }
+
+    void handler_manager::increment_profile_counter(const asmb::code_container_ptr& container) const
+    {
+        const auto it = profiled_containers.find(container);
+        if (it == profiled_containers.end())
+            return;
+
+        // mov VIP, [VBASE + counter]
+        // lea VIP, [VIP + 1]           ; lea leaves rflags alone, the next handler may still need them
+        // mov [VBASE + counter], VIP
+        const asmb::code_label_ptr counter = profile_counters[it->second].counter;
+        container->add(RECOMPILE(encode(m_mov, ZREG(VIP), ZMEMBD(VBASE, counter->get_relative_address(), TOB(bit_64)))));
+        container->add(encode(m_lea, ZREG(VIP), ZMEMBD(VIP, 1, TOB(bit_64))));
+        container->add(RECOMPILE(encode(m_mov, ZMEMBD(VBASE, counter->get_relative_address(), TOB(bit_64)), ZREG(VIP))));
+    }
+
+    std::vector<profile_counter> handler_manager::get_profile_counters() const
+    {
+        std::unordered_map<asmb::code_label_ptr, std::vector<asmb::code_container_ptr>> callers;
+        for (const auto& [container, labels] : handler_calls)
+        {
+            for (const asmb::code_label_ptr& label : labels)
+            {
+                std::vector<asmb::code_container_ptr>& label_callers = callers[label];
+                if (std::ranges::find(label_callers, container) == label_callers.end())
+                    label_callers.push_back(container);
+            }
+        }
+
+        std::vector<profile_counter> counters = profile_counters;
+        for (profile_counter& counter : counters)
+            if (const auto it = callers.find(counter.handler); it != callers.end())
+                counter.callers = it->second;
+
+        return counters;
+    }
+
+    void handler_manager::create_stack_return(const asmb::code_container_ptr& container) const
     {
         // mov VCSRET, [VCS]        ; pop from call stack
         // lea VCS, [VCS + 8]       ; move up the call stack pointer
@@ -9,6 +9,8 @@
 
 #include "eaglevm-core/virtual_machine/machines/util.h"
 
+#include "eaglevm-core/util/profiler.h"
+
 #define VIP         reg_man->get_vm_reg(register_manager::index_vip)
 #define VSP         reg_man->get_vm_reg(register_manager::index_vsp)
 #define VREGS       reg_man->get_vm_reg(register_manager::index_vregs)
@@ -38,11 +40,13 @@ namespace eagle::virt::eg
 
         const std::shared_ptr<register_context> reg_ctx_64 = std::make_shared<register_context>(reg_man->get_unreserved_temp(), gpr_64);
         const std::shared_ptr<register_context> reg_ctx_128 = std::make_shared<register_context>(reg_man->get_unreserved_temp_xmm(), xmm_128);
+        const std::shared_ptr<register_context> reg_ctx_cache = std::make_shared<register_context>(reg_man->get_cache_temp(), gpr_64);
         const std::shared_ptr<handler_manager> han_man = std::make_shared<handler_manager>(instance, reg_man, reg_ctx_64, reg_ctx_128, settings_info);
 
         instance->reg_man = reg_man;
         instance->reg_64_container = reg_ctx_64;
         instance->reg_128_container = reg_ctx_128;
+        instance->reg_cache_container = reg_ctx_cache;
         instance->han_man = han_man;
 
         return instance;
@@ -50,7 +54,10 @@ namespace eagle::virt::eg
 
     asmb::code_container_ptr machine::lift_block(const ir::block_ptr& block)
     {
+        VM_PROFILE_SCOPE("eg.lift_block");
+
         const size_t command_count = block->get_command_count();
+        util::profiler::add_counter("eg.commands_lifted", command_count);
 
         const asmb::code_container_ptr code = asmb::code_container::create("block_begin " + std::to_string(command_count), true);
         if (block_context.contains(block))
@@ -67,6 +74,7 @@ namespace eagle::virt::eg
 
         reg_64_container->reset();
         reg_128_container->reset();
+        reg_cache_container->reset();
 
         return code;
     }
@@ -76,11 +84,29 @@ namespace eagle::virt::eg
         // we want to load this register onto the stack
         const reg load_reg = cmd->get_reg();
 
+        // cached loads are kept alive in a register that handlers will never touch
+        const ir::discrete_store_ptr cache = cmd->get_cache();
+        const register_context_ptr& store_ctx = cache ? reg_cache_container : reg_64_container;
+
+        if (get_reg_class(load_reg) == xmm_128)
+        {
+            // guest xmm registers are never scattered, they stay in their vm enter slot until vm exit
+            const ir::discrete_store_ptr dest = ir::discrete_store::create(ir::ir_size::bit_128);
+            reg_128_container->assign(dest);
+
+            block->add(encode(m_movdqu, ZREG(dest->get_store_register()),
+                ZMEMBD(rsp, han_man->get_context_displacement(load_reg), TOB(bit_128))));
+
+            call_push(block, dest);
+            reg_128_container->release(dest);
+            return;
+        }
+
         ir::discrete_store_ptr dest = nullptr;
         if (get_reg_class(load_reg) == seg)
         {
-            dest = ir::discrete_store::create(ir::ir_size::bit_64);
-            reg_64_container->assign(dest);
+            dest = cache ? cache : ir::discrete_store::create(ir::ir_size::bit_64);
+            store_ctx->assign(dest);
 
             block->add(encode(m_mov, ZREG(dest->get_store_register()), ZREG(load_reg)));
         }
@@ -88,8 +114,8 @@ namespace eagle::virt::eg
         {
             const reg_size load_reg_size = get_reg_size(load_reg);
 
-            dest = ir::discrete_store::create(to_ir_size(load_reg_size));
-            reg_64_container->assign(dest);
+            dest = cache ? cache : ir::discrete_store::create(to_ir_size(load_reg_size));
+            store_ctx->assign(dest);
 
             // load into storage
             if (settings->complex_temp_loading)
@@ -118,7 +144,8 @@ namespace eagle::virt::eg
 
         // push target_reg
         call_push(block, dest);
-        reg_64_container->release(dest);
+        if (!cache)
+            reg_64_container->release(dest);
     }
 
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_context_store_ptr& cmd)
@@ -128,8 +155,26 @@ namespace eagle::virt::eg
         auto r_size = get_reg_size(target_reg);
         auto v_size = cmd->get_value_size();
 
-        const ir::discrete_store_ptr storage = ir::discrete_store::create(to_ir_size(r_size));
-        reg_64_container->assign(storage);
+        if (get_reg_class(target_reg) == xmm_128)
+        {
+            VM_ASSERT(v_size == bit_128, "xmm registers can only be stored whole");
+
+            const ir::discrete_store_ptr storage = ir::discrete_store::create(ir::ir_size::bit_128);
+            reg_128_container->assign(storage);
+
+            call_pop(block, storage);
+            block->add(encode(m_movdqu, ZMEMBD(rsp, han_man->get_context_displacement(target_reg), TOB(bit_128)),
+                ZREG(storage->get_store_register())));
+
+            reg_128_container->release(storage);
+            return;
+        }
+
+        const ir::discrete_store_ptr cache = cmd->get_cache();
+        const register_context_ptr& store_ctx = cache ? reg_cache_container : reg_64_container;
+
+        const ir::discrete_store_ptr storage = cache ? cache : ir::discrete_store::create(to_ir_size(r_size));
+        store_ctx->assign(storage);
 
         // pop into storage
         call_pop(block, storage, v_size);
@@ -140,7 +185,8 @@ namespace eagle::virt::eg
             block->add(encode(m_mov, ZREG(storage->get_store_register()), ZREG(working_reg)));
 
         han_man->call_vm_handler(block, handler);
-        reg_64_container->release(storage);
+        if (!cache)
+            reg_64_container->release(storage);
     }
 
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_branch_ptr& cmd)
@@ -184,6 +230,13 @@ namespace eagle::virt::eg
             }
             default:
             {
+                if (cmd->is_virtual())
+                {
+                    // the native rflags do not hold the guest flags inside the vm
+                    handle_virtual_branch(block, cmd);
+                    break;
+                }
+
                 // conditional
                 const ir::il_exit_result conditional_jump = cmd->get_condition_special();
                 write_jump(conditional_jump, to_jump_mnemonic(cmd->get_condition()));
@@ -194,6 +247,58 @@ namespace eagle::virt::eg
         }
     }
 
+    void machine::handle_virtual_branch(const asmb::code_container_ptr& block, const ir::cmd_branch_ptr& cmd)
+    {
+        auto get_target_label = [&](const ir::il_exit_result& exit_result)
+        {
+            VM_ASSERT(std::holds_alternative<ir::block_ptr>(exit_result), "virtual branch cannot exit to an rva");
+
+            const asmb::code_label_ptr label = get_block_label(std::get<ir::block_ptr>(exit_result));
+            VM_ASSERT(label != nullptr, "block contains missing context");
+
+            return label;
+        };
+
+        const asmb::code_label_ptr taken = get_target_label(cmd->get_condition_special());
+        const asmb::code_label_ptr fall_through = get_target_label(cmd->get_condition_default());
+
+        const ir::exit_condition condition = cmd->get_condition();
+        if (condition == ir::exit_condition::jcxz || condition == ir::exit_condition::jecxz || condition == ir::exit_condition::jrcxz)
+        {
+            // these only look at rcx, we load it ourselves and the native flags are ours to use
+            const reg count_reg = condition == ir::exit_condition::jcxz ? cx : condition == ir::exit_condition::jecxz ? ecx : rcx;
+
+            const ir::discrete_store_ptr storage = ir::discrete_store::create(ir::ir_size::bit_64);
+            reg_64_container->assign(storage);
+
+            const reg storage_reg = storage->get_store_register();
+            auto [handler_load, _] = han_man->load_register(count_reg, storage);
+
+            block->add(encode(m_xor, ZREG(storage_reg), ZREG(storage_reg)));
+            han_man->call_vm_handler(block, handler_load);
+            block->add(encode(m_test, ZREG(storage_reg), ZREG(storage_reg)));
+
+            reg_64_container->release(storage);
+
+            block->add(RECOMPILE(encode(m_jz, ZJMPR(taken))));
+            block->add(RECOMPILE(encode(m_jmp, ZJMPR(fall_through))));
+            return;
+        }
+
+        // mov VTEMP, taken_rva
+        // mov VTEMP2, fall_through_rva
+        // jmp branch handler   ; picks one of the two from the virtual rflags
+        const asmb::code_label_ptr branch_handler = han_man->get_vm_branch(condition);
+        han_man->add_handler_call(block, branch_handler);
+
+        block->add(RECOMPILE(encode(m_mov, ZREG(VTEMP), ZLABEL(taken))));
+        block->add(RECOMPILE(encode(m_mov, ZREG(VTEMP2), ZLABEL(fall_through))));
+
+        block->add(RECOMPILE(encode(m_mov, ZREG(VIP), ZIMMS(branch_handler->get_relative_address()))));
+        block->add(RECOMPILE(encode(m_lea, ZREG(VIP), ZMEMBI(VBASE, VIP, 1, TOB(bit_64)))));
+        block->add(encode(m_jmp, ZREG(VIP)));
+    }
+
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_handler_call_ptr& cmd)
     {
         if (cmd->is_operand_sig())
@@ -214,11 +319,23 @@ namespace eagle::virt::eg
 
         scope_register_manager scope = reg_64_container->create_scope();
         reg temp = scope.reserve();
-        reg target_temp = get_bit_version(temp, static_cast<reg_size>(target_size));
 
         // pop address
         call_pop(block, temp);
 
+        if (target_size == ir::ir_size::bit_128)
+        {
+            scope_register_manager scope_128 = reg_128_container->create_scope();
+            const reg temp_xmm = scope_128.reserve();
+
+            // movdqu temp_xmm, [address]
+            block->add(encode(m_movdqu, ZREG(temp_xmm), ZMEMBD(temp, 0, TOB(target_size))));
+            call_push(block, temp_xmm);
+            return;
+        }
+
+        reg target_temp = get_bit_version(temp, static_cast<reg_size>(target_size));
+
         // mov temp, [address]
         block->add(encode(m_mov, ZREG(target_temp), ZMEMBD(target_temp, 0, TOB(target_size))));
 
@@ -234,7 +351,11 @@ namespace eagle::virt::eg
         scope_register_manager scope = reg_64_container->create_scope();
         const std::vector<reg> temps = scope.reserve_multiple(2);
 
-        const reg temp_value = get_bit_version(temps[0], to_reg_size(value_size));
+        // xmm values get written with the move matching the width of the write
+        scope_register_manager scope_128 = reg_128_container->create_scope();
+        const bool is_xmm = value_size == ir::ir_size::bit_128;
+
+        const reg temp_value = is_xmm ? scope_128.reserve() : get_bit_version(temps[0], to_reg_size(value_size));
         const reg temp_address = temps[1];
 
         if (cmd->get_is_value_nearest())
@@ -248,6 +369,20 @@ namespace eagle::virt::eg
             call_pop(block, temp_value);
         }
 
+        if (is_xmm)
+        {
+            mnemonic move = m_movdqu;
+            if (write_size == ir::ir_size::bit_64)
+                move = m_movq;
+            else if (write_size == ir::ir_size::bit_32)
+                move = m_movd;
+            else
+                VM_ASSERT(write_size == ir::ir_size::bit_128, "xmm values can only be written as 32, 64 or 128 bits");
+
+            block->add(encode(move, ZMEMBD(temp_address, 0, TOB(write_size)), ZREG(temp_value)));
+            return;
+        }
+
         block->add(encode(m_mov, ZMEMBD(temp_address, 0, TOB(write_size)), ZREG(temp_value)));
     }
 
@@ -255,9 +390,14 @@ namespace eagle::virt::eg
     {
         if (const ir::discrete_store_ptr store = cmd->get_destination_reg())
         {
-            reg_64_container->assign(store);
+            get_store_container(store)->assign(store);
             call_pop(block, store);
         }
+        else if (cmd->get_size() == ir::ir_size::bit_128)
+        {
+            scope_register_manager scope = reg_128_container->create_scope();
+            call_pop(block, scope.reserve());
+        }
         else
         {
             scope_register_manager scope = reg_64_container->create_scope();
@@ -281,7 +421,7 @@ namespace eagle::virt::eg
             case ir::info_type::vm_temp_register:
             {
                 const ir::discrete_store_ptr store = cmd->get_value_temp_register();
-                reg_64_container->assign(store);
+                get_store_container(store)->assign(store);
 
                 call_push(block, store);
                 break;
@@ -390,6 +530,7 @@ namespace eagle::virt::eg
     {
         const asmb::code_label_ptr vm_enter = han_man->get_vm_enter();
         const asmb::code_label_ptr ret = asmb::code_label::create("vmenter_ret target");
+        han_man->add_handler_call(block, vm_enter);
 
         block->add(RECOMPILE(encode(m_push, ZLABEL(ret))));
         if (settings->relative_addressing)
@@ -416,17 +557,24 @@ namespace eagle::virt::eg
         }
 
         block->bind(ret);
+
+        // vm enter dispatches its own handlers, whatever cursor we had is gone
+        han_man->invalidate_dispatch_cursor(block);
     }
 
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_vm_exit_ptr& cmd)
     {
         const asmb::code_label_ptr vm_exit = han_man->get_vm_exit();
         const asmb::code_label_ptr ret = asmb::code_label::create("vmexit_ret target");
+        han_man->add_handler_call(block, vm_exit);
 
         // mov VCSRET, ZLABEL(target)
         block->add(RECOMPILE(encode(m_mov, ZREG(VCSRET), ZLABEL(ret))));
         block->add(RECOMPILE(encode(m_jmp, ZJMPR(vm_exit))));
         block->bind(ret);
+
+        // the cursor shares VCSRET with the exit address
+        han_man->invalidate_dispatch_cursor(block);
     }
 
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_x86_dynamic_ptr& cmd)
@@ -442,7 +590,7 @@ namespace eagle::virt::eg
                 if constexpr (std::is_same_v<std::decay_t<reg_type>, ir::discrete_store_ptr>)
                 {
                     const ir::discrete_store_ptr& store = arg;
-                    reg_64_container->assign(store);
+                    get_store_container(store)->assign(store);
                 }
             }, op);
 
@@ -454,9 +602,41 @@ namespace eagle::virt::eg
                     const ir::discrete_store_ptr& store = arg;
                     add_op(request, ZREG(get_bit_version(store->get_store_register(), to_reg_size(store->get_store_size()))));
                 }
+                else if constexpr (std::is_same_v<T, uint64_t>)
+                {
+                    add_op(request, ZIMMS(static_cast<int64_t>(arg)));
+                }
             }, op);
         }
 
+        // implicit operands like rdx:rax have to be swapped into place around the instruction
+        if (const auto implicit = cmd->get_implicit(); !implicit.empty())
+        {
+            std::vector<std::pair<reg, reg>> bindings;
+            for (const auto& [target, store] : implicit)
+            {
+                get_store_container(store)->assign(store);
+                bindings.emplace_back(get_bit_version(target, gpr_64), get_bit_version(store->get_store_register(), gpr_64));
+            }
+
+            for (const enc::req& implicit_request : encode_implicit(request, bindings))
+                block->add(implicit_request);
+
+            return;
+        }
+
+        // the count of a shift or rotate has to be in cl, our temps are wherever the allocator put them
+        if (is_cl_count_mnemonic(mnemonic) && request.operand_count == 2 && std::holds_alternative<ir::discrete_store_ptr>(operands[1]))
+        {
+            const reg value_reg = static_cast<reg>(request.operands[0].reg.value);
+            const reg count_reg = static_cast<reg>(request.operands[1].reg.value);
+
+            for (const enc::req& cl_request : encode_cl_count(mnemonic, value_reg, count_reg))
+                block->add(cl_request);
+
+            return;
+        }
+
         block->add(request);
     }
 
@@ -465,16 +645,237 @@ namespace eagle::virt::eg
         block->add(cmd->get_request());
     }
 
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_native_island_ptr& cmd)
+    {
+        const std::vector<reg> registers = cmd->get_registers();
+
+        // write the registers the instruction touches into their context slots, the same place vm exit would put them
+        for (const reg target_reg : registers)
+        {
+            const ir::discrete_store_ptr storage = ir::discrete_store::create(ir::ir_size::bit_64);
+            reg_64_container->assign(storage);
+
+            const reg storage_reg = storage->get_store_register();
+            auto [handler_load, _] = han_man->load_register(target_reg, storage);
+
+            block->add(encode(m_xor, ZREG(storage_reg), ZREG(storage_reg)));
+            han_man->call_vm_handler(block, handler_load);
+            block->add(encode(m_mov, ZMEMBD(rsp, han_man->get_context_displacement(target_reg), 8), ZREG(storage_reg)));
+
+            reg_64_container->release(storage);
+        }
+
+        // same as the rflags load handler, the guest flags live right below rsp
+        if (cmd->get_flags())
+        {
+            block->add({
+                encode(m_lea, ZREG(rsp), ZMEMBD(rsp, -8, TOB(bit_64))),
+                encode(m_popfq),
+            });
+        }
+
+        // park whatever the vm keeps in these registers at the bottom of the vm_overhead reserve and load the guest values
+        // the context and the guest rflags slot sit below rsp, the vm stack grows down from the far end of the reserve
+        // mov leaves rflags alone so the guest flags survive until the instruction runs
+        // xchg with memory would be an implicitly locked rmw for every register
+        for (int32_t i = 0; i < registers.size(); i++)
+            block->add(encode(m_mov, ZMEMBD(rsp, i * 8, 8), ZREG(registers[i])));
+
+        for (const reg target_reg : registers)
+            block->add(encode(m_mov, ZREG(target_reg), ZMEMBD(rsp, han_man->get_context_displacement(target_reg), 8)));
+
+        block->add(cmd->get_request());
+
+        for (const reg target_reg : registers)
+            block->add(encode(m_mov, ZMEMBD(rsp, han_man->get_context_displacement(target_reg), 8), ZREG(target_reg)));
+
+        for (int32_t i = 0; i < registers.size(); i++)
+            block->add(encode(m_mov, ZREG(registers[i]), ZMEMBD(rsp, i * 8, 8)));
+
+        if (cmd->get_flags())
+        {
+            block->add({
+                encode(m_pushfq),
+                encode(m_lea, ZREG(rsp), ZMEMBD(rsp, 8, TOB(bit_64))),
+            });
+        }
+
+        // the results are sitting in the context slots, scatter them back into the vm registers
+        for (const reg target_reg : cmd->get_written())
+        {
+            const ir::discrete_store_ptr storage = ir::discrete_store::create(ir::ir_size::bit_64);
+            reg_64_container->assign(storage);
+
+            const reg storage_reg = storage->get_store_register();
+            block->add(encode(m_mov, ZREG(storage_reg), ZMEMBD(rsp, han_man->get_context_displacement(target_reg), 8)));
+
+            auto [handler_store, _] = han_man->store_register(target_reg, storage);
+            han_man->call_vm_handler(block, handler_store);
+
+            reg_64_container->release(storage);
+        }
+    }
+
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_call_ptr& cmd)
+    {
+        const asmb::code_label_ptr return_entry = get_block_label(cmd->get_return_entry());
+        VM_ASSERT(return_entry != nullptr, "block contains missing context");
+
+        scope_register_manager scope = reg_64_container->create_scope();
+        const reg target_reg = scope.reserve();
+        const reg return_reg = scope.reserve();
+
+        // the lifter pushed the absolute target of indirect calls
+        if (cmd->is_dynamic())
+            call_pop(block, target_reg);
+
+        // mov return_reg, return_entry_rva
+        // lea return_reg, [VBASE + return_reg]
+        // push return_reg      ; the guest stack holds the same return address a native call would push
+        block->add(RECOMPILE(encode(m_mov, ZREG(return_reg), ZLABEL(return_entry))));
+        block->add(encode(m_lea, ZREG(return_reg), ZMEMBI(VBASE, return_reg, 1, TOB(bit_64))));
+        call_push(block, return_reg);
+
+        if (cmd->is_virtual())
+        {
+            const ir::block_ptr target = std::get<ir::block_ptr>(cmd->get_target());
+            const asmb::code_label_ptr target_label = get_block_label(target);
+            const asmb::code_label_ptr return_body = get_block_label(cmd->get_return_body());
+            VM_ASSERT(target_label != nullptr && return_body != nullptr, "block contains missing context");
+
+            // rets of the callee compare against this return address and jump straight to the body
+            han_man->add_return_site(return_entry, return_body);
+            block->add(RECOMPILE(encode(m_jmp, ZJMPR(target_label))));
+            return;
+        }
+
+        // mov VCSRET, target_rva
+        // jmp vm_exit_call     ; the callee runs natively and returns to the vm enter of the return block
+        if (cmd->is_dynamic())
+        {
+            block->add({
+                encode(m_sub, ZREG(target_reg), ZREG(VBASE)),
+                encode(m_mov, ZREG(VCSRET), ZREG(target_reg)),
+            });
+        }
+        else
+        {
+            std::visit([&]<typename exit_type>(exit_type&& arg)
+            {
+                using T = std::decay_t<exit_type>;
+                if constexpr (std::is_same_v<T, ir::vmexit_rva>)
+                {
+                    const ir::vmexit_rva target_rva = arg;
+                    block->add(encode(m_mov, ZREG(VCSRET), ZIMMS(static_cast<int32_t>(target_rva))));
+                }
+                else if constexpr (std::is_same_v<T, ir::block_ptr>)
+                {
+                    const asmb::code_label_ptr label = get_block_label(arg);
+                    VM_ASSERT(label != nullptr, "block contains missing context");
+
+                    block->add(RECOMPILE(encode(m_mov, ZREG(VCSRET), ZLABEL(label))));
+                }
+            }, cmd->get_target());
+        }
+
+        han_man->add_handler_call(block, han_man->get_vm_exit_call());
+        block->add(RECOMPILE(encode(m_jmp, ZJMPR(han_man->get_vm_exit_call()))));
+        han_man->invalidate_dispatch_cursor(block);
+    }
+
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_ret_ptr& cmd)
+    {
+        scope_register_manager scope = reg_64_container->create_scope();
+        const reg return_reg = scope.reserve();
+
+        // pop the return address the same way a native ret would
+        call_pop(block, return_reg);
+        if (const uint16_t release_bytes = cmd->get_release_bytes())
+            block->add(encode(m_lea, ZREG(VSP), ZMEMBD(VSP, release_bytes, TOB(bit_64))));
+
+        // mov VTEMP, return_reg
+        // jmp vm return        ; stays inside the vm if the return address belongs to a call from this vm
+        const asmb::code_label_ptr return_handler = han_man->get_vm_return();
+        han_man->add_handler_call(block, return_handler);
+
+        block->add(encode(m_mov, ZREG(VTEMP), ZREG(return_reg)));
+
+        block->add(RECOMPILE(encode(m_mov, ZREG(VIP), ZIMMS(return_handler->get_relative_address()))));
+        block->add(RECOMPILE(encode(m_lea, ZREG(VIP), ZMEMBI(VBASE, VIP, 1, TOB(bit_64)))));
+        block->add(encode(m_jmp, ZREG(VIP)));
+    }
+
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_string_ptr& cmd)
+    {
+        const bool is_movs = cmd->get_op() == ir::string_op::movs;
+
+        // the bulk handler works on the guest registers in the reserved temps
+        std::vector<std::pair<reg, reg>> arguments = { { rdi, VTEMP }, { is_movs ? rsi : rax, VTEMP2 } };
+        if (cmd->get_rep())
+            arguments.emplace_back(rcx, VTEMPX(2));
+        else
+            block->add(encode(m_mov, ZREG(VTEMPX(2)), ZIMMS(1)));
+
+        for (const auto& [target_reg, temp_reg] : arguments)
+        {
+            auto [handler_load, _] = han_man->load_register(target_reg, temp_reg);
+
+            block->add(encode(m_xor, ZREG(temp_reg), ZREG(temp_reg)));
+            han_man->call_vm_handler(block, handler_load);
+        }
+
+        han_man->call_vm_handler(block, han_man->get_string_handler(cmd->get_op(), to_reg_size(cmd->get_element_size())));
+
+        // stos only reads rax so there is nothing to write back
+        for (const auto& [target_reg, temp_reg] : arguments)
+        {
+            if (target_reg == rax)
+                continue;
+
+            auto [handler_store, _] = han_man->store_register(target_reg, temp_reg);
+            han_man->call_vm_handler(block, handler_store);
+        }
+    }
+
     std::vector<asmb::code_container_ptr> machine::create_handlers()
     {
         return han_man->build_handlers();
     }
 
+    asmb::code_container_ptr machine::create_profile_counters() const
+    {
+        return han_man->build_profile_counters();
+    }
+
+    std::vector<profile_counter> machine::get_profile_counters() const
+    {
+        return han_man->get_profile_counters();
+    }
+
+    const std::unordered_map<asmb::code_container_ptr, std::vector<asmb::code_label_ptr>>& machine::get_handler_calls() const
+    {
+        return han_man->get_handler_calls();
+    }
+
     void machine::handle_cmd(const asmb::code_container_ptr& code, const ir::base_command_ptr& command)
     {
         base_machine::handle_cmd(code, command);
         for (ir::discrete_store_ptr& res : command->get_release_list())
-            reg_64_container->release(res);
+            release_store(res);
+    }
+
+    void machine::release_store(const ir::discrete_store_ptr& store) const
+    {
+        if (reg_cache_container->is_blocked(store))
+            reg_cache_container->release(store);
+        else
+            get_store_container(store)->release(store);
+    }
+
+    const register_context_ptr& machine::get_store_container(const ir::discrete_store_ptr& store) const
+    {
+        // 128 bit values can only live in xmm registers
+        return store->get_store_size() == ir::ir_size::bit_128 ? reg_128_container : reg_64_container;
     }
 
     void machine::call_push(const asmb::code_container_ptr& block, const ir::discrete_store_ptr& shared)
@@ -482,6 +883,13 @@ namespace eagle::virt::eg
         reg pushing_register;
         const reg_size size = to_reg_size(shared->get_store_size());
 
+        if (size == bit_128)
+        {
+            // there is no working register wide enough, xmm values get a push handler per register
+            han_man->call_vm_handler(block, han_man->get_push(shared->get_store_register(), size));
+            return;
+        }
+
         if (!settings->randomize_working_register)
         {
             pushing_register = han_man->get_push_working_register();
@@ -503,6 +911,12 @@ namespace eagle::virt::eg
         reg pushing_register;
         const reg_size size = get_reg_size(target_reg);
 
+        if (size == bit_128)
+        {
+            han_man->call_vm_handler(block, han_man->get_push(target_reg, size));
+            return;
+        }
+
         if (!settings->randomize_working_register)
         {
             pushing_register = han_man->get_push_working_register();
@@ -522,6 +936,13 @@ namespace eagle::virt::eg
     void machine::call_pop(const asmb::code_container_ptr& block, const ir::discrete_store_ptr& shared) const
     {
         const reg_size size = to_reg_size(shared->get_store_size());
+        if (size == bit_128)
+        {
+            // same as push, xmm values skip the working register
+            han_man->call_vm_handler(block, han_man->get_pop(shared->get_store_register(), size));
+            return;
+        }
+
         if (!settings->randomize_working_register)
         {
             const reg returning_reg = han_man->get_pop_working_register();
@@ -560,6 +981,12 @@ namespace eagle::virt::eg
     void machine::call_pop(const asmb::code_container_ptr& block, const reg target_reg) const
     {
         const reg_size size = get_reg_size(target_reg);
+        if (size == bit_128)
+        {
+            han_man->call_vm_handler(block, han_man->get_pop(target_reg, size));
+            return;
+        }
+
         if (!settings->randomize_working_register)
         {
             const reg returning_reg = han_man->get_pop_working_register();
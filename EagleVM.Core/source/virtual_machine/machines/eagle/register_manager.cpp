@@ -27,10 +27,15 @@ namespace eagle::virt::eg
         virtual_order_gpr = get_gpr64_regs();
 
         num_v_temp_reserved = settings->randomize_working_register ? 0 : 3;
-        num_v_temp_unreserved = num_gpr_regs - num_v_regs - num_v_temp_reserved;
+        num_v_temp_cache = settings->context_cache_registers;
+        num_v_temp_unreserved = num_gpr_regs - num_v_regs - num_v_temp_reserved - num_v_temp_cache;
 
+        // handlers need at least 3 temps to load and store complex registers
+        VM_ASSERT(num_v_temp_unreserved >= 3, "too many registers reserved for context caching");
+
+        // the gpr mappings take up the 8 xmm registers after the reserved temps
         num_v_temp_xmm_reserved = 2;
-        num_v_temp_xmm_unreserved = 16 - 2;
+        num_v_temp_xmm_unreserved = 16 - 2 - 8;
     }
 
     void register_manager::init_reg_order()
@@ -180,14 +185,14 @@ namespace eagle::virt::eg
             if (xmm_low == xmm_high)
             {
                 // we are not writing across a boundary so we are fine
-                const codec::reg current_register = static_cast<codec::reg>(codec::xmm0 + xmm_low / 2);
+                const codec::reg current_register = get_mapping_xmm(xmm_low / 2);
                 occupy_range(current_register, src_reg, src_map);
             }
             else
             {
                 // we have a cross boundary
-                const codec::reg first_register = static_cast<codec::reg>(codec::xmm0 + xmm_low / 2);
-                const codec::reg last_register = static_cast<codec::reg>(codec::xmm0 + xmm_high / 2);
+                const codec::reg first_register = get_mapping_xmm(xmm_low / 2);
+                const codec::reg last_register = get_mapping_xmm(xmm_high / 2);
 
                 const uint16_t dest_midpoint = xmm_high * 64;
                 const uint16_t src_midpoint = src_map.first + (dest_midpoint - current_byte);
@@ -202,9 +207,9 @@ namespace eagle::virt::eg
 
     std::pair<uint32_t, codec::reg_size> register_manager::get_stack_displacement(const codec::reg reg) const
     {
-        //determine 64bit version of register
+        //determine 64bit version of register, xmm registers are pushed whole
         const codec::reg_size reg_size = get_reg_size(reg);
-        const codec::reg bit64_reg = get_bit_version(reg, codec::reg_class::gpr_64);
+        const codec::reg bit64_reg = get_reg_class(reg) == codec::xmm_128 ? reg : get_bit_version(reg, codec::reg_class::gpr_64);
 
         int found_offset = 0;
         const auto reg_count = push_order.size();
@@ -288,11 +293,20 @@ namespace eagle::virt::eg
         return virtual_order_gpr[num_v_regs + i];
     }
 
+    std::vector<codec::reg> register_manager::get_cache_temp() const
+    {
+        std::vector<codec::reg> out;
+        for (uint8_t i = 0; i < num_v_temp_cache; i++)
+            out.push_back(virtual_order_gpr[num_v_regs + num_v_temp_reserved + i]);
+
+        return out;
+    }
+
     std::vector<codec::reg> register_manager::get_unreserved_temp_xmm() const
     {
         std::vector<codec::reg> out;
         for (uint8_t i = 0; i < num_v_temp_xmm_unreserved; i++)
-            out.push_back(virtual_order_xmm[virtual_order_gpr.size() - 1 - i]);
+            out.push_back(virtual_order_xmm[virtual_order_xmm.size() - 1 - i]);
 
         return out;
     }
@@ -320,4 +334,11 @@ namespace eagle::virt::eg
         VM_ASSERT(i + 1 <= num_v_temp_xmm_reserved, "attempted to retreive register with no reservation");
         return virtual_order_xmm[i];
     }
+
+    codec::reg register_manager::get_mapping_xmm(const uint8_t i) const
+    {
+        // mapped registers sit between the reserved and unreserved temps so handlers can never clobber them
+        VM_ASSERT(num_v_temp_xmm_reserved + i < virtual_order_xmm.size() - num_v_temp_xmm_unreserved, "attempted to map outside of the mapping registers");
+        return virtual_order_xmm[num_v_temp_xmm_reserved + i];
+    }
 }
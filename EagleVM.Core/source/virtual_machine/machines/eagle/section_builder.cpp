@@ -0,0 +1,134 @@
+#include "eaglevm-core/virtual_machine/machines/eagle/section_builder.h"
+
+#include <ranges>
+
+#include "eaglevm-core/compiler/section_manager.h"
+#include "eaglevm-core/disassembler/disassembler.h"
+#include "eaglevm-core/virtual_machine/ir/ir_translator.h"
+#include "eaglevm-core/virtual_machine/ir/passes/constant_fold.h"
+#include "eaglevm-core/virtual_machine/ir/passes/context_dataflow.h"
+#include "eaglevm-core/virtual_machine/machines/eagle/machine.h"
+#include "eaglevm-core/util/assert.h"
+
+namespace eagle::virt::eg
+{
+    section_build build_section(const settings_ptr& settings, const std::vector<uint8_t>& bytes, const vm_id_policy vm_ids,
+        const uint64_t section_rva, const uint64_t runtime_base, const stage_hook& hook)
+    {
+        auto stage = [&hook](const char* name, const std::function<void()>& run)
+        {
+            if (hook)
+                hook(name, run);
+            else
+                run();
+        };
+
+        section_build result;
+
+        // get_instructions takes a mutable pointer
+        std::vector<uint8_t> instruction_data = bytes;
+
+        codec::decode_vec instructions;
+        stage("decode", [&]
+        {
+            instructions = codec::get_instructions(instruction_data.data(), instruction_data.size());
+        });
+
+        result.instruction_count = instructions.size();
+
+        dasm::segment_dasm_ptr dasm = std::make_shared<dasm::segment_dasm>(std::move(instructions), 0, instruction_data.size());
+        stage("generate_blocks", [&]
+        {
+            dasm->generate_blocks();
+        });
+
+        ir::ir_translator ir_trans(dasm);
+        ir::preopt_block_vec preopt;
+        stage("translate", [&]
+        {
+            preopt = ir_trans.translate(true);
+        });
+
+        uint32_t vm_index = 0;
+        std::vector<ir::preopt_vm_id> block_vm_ids;
+        for (const auto& preopt_block : preopt)
+            block_vm_ids.emplace_back(preopt_block, vm_ids == vm_id_policy::per_block ? vm_index++ : 0);
+
+        ir::preopt_block_ptr entry_block = nullptr;
+        for (const auto& preopt_block : preopt)
+            if (preopt_block->get_original_block() == dasm->get_block(0))
+                entry_block = preopt_block;
+
+        VM_ASSERT(entry_block != nullptr, "could not find matching preopt block for entry block");
+
+        std::unordered_map<ir::preopt_block_ptr, ir::block_ptr> block_tracker = { { entry_block, nullptr } };
+        std::vector<ir::block_vm_id> vm_blocks;
+        stage("optimize", [&]
+        {
+            vm_blocks = ir_trans.optimize(block_vm_ids, block_tracker, { entry_block });
+
+            const ir::context_dataflow dataflow(settings->context_cache_registers);
+            for (auto& blocks : vm_blocks | std::views::keys)
+            {
+                for (const auto& block : blocks)
+                {
+                    ir::constant_fold::run(block);
+                    dataflow.run(block);
+                }
+            }
+        });
+
+        std::unordered_map<ir::block_ptr, asmb::code_label_ptr> block_labels;
+        for (auto& blocks : vm_blocks | std::views::keys)
+        {
+            for (const auto& block : blocks)
+            {
+                block_labels[block] = asmb::code_label::create();
+                result.command_count += block->get_command_count();
+            }
+        }
+
+        asmb::section_manager vm_section(false);
+        asmb::code_label_ptr entry_point = asmb::code_label::create();
+
+        std::vector<machine_ptr> machines;
+        stage("lift_block", [&]
+        {
+            for (const auto& blocks : vm_blocks | std::views::keys)
+            {
+                machine_ptr machine = machine::create(settings);
+                machine->add_block_context(block_labels);
+
+                for (auto& translated_block : blocks)
+                {
+                    asmb::code_container_ptr result_container = machine->lift_block(translated_block);
+                    if (block_tracker[entry_block] == translated_block)
+                        result_container->bind_start(entry_point);
+
+                    vm_section.add_code_container(result_container);
+                }
+
+                machines.push_back(machine);
+            }
+        });
+
+        // all handlers go behind all lifted blocks, so both stages can be timed on their own
+        stage("create_handlers", [&]
+        {
+            for (const machine_ptr& machine : machines)
+                vm_section.add_code_container(machine->create_handlers());
+        });
+
+        stage("compile_section", [&]
+        {
+            result.code = vm_section.compile_section(section_rva, runtime_base);
+        });
+
+        // labels only have addresses once the section is compiled
+        result.entry_address = entry_point->get_address();
+        for (const auto& [block, label] : block_labels)
+            result.block_entries.emplace_back(label->get_address(), block->get_command_count());
+
+        return result;
+    }
+}
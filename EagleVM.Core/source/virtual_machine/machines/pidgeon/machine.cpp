@@ -50,6 +50,10 @@ namespace eagle::virt::pidg
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_context_load_ptr& cmd)
     {
         const reg target_reg = cmd->get_reg();
+
+        // pidgeon never saves xmm registers so there is no context slot to use
+        VM_ASSERT(get_reg_class(target_reg) != xmm_128, "pidgeon does not virtualize xmm registers");
+
         auto [displacement, size] = rm->get_stack_displacement(target_reg);
 
         block->add(encode(m_mov, ZREG(VTEMP), ZIMMU(displacement)));
@@ -59,6 +63,9 @@ namespace eagle::virt::pidg
     void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_context_store_ptr& cmd)
     {
         const reg target_reg = cmd->get_reg();
+
+        VM_ASSERT(get_reg_class(target_reg) != xmm_128, "pidgeon does not virtualize xmm registers");
+
         auto [displacement, size] = rm->get_stack_displacement(target_reg);
 
         block->add(encode(m_mov, ZREG(VTEMP), ZIMMU(displacement)));
@@ -107,6 +114,10 @@ namespace eagle::virt::pidg
             }
             default:
             {
+                // inside the vm the guest flags only live in the context, bring them back before the native jcc
+                if (cmd->is_virtual())
+                    hg->call_vm_handler(block, hg->get_rlfags_load());
+
                 // conditional
                 const ir::il_exit_result conditional_jump = cmd->get_condition_special();
                 write_jump(conditional_jump, to_jump_mnemonic(cmd->get_condition()));
@@ -411,9 +422,41 @@ namespace eagle::virt::pidg
                     const ir::discrete_store_ptr& store = arg;
                     add_op(request, ZREG(store->get_store_register()));
                 }
+                else if constexpr (std::is_same_v<T, uint64_t>)
+                {
+                    add_op(request, ZIMMS(static_cast<int64_t>(arg)));
+                }
             }, op);
         }
 
+        // implicit operands like rdx:rax have to be swapped into place around the instruction
+        if (const auto implicit = cmd->get_implicit(); !implicit.empty())
+        {
+            std::vector<std::pair<reg, reg>> bindings;
+            for (const auto& [target, store] : implicit)
+            {
+                transaction->assign(store);
+                bindings.emplace_back(get_bit_version(target, gpr_64), get_bit_version(store->get_store_register(), gpr_64));
+            }
+
+            for (const enc::req& implicit_request : encode_implicit(request, bindings))
+                block->add(implicit_request);
+
+            return;
+        }
+
+        // the count of a shift or rotate has to be in cl, our temps are wherever the allocator put them
+        if (is_cl_count_mnemonic(mnemonic) && request.operand_count == 2 && std::holds_alternative<ir::discrete_store_ptr>(operands[1]))
+        {
+            const reg value_reg = static_cast<reg>(request.operands[0].reg.value);
+            const reg count_reg = static_cast<reg>(request.operands[1].reg.value);
+
+            for (const enc::req& cl_request : encode_cl_count(mnemonic, value_reg, count_reg))
+                block->add(cl_request);
+
+            return;
+        }
+
         block->add(request);
     }
 
@@ -422,6 +465,63 @@ namespace eagle::virt::pidg
         block->add(cmd->get_request());
     }
 
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_native_island_ptr& cmd)
+    {
+        // pidgeon has no way of swapping single registers out of its context, so we leave the vm entirely
+        handle_cmd(block, std::make_shared<ir::cmd_vm_exit>());
+        block->add(cmd->get_request());
+        handle_cmd(block, std::make_shared<ir::cmd_vm_enter>());
+    }
+
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_string_ptr& cmd)
+    {
+        // pidgeon has no bulk handlers, the original instruction runs outside of the vm
+        handle_cmd(block, std::make_shared<ir::cmd_vm_exit>());
+        block->add(cmd->get_request());
+        handle_cmd(block, std::make_shared<ir::cmd_vm_enter>());
+    }
+
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_call_ptr& cmd)
+    {
+        // pidgeon has no return dispatch, every call leaves the vm and the callee returns into the vm enter of the return block
+        VM_ASSERT(!cmd->is_virtual(), "pidgeon cannot call into the body of a block");
+
+        // the original instruction computes an indirect target again
+        if (cmd->is_dynamic())
+            handle_cmd(block, std::make_shared<ir::cmd_pop>(nullptr, ir::ir_size::bit_64));
+
+        handle_cmd(block, std::make_shared<ir::cmd_vm_exit>());
+        std::visit([&]<typename exit_type>(exit_type&& arg)
+        {
+            using T = std::decay_t<exit_type>;
+            if constexpr (std::is_same_v<T, ir::block_ptr>)
+            {
+                const asmb::code_label_ptr label = get_block_label(arg);
+                VM_ASSERT(label != nullptr, "block contains missing context");
+
+                block->add(RECOMPILE(encode(m_call, ZJMPR(label))));
+            }
+            else
+            {
+                block->add(cmd->get_request());
+            }
+        }, cmd->get_target());
+
+        const asmb::code_label_ptr return_entry = get_block_label(cmd->get_return_entry());
+        VM_ASSERT(return_entry != nullptr, "block contains missing context");
+
+        block->add(RECOMPILE(encode(m_jmp, ZJMPR(return_entry))));
+    }
+
+    void machine::handle_cmd(const asmb::code_container_ptr& block, const ir::cmd_ret_ptr& cmd)
+    {
+        handle_cmd(block, std::make_shared<ir::cmd_vm_exit>());
+        if (const uint16_t release_bytes = cmd->get_release_bytes())
+            block->add(encode(m_ret, ZIMMU(release_bytes)));
+        else
+            block->add(encode(m_ret));
+    }
+
     void machine::handle_cmd(const asmb::code_container_ptr& code, const ir::base_command_ptr& command)
     {
         base_machine::handle_cmd(code, command);
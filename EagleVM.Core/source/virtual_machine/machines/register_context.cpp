@@ -141,6 +141,15 @@ namespace eagle::virt
         blocked_stores.erase(target_register_64);
     }
 
+    bool register_context::is_blocked(const ir::discrete_store_ptr& store) const
+    {
+        if (!store->get_finalized())
+            return false;
+
+        const codec::reg target_register_64 = get_bit_version(store->get_store_register(), target_size);
+        return blocked_stores.contains(target_register_64);
+    }
+
     scope_register_manager register_context::create_scope()
     {
         return scope_register_manager(shared_from_this());
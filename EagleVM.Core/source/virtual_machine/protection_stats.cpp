@@ -0,0 +1,210 @@
+#include "eaglevm-core/virtual_machine/protection_stats.h"
+
+#include <iomanip>
+#include <ranges>
+#include <sstream>
+
+#include "eaglevm-core/codec/zydis_helper.h"
+
+namespace eagle::virt
+{
+    namespace
+    {
+        void write_commands(std::stringstream& out, const std::map<ir::command_type, uint32_t>& commands)
+        {
+            out << "{";
+            for (bool first = true; const auto& [type, count] : commands)
+            {
+                out << (first ? "" : ",") << "\"" << ir::command_to_string(type) << "\":" << count;
+                first = false;
+            }
+
+            out << "}";
+        }
+
+        void write_mnemonics(std::stringstream& out, const std::map<codec::mnemonic, uint32_t>& mnemonics)
+        {
+            out << "{";
+            for (bool first = true; const auto& [mnemonic, count] : mnemonics)
+            {
+                out << (first ? "" : ",") << "\"" << codec::mnemonic_to_string(mnemonic) << "\":" << count;
+                first = false;
+            }
+
+            out << "}";
+        }
+
+        void write_ratio(std::stringstream& out, const uint64_t emitted, const uint64_t original)
+        {
+            const double ratio = original ? static_cast<double>(emitted) / static_cast<double>(original) : 0.0;
+            out << std::fixed << std::setprecision(3) << ratio << std::defaultfloat;
+        }
+
+        uint32_t get_count(const std::map<ir::command_type, uint32_t>& commands, const ir::command_type type)
+        {
+            const auto it = commands.find(type);
+            return it == commands.end() ? 0 : it->second;
+        }
+
+        template <typename T>
+        void merge_counts(std::map<T, uint32_t>& target, const std::map<T, uint32_t>& source)
+        {
+            for (const auto& [key, count] : source)
+                target[key] += count;
+        }
+    }
+
+    protection_stats::container_span protection_stats::container_span::bind(const asmb::code_container_ptr& container)
+    {
+        container_span span{ asmb::code_label::create(), asmb::code_label::create() };
+        container->bind_start(span.begin);
+        container->bind(span.end);
+
+        return span;
+    }
+
+    uint64_t protection_stats::container_span::size() const
+    {
+        return end->get_address() - begin->get_address();
+    }
+
+    void protection_stats::command_stats::add(const command_stats& other)
+    {
+        emitted_bytes += other.emitted_bytes;
+        blocks += other.blocks;
+        merge_counts(commands, other.commands);
+    }
+
+    void protection_stats::add_region(const ir::region_ptr& region, const uint64_t rva_begin, const uint64_t rva_end)
+    {
+        const size_t region_index = regions.size();
+        regions.push_back({
+            rva_begin,
+            rva_end,
+            region->translator->get_native_fallbacks(),
+            region->translator->get_native_islands()
+        });
+
+        // the optimizer drops and rewires blocks but never creates new ones, so ownership is taken from the translated blocks
+        for (const auto& preopt_block : region->blocks | std::views::keys)
+        {
+            if (preopt_block->has_head())
+                block_regions[preopt_block->get_head()] = region_index;
+
+            for (const ir::block_ptr& body : preopt_block->get_body())
+                block_regions[body] = region_index;
+
+            block_regions[preopt_block->get_tail()] = region_index;
+        }
+    }
+
+    void protection_stats::add_block(const uint32_t vm_id, const ir::block_ptr& block, const asmb::code_container_ptr& container)
+    {
+        block_info info{ vm_id, container_span::bind(container), { } };
+        for (size_t i = 0; i < block->get_command_count(); i++)
+            info.commands[block->get_command(i)->get_command_type()]++;
+
+        blocks.emplace_back(block, info);
+    }
+
+    void protection_stats::add_handlers(const uint32_t vm_id, const std::vector<asmb::code_container_ptr>& handlers)
+    {
+        machine_info& machine = machines[vm_id];
+        for (const asmb::code_container_ptr& handler : handlers)
+            machine.handlers.push_back(container_span::bind(handler));
+    }
+
+    std::string protection_stats::to_json() const
+    {
+        std::vector<command_stats> region_commands(regions.size());
+        std::map<uint32_t, command_stats> machine_commands;
+        command_stats total_commands;
+
+        for (const auto& [block, info] : blocks)
+        {
+            command_stats block_stats{ info.span.size(), 1, info.commands };
+            if (const auto it = block_regions.find(block); it != block_regions.end())
+                region_commands[it->second].add(block_stats);
+
+            machine_commands[info.vm_id].add(block_stats);
+            total_commands.add(block_stats);
+        }
+
+        std::stringstream out;
+        out << "{\"regions\":[";
+
+        uint64_t total_original = 0;
+        std::map<codec::mnemonic, uint32_t> total_fallbacks;
+        std::map<codec::mnemonic, uint32_t> total_islands;
+
+        for (size_t i = 0; i < regions.size(); i++)
+        {
+            const region_info& region = regions[i];
+            const command_stats& stats = region_commands[i];
+
+            const uint64_t original = region.rva_end - region.rva_begin;
+            total_original += original;
+
+            merge_counts(total_fallbacks, region.native_fallbacks);
+            merge_counts(total_islands, region.native_islands);
+
+            out << (i ? "," : "") << "{\"rva_begin\":" << region.rva_begin << ",\"rva_end\":" << region.rva_end
+                << ",\"original_bytes\":" << original << ",\"emitted_bytes\":" << stats.emitted_bytes << ",\"expansion\":";
+            write_ratio(out, stats.emitted_bytes, original);
+
+            out << ",\"blocks\":" << stats.blocks << ",\"vm_enters\":" << get_count(stats.commands, ir::command_type::vm_enter)
+                << ",\"vm_exits\":" << get_count(stats.commands, ir::command_type::vm_exit) << ",\"commands\":";
+            write_commands(out, stats.commands);
+
+            out << ",\"native_fallbacks\":";
+            write_mnemonics(out, region.native_fallbacks);
+
+            out << ",\"native_islands\":";
+            write_mnemonics(out, region.native_islands);
+            out << "}";
+        }
+
+        out << "],\"machines\":[";
+
+        uint64_t total_handlers = 0;
+        uint64_t total_handler_bytes = 0;
+
+        for (bool first = true; const auto& [vm_id, machine] : machines)
+        {
+            uint64_t handler_bytes = 0;
+            for (const container_span& handler : machine.handlers)
+                handler_bytes += handler.size();
+
+            total_handlers += machine.handlers.size();
+            total_handler_bytes += handler_bytes;
+
+            const auto it = machine_commands.find(vm_id);
+            const command_stats stats = it == machine_commands.end() ? command_stats{ } : it->second;
+
+            out << (first ? "" : ",") << "{\"vm_id\":" << vm_id << ",\"blocks\":" << stats.blocks << ",\"block_bytes\":" << stats.emitted_bytes
+                << ",\"handlers\":" << machine.handlers.size() << ",\"handler_bytes\":" << handler_bytes << "}";
+
+            first = false;
+        }
+
+        const uint64_t total_emitted = total_commands.emitted_bytes + total_handler_bytes;
+
+        out << "],\"total\":{\"original_bytes\":" << total_original << ",\"emitted_bytes\":" << total_emitted
+            << ",\"block_bytes\":" << total_commands.emitted_bytes << ",\"handler_bytes\":" << total_handler_bytes << ",\"expansion\":";
+        write_ratio(out, total_emitted, total_original);
+
+        out << ",\"blocks\":" << total_commands.blocks << ",\"handlers\":" << total_handlers
+            << ",\"vm_enters\":" << get_count(total_commands.commands, ir::command_type::vm_enter)
+            << ",\"vm_exits\":" << get_count(total_commands.commands, ir::command_type::vm_exit) << ",\"commands\":";
+        write_commands(out, total_commands.commands);
+
+        out << ",\"native_fallbacks\":";
+        write_mnemonics(out, total_fallbacks);
+
+        out << ",\"native_islands\":";
+        write_mnemonics(out, total_islands);
+        out << "}}";
+
+        return out.str();
+    }
+}
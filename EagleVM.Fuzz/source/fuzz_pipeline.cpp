@@ -0,0 +1,198 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/interpreter/interpreter.h"
+#include "eaglevm-core/virtual_machine/machines/eagle/section_builder.h"
+
+using namespace eagle;
+
+/*
+ * libfuzzer target for decode -> lift -> compile
+ *
+ * input layout:
+ * [16 gprs, 8 bytes each][rflags, 4 bytes][settings, 1 byte][code]
+ *
+ * the code goes through the same pipeline as EagleVM.Tests and both the original and the virtualized code are
+ * run in the interpreter. whenever the original code runs into the trap appended to it, the vm has to trap with the
+ * same gprs and defined flags. crashes inside the pipeline are left to libfuzzer
+ */
+namespace
+{
+    // the original code sits at the image base and the vm section right behind it,
+    // so rip relative operands and exits out of the vm land on the same bytes in both runs
+    constexpr uint64_t image_base = 0x140000000;
+    constexpr uint64_t vm_section_rva = 0x100000;
+
+    constexpr uint64_t stack_top = 0x7FFFFFF00000;
+
+    // random backwards branches loop forever, and the vm runs a lot of instructions for each original one
+    constexpr uint64_t native_steps = 10'000;
+    constexpr uint64_t virtual_steps = 10'000'000;
+
+    // ud2, the interpreter stops on it with a trap
+    const std::vector<uint8_t> exit_trap = { 0x0F, 0x0B };
+
+    constexpr size_t state_size = 16 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t);
+
+    // flags the interpreter tracks, tf and everything above of is left alone by both runs
+    constexpr uint64_t compared_flags = interp::flag_cf | interp::flag_pf | interp::flag_af | interp::flag_zf |
+        interp::flag_sf | interp::flag_df | interp::flag_of;
+
+    struct run_result
+    {
+        interp::exec_status status;
+        interp::cpu_state state;
+    };
+
+    run_result run(const interp::cpu_state& input, const std::vector<uint8_t>& code, const std::vector<uint8_t>& section,
+        const uint64_t entry, const uint64_t max_steps)
+    {
+        interp::memory memory;
+        memory.load(image_base, code.data(), code.size());
+        if (!section.empty())
+            memory.load(image_base + vm_section_rva, section.data(), section.size());
+
+        // random pointers are fine, both runs see the same zeroed pages
+        memory.set_lazy(true);
+
+        interp::interpreter interpreter(memory);
+        interpreter.get_state() = input;
+        interpreter.get_state().rip = entry;
+
+        const interp::exec_status status = interpreter.run(max_steps);
+        return { status, interpreter.get_state() };
+    }
+
+    virt::eg::settings_ptr create_settings(const uint8_t bits)
+    {
+        // nothing random, a crash has to reproduce from the same input
+        virt::eg::settings_ptr settings = std::make_shared<virt::eg::settings>();
+        settings->randomize_working_register = false;
+        settings->shuffle_push_order = false;
+        settings->shuffle_vm_gpr_order = false;
+        settings->shuffle_vm_xmm_order = false;
+
+        settings->single_vm_handlers = bits & 1;
+        settings->relative_addressing = bits & 2;
+        settings->complex_temp_loading = bits & 4;
+        settings->threaded_dispatch = bits & 8;
+        settings->context_cache_registers = bits >> 4 & 3;
+
+        return settings;
+    }
+
+    /**
+     * flags the original code leaves undefined can come out of the vm either way
+     */
+    uint64_t get_undefined_flags(const codec::decode_vec& instructions)
+    {
+        uint64_t undefined = 0;
+        for (const codec::dec::inst_info& decode : instructions)
+            if (decode.instruction.cpu_flags)
+                undefined |= decode.instruction.cpu_flags->undefined;
+
+        return undefined;
+    }
+
+    /**
+     * reads below rsp hit the context vm enter saved instead of whatever the original code expects there
+     */
+    bool reads_below_stack(const codec::decode_vec& instructions)
+    {
+        for (const auto& [instruction, operands] : instructions)
+        {
+            for (uint8_t i = 0; i < instruction.operand_count_visible; i++)
+            {
+                const codec::dec::operand& operand = operands[i];
+                if (operand.type == ZYDIS_OPERAND_TYPE_MEMORY && operand.mem.base == ZYDIS_REGISTER_RSP && operand.mem.disp.value < 0)
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[noreturn]] void report_mismatch(const char* what, const run_result& native, const run_result& virtualized)
+    {
+        std::printf("[!] %s\n", what);
+        std::printf("\t[>] status native %u, virtual %u\n", static_cast<uint32_t>(native.status),
+            static_cast<uint32_t>(virtualized.status));
+
+        for (size_t i = 0; i < native.state.gpr.size(); i++)
+        {
+            const char* name = codec::reg_to_string(static_cast<codec::reg>(codec::rax + i));
+            std::printf("\t[>] %-4s %016llx %016llx%s\n", name, static_cast<unsigned long long>(native.state.gpr[i]),
+                static_cast<unsigned long long>(virtualized.state.gpr[i]), native.state.gpr[i] != virtualized.state.gpr[i] ? " <" : "");
+        }
+
+        std::printf("\t[>] rflags %016llx %016llx\n", static_cast<unsigned long long>(native.state.rflags),
+            static_cast<unsigned long long>(virtualized.state.rflags));
+
+        std::abort();
+    }
+}
+
+extern "C" int LLVMFuzzerInitialize(int*, char***)
+{
+    codec::setup_decoder();
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size)
+{
+    if (size <= state_size)
+        return -1;
+
+    interp::cpu_state input;
+    std::memcpy(input.gpr.data(), data, 16 * sizeof(uint64_t));
+
+    uint32_t flags = 0;
+    std::memcpy(&flags, data + 16 * sizeof(uint64_t), sizeof(uint32_t));
+
+    input.gpr[codec::rsp - codec::rax] = stack_top;
+
+    // df is clear at every call boundary, the string handlers rely on it
+    input.rflags = (flags & compared_flags & ~interp::flag_df) | 0x202;
+
+    const virt::eg::settings_ptr settings = create_settings(data[state_size - 1]);
+
+    // only the part which decodes is kept, the trap has to directly follow the last instruction
+    std::vector<uint8_t> code(data + state_size, data + size);
+    const codec::decode_vec decoded = codec::get_instructions(code.data(), code.size());
+
+    size_t code_size = 0;
+    for (const codec::dec::inst_info& decode : decoded)
+        code_size += decode.instruction.length;
+
+    if (code_size == 0)
+        return -1;
+
+    code.resize(code_size);
+    code.insert(code.end(), exit_trap.begin(), exit_trap.end());
+
+    // every block gets its own vm so the branches between vms are covered too
+    const virt::eg::section_build section = virt::eg::build_section(settings, code, virt::eg::vm_id_policy::per_block, vm_section_rva, image_base);
+
+    // anything other than falling through to the appended trap is not compared, a trap in the middle runs inside the vm
+    const run_result native = run(input, code, { }, image_base, native_steps);
+    if (native.status != interp::exec_status::trap || native.state.rip != image_base + code_size || reads_below_stack(decoded))
+        return 0;
+
+    const run_result virtualized = run(input, code, section.code, section.entry_address, virtual_steps);
+    if (virtualized.status != interp::exec_status::trap)
+        report_mismatch("virtualized code did not reach the trap", native, virtualized);
+
+    for (size_t i = 0; i < native.state.gpr.size(); i++)
+        if (native.state.gpr[i] != virtualized.state.gpr[i])
+            report_mismatch("gpr mismatch", native, virtualized);
+
+    const uint64_t flag_mask = compared_flags & ~get_undefined_flags(decoded);
+    if ((native.state.rflags & flag_mask) != (virtualized.state.rflags & flag_mask))
+        report_mismatch("rflags mismatch", native, virtualized);
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * counts heap allocations made through the global operator new
+ * the counters are always running, a scope only looks at the difference between begin and end
+ */
+namespace alloc_tracker
+{
+    struct snapshot
+    {
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+
+        // highest amount of live heap memory above what was live at begin
+        uint64_t peak_bytes = 0;
+    };
+
+    /**
+     * resets the peak to the memory currently live
+     */
+    void begin();
+    snapshot end();
+}
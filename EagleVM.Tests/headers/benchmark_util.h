@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "eaglevm-core/codec/zydis_defs.h"
+#include "eaglevm-core/virtual_machine/machines/eagle/section_builder.h"
+#include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
+
+namespace benchmark_util
+{
+    struct build_result
+    {
+        eagle::codec::encoded_vec code;
+
+        size_t command_count = 0;
+        size_t instruction_count = 0;
+
+        // runtime address of every block start with the amount of ir commands in the block
+        std::vector<std::pair<uint64_t, size_t>> block_entries;
+    };
+
+    /**
+     * sends x86 bytes through the same pipeline the tests use, every block is given to the same vm id
+     * the exit trap is appended so the result leaves through the exception handler
+     * @param runtime_base address the section is compiled to run at
+     * @param stage_timer optional, wrapped around every stage of the pipeline
+     */
+    build_result build(const eagle::virt::eg::settings_ptr& settings, const std::vector<uint8_t>& bytes, uint64_t runtime_base,
+        const eagle::virt::eg::stage_hook& stage_timer = nullptr);
+
+    /**
+     * copies code into the run space and runs it natively
+     * @return the fewest cycles a single run took
+     */
+    uint64_t measure(const eagle::codec::encoded_vec& code, uint64_t run_space, uint32_t run_space_size, uint32_t iterations);
+}
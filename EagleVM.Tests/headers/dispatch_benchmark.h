@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+#include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
+
+namespace dispatch_benchmark
+{
+    /**
+     * virtualizes the same register only instruction stream with stack and threaded dispatch
+     * and reports the average cycles spent per ir command for each mode
+     * @param base_settings settings every other option is copied from
+     * @param iterations amount of runs per mode, the fastest run is used
+     */
+    void run(const eagle::virt::eg::settings_ptr& base_settings, uint32_t iterations);
+}
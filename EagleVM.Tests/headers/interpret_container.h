@@ -0,0 +1,52 @@
+#pragma once
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "platform.h"
+#include "run_container.h"
+#include "eaglevm-core/interpreter/interpreter.h"
+
+/**
+ * runs a compiled test through the interpreter instead of on the host cpu
+ * nothing is executed natively so tests which move rsp or rip can run, and any number of containers can run in parallel
+ */
+class interpret_container
+{
+public:
+    interpret_container(const reg_overwrites& input, const reg_overwrites& output)
+    {
+        input_writes = input;
+        output_writes = output;
+    }
+
+    /**
+     * @param code compiled section, has to be compiled for base
+     * @param base address the section is mapped at
+     * @param max_steps amount of instructions after which the run is given up on
+     */
+    std::pair<CONTEXT, CONTEXT> run(const std::vector<uint8_t>& code, uint64_t base, uint64_t max_steps = 1'000'000);
+
+    eagle::interp::exec_status get_status() const;
+    uint64_t get_executed() const;
+
+    /**
+     * @return the last instructions before the run stopped, oldest first
+     */
+    std::vector<std::string> get_trace() const;
+
+private:
+    static constexpr size_t trace_length = 32;
+    static constexpr uint64_t stack_top = 0x7FFFFFF00000;
+
+    reg_overwrites input_writes;
+    reg_overwrites output_writes;
+
+    eagle::interp::exec_status status = eagle::interp::exec_status::success;
+    uint64_t executed = 0;
+
+    std::deque<std::pair<uint64_t, eagle::codec::dec::inst_info>> trace;
+
+    static eagle::interp::cpu_state to_state(const CONTEXT& context);
+    static CONTEXT from_state(const eagle::interp::cpu_state& state);
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
+
+namespace overhead_benchmark
+{
+    /**
+     * runs a set of small kernels natively and virtualized for a few settings combinations
+     * and writes the slowdown, executed ir commands per instruction and code size expansion of each pair as json
+     * @param base_settings settings every combination is copied from
+     * @param iterations amount of runs per kernel, the fastest run is used
+     * @param output_path file the json results are written to
+     */
+    void run(const eagle::virt::eg::settings_ptr& base_settings, uint32_t iterations, const std::string& output_path);
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
+
+namespace pipeline_benchmark
+{
+    /**
+     * sends synthetic instruction streams of increasing size, and any recorded ones, through every stage of the compile pipeline
+     * and writes the time, instructions per second, allocations and peak heap memory of each stage as json
+     * @param base_settings settings machines are created with
+     * @param repeats amount of runs per stream, the fastest run of each stage is used
+     * @param output_path file the json results are written to
+     * @param recorded_paths files holding raw x86-64 code to benchmark next to the synthetic streams
+     */
+    void run(const eagle::virt::eg::settings_ptr& base_settings, uint32_t repeats, const std::string& output_path,
+        const std::vector<std::string>& recorded_paths);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+/**
+ * the parts of the windows CONTEXT the tests read and write
+ * the test data refers to registers by these names so the comparison code works on both platforms
+ */
+struct CONTEXT
+{
+    uint64_t Rax;
+    uint64_t Rcx;
+    uint64_t Rdx;
+    uint64_t Rbx;
+    uint64_t Rsp;
+    uint64_t Rbp;
+    uint64_t Rsi;
+    uint64_t Rdi;
+    uint64_t R8;
+    uint64_t R9;
+    uint64_t R10;
+    uint64_t R11;
+    uint64_t R12;
+    uint64_t R13;
+    uint64_t R14;
+    uint64_t R15;
+    uint64_t Rip;
+
+    // flags are written through a 64 bit pointer, same as on windows
+    uint32_t EFlags;
+    uint32_t EFlagsHigh;
+};
+
+typedef CONTEXT* PCONTEXT;
+#endif
+
+namespace platform
+{
+    /**
+     * instruction appended to every run so it traps back out of the run area
+     * vmcall is #UD on bare metal, but under a hypervisor it can turn into a hypercall that returns, so linux uses ud2
+     */
+#ifdef _WIN32
+    inline const std::vector<uint8_t> exit_trap = { 0x0F, 0x01, 0xC1 };
+#else
+    inline const std::vector<uint8_t> exit_trap = { 0x0F, 0x0B };
+#endif
+
+    /**
+     * allocates read, write and execute memory for compiled vm sections
+     * VirtualAlloc on windows, mmap on linux
+     */
+    void* alloc_executable(size_t size);
+    void free_executable(void* address, size_t size);
+
+    /**
+     * raises the process priority so the timing of runs is less noisy
+     */
+    void raise_priority();
+}
\ No newline at end of file
@@ -2,9 +2,15 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
-#include <Windows.h>
 #include <vector>
 
+#include "platform.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <ucontext.h>
+#endif
+
 typedef std::vector<std::pair<std::string, uint64_t>> reg_overwrites;
 typedef std::pair<uint64_t, uint32_t> memory_range;
 
@@ -38,6 +44,10 @@ public:
     void set_run_area(uint64_t address, uint32_t size);
     void* get_run_area() const;
 
+    /**
+     * installs the handler which catches the exit trap at the end of a run
+     * on windows this is a vectored exception handler, on linux SIGILL and SIGSEGV handlers
+     */
     static void init_veh();
     static void destroy_veh();
 
@@ -58,9 +68,21 @@ private:
     static CONTEXT build_context(const CONTEXT& safe, reg_overwrites& writes);
     static CONTEXT clear_context(const CONTEXT& safe, reg_overwrites& writes);
 
-    inline static PVOID veh_handle;
     inline static std::mutex run_tests_mutex;
     inline static std::unordered_map<run_container*, memory_range> run_tests;
 
+#ifdef _WIN32
+    inline static PVOID veh_handle;
+
     static LONG CALLBACK veh_handler(EXCEPTION_POINTERS* info);
+#else
+    // register state the run area is entered with
+    CONTEXT input_context{};
+
+    // full state of the thread at the entry trap, put back once the run area traps out
+    gregset_t safe_gregs{};
+    _libc_fpstate safe_fpu{};
+
+    static void signal_handler(int signal, siginfo_t* info, void* context);
+#endif
 };
\ No newline at end of file
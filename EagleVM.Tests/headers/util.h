@@ -1,11 +1,14 @@
 #pragma once
-#include <Windows.h>
 #include <vector>
+#include <sstream>
 #include <string>
 
 #include "nlohmann/json.hpp"
+#include "platform.h"
 
+#ifdef _WIN32
 EXTERN_C IMAGE_DOS_HEADER __ImageBase;
+#endif
 
 enum comparison_fail
 {
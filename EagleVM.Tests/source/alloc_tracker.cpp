@@ -0,0 +1,172 @@
+#include "alloc_tracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+#ifdef _WIN32
+#define usable_size _msize
+#define aligned_usable_size(memory, alignment) _aligned_msize(memory, alignment, 0)
+#else
+#define usable_size malloc_usable_size
+#define aligned_usable_size(memory, alignment) malloc_usable_size(memory)
+#endif
+
+namespace
+{
+    std::atomic_uint64_t allocations = 0;
+    std::atomic_uint64_t allocated_bytes = 0;
+    std::atomic_uint64_t live_bytes = 0;
+    std::atomic_uint64_t peak_bytes = 0;
+
+    uint64_t begin_allocations = 0;
+    uint64_t begin_allocated_bytes = 0;
+    uint64_t begin_live_bytes = 0;
+
+    void track_alloc(const uint64_t bytes)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        const uint64_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+        uint64_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void* tracked_alloc(const size_t size)
+    {
+        void* memory = std::malloc(size ? size : 1);
+        if (!memory)
+            throw std::bad_alloc();
+
+        track_alloc(usable_size(memory));
+        return memory;
+    }
+
+    void tracked_free(void* memory)
+    {
+        if (!memory)
+            return;
+
+        live_bytes.fetch_sub(usable_size(memory), std::memory_order_relaxed);
+        std::free(memory);
+    }
+
+    // over aligned types come through the align_val_t overloads, their memory needs the matching free
+    void* tracked_aligned_alloc(const size_t size, const std::align_val_t alignment)
+    {
+        const size_t align = static_cast<size_t>(alignment);
+
+#ifdef _WIN32
+        void* memory = _aligned_malloc(size ? size : 1, align);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        void* memory = std::aligned_alloc(align, ((size ? size : 1) + align - 1) & ~(align - 1));
+#endif
+        if (!memory)
+            throw std::bad_alloc();
+
+        track_alloc(aligned_usable_size(memory, align));
+        return memory;
+    }
+
+    void tracked_aligned_free(void* memory, const std::align_val_t alignment)
+    {
+        if (!memory)
+            return;
+
+        live_bytes.fetch_sub(aligned_usable_size(memory, static_cast<size_t>(alignment)), std::memory_order_relaxed);
+
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+void* operator new(const size_t size)
+{
+    return tracked_alloc(size);
+}
+
+void* operator new[](const size_t size)
+{
+    return tracked_alloc(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    tracked_free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    tracked_free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    tracked_free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    tracked_free(memory);
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment)
+{
+    return tracked_aligned_alloc(size, alignment);
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment)
+{
+    return tracked_aligned_alloc(size, alignment);
+}
+
+void operator delete(void* memory, const std::align_val_t alignment) noexcept
+{
+    tracked_aligned_free(memory, alignment);
+}
+
+void operator delete[](void* memory, const std::align_val_t alignment) noexcept
+{
+    tracked_aligned_free(memory, alignment);
+}
+
+void operator delete(void* memory, size_t, const std::align_val_t alignment) noexcept
+{
+    tracked_aligned_free(memory, alignment);
+}
+
+void operator delete[](void* memory, size_t, const std::align_val_t alignment) noexcept
+{
+    tracked_aligned_free(memory, alignment);
+}
+
+namespace alloc_tracker
+{
+    void begin()
+    {
+        begin_allocations = allocations.load();
+        begin_allocated_bytes = allocated_bytes.load();
+        begin_live_bytes = live_bytes.load();
+
+        peak_bytes.store(begin_live_bytes);
+    }
+
+    snapshot end()
+    {
+        snapshot result;
+        result.allocations = allocations.load() - begin_allocations;
+        result.allocated_bytes = allocated_bytes.load() - begin_allocated_bytes;
+        result.peak_bytes = peak_bytes.load() - begin_live_bytes;
+
+        return result;
+    }
+}
@@ -0,0 +1,59 @@
+#include "benchmark_util.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "platform.h"
+#include "run_container.h"
+#include "eaglevm-core/virtual_machine/machines/eagle/section_builder.h"
+
+using namespace eagle;
+
+namespace benchmark_util
+{
+    build_result build(const virt::eg::settings_ptr& settings, const std::vector<uint8_t>& bytes, const uint64_t runtime_base,
+        const virt::eg::stage_hook& stage_timer)
+    {
+        std::vector<uint8_t> instruction_data = bytes;
+
+        // leaves through the exception handler the same way tests do
+        instruction_data.append_range(platform::exit_trap);
+
+        virt::eg::section_build section = virt::eg::build_section(settings, instruction_data, virt::eg::vm_id_policy::shared, 0, runtime_base,
+            stage_timer);
+
+        build_result result;
+        result.code = std::move(section.code);
+        result.command_count = section.command_count;
+        result.instruction_count = section.instruction_count - 1;
+        result.block_entries = std::move(section.block_entries);
+
+        return result;
+    }
+
+    uint64_t measure(const codec::encoded_vec& code, const uint64_t run_space, const uint32_t run_space_size, const uint32_t iterations)
+    {
+        memcpy(reinterpret_cast<void*>(run_space), code.data(), code.size());
+
+        uint64_t fastest = UINT64_MAX;
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            run_container container({}, {});
+            container.set_run_area(run_space, run_space_size);
+
+            const uint64_t start = __rdtsc();
+            container.run();
+            const uint64_t end = __rdtsc();
+
+            fastest = (std::min)(fastest, end - start);
+        }
+
+        return fastest;
+    }
+}
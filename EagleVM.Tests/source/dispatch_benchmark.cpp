@@ -0,0 +1,68 @@
+#include "dispatch_benchmark.h"
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+#include "benchmark_util.h"
+#include "platform.h"
+
+using namespace eagle;
+
+namespace dispatch_benchmark
+{
+    // register only instructions so the block does not need any memory set up
+    const std::vector<uint8_t> body = {
+        0x48, 0x01, 0xD8, // add rax, rbx
+        0x48, 0x83, 0xE9, 0x10, // sub rcx, 0x10
+        0x48, 0x8D, 0x54, 0x48, 0x08, // lea rdx, [rax + rcx * 2 + 8]
+        0x49, 0x89, 0xD0, // mov r8, rdx
+    };
+
+    constexpr uint32_t body_repeat = 256;
+    constexpr uint32_t run_space_size = 0x500000;
+
+    std::vector<uint8_t> repeat_body(const uint32_t repeat)
+    {
+        std::vector<uint8_t> instruction_data;
+        for (uint32_t i = 0; i < repeat; i++)
+            instruction_data.append_range(body);
+
+        return instruction_data;
+    }
+
+    void run(const virt::eg::settings_ptr& base_settings, const uint32_t iterations)
+    {
+        const uint64_t run_space = reinterpret_cast<uint64_t>(platform::alloc_executable(run_space_size));
+
+        double cycles_per_command[2] = { };
+        for (const bool threaded : { false, true })
+        {
+            const virt::eg::settings_ptr settings = std::make_shared<virt::eg::settings>(*base_settings);
+            settings->threaded_dispatch = threaded;
+
+            // the empty run only enters and leaves the vm, subtracting it leaves the cost of the body
+            const benchmark_util::build_result empty = benchmark_util::build(settings, repeat_body(0), run_space);
+            const benchmark_util::build_result full = benchmark_util::build(settings, repeat_body(body_repeat), run_space);
+            if (full.code.size() > run_space_size)
+            {
+                spdlog::get("console")->error("dispatch benchmark does not fit in the run space");
+                break;
+            }
+
+            const uint64_t empty_cycles = benchmark_util::measure(empty.code, run_space, run_space_size, iterations);
+            const uint64_t full_cycles = benchmark_util::measure(full.code, run_space, run_space_size, iterations);
+
+            const size_t commands = full.command_count - empty.command_count;
+            cycles_per_command[threaded] = static_cast<double>(full_cycles - (std::min)(full_cycles, empty_cycles)) / commands;
+
+            spdlog::get("console")->info("{} dispatch: {} ir commands, {} bytes, {:.2f} cycles per command",
+                threaded ? "threaded" : "stack", commands, full.code.size(), cycles_per_command[threaded]);
+        }
+
+        if (cycles_per_command[0] > 0)
+            spdlog::get("console")->info("threaded dispatch runs at {:.2f}x of stack dispatch", cycles_per_command[1] / cycles_per_command[0]);
+
+        platform::free_executable(reinterpret_cast<void*>(run_space), run_space_size);
+    }
+}
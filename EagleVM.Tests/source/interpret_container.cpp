@@ -0,0 +1,106 @@
+#include "interpret_container.h"
+
+#include <sstream>
+#include "util.h"
+
+namespace
+{
+    // CONTEXT and cpu_state both keep gprs in encoding order, rax through r15
+    constexpr uint64_t CONTEXT::* context_gprs[] = {
+        &CONTEXT::Rax, &CONTEXT::Rcx, &CONTEXT::Rdx, &CONTEXT::Rbx,
+        &CONTEXT::Rsp, &CONTEXT::Rbp, &CONTEXT::Rsi, &CONTEXT::Rdi,
+        &CONTEXT::R8, &CONTEXT::R9, &CONTEXT::R10, &CONTEXT::R11,
+        &CONTEXT::R12, &CONTEXT::R13, &CONTEXT::R14, &CONTEXT::R15,
+    };
+}
+
+std::pair<CONTEXT, CONTEXT> interpret_container::run(const std::vector<uint8_t>& code, const uint64_t base, const uint64_t max_steps)
+{
+    CONTEXT safe_context = { };
+    safe_context.Rsp = stack_top;
+    safe_context.Rip = base;
+    safe_context.EFlags = 0x202;
+
+    // same layout as a native run except rsp is taken from the test when it has one
+    CONTEXT input_target = safe_context;
+    for (auto& [reg, value] : output_writes)
+        *test_util::get_value(input_target, reg) = 0;
+
+    for (auto& [reg, value] : input_writes)
+        *test_util::get_value(input_target, reg) = value;
+
+    CONTEXT output_target = safe_context;
+    for (auto& [reg, value] : output_writes)
+        *test_util::get_value(output_target, reg) = value;
+
+    input_target.Rip = base;
+
+    eagle::interp::memory memory;
+    memory.load(base, code.data(), code.size());
+
+    // tests address memory through whatever their registers hold
+    memory.set_lazy(true);
+
+    eagle::interp::interpreter interpreter(memory);
+    interpreter.get_state() = to_state(input_target);
+    interpreter.set_trace([this](const eagle::interp::cpu_state& state, const eagle::codec::dec::inst_info& decode)
+    {
+        if (trace.size() == trace_length)
+            trace.pop_front();
+
+        trace.emplace_back(state.rip, decode);
+    });
+
+    status = interpreter.run(max_steps);
+    executed = interpreter.get_executed();
+
+    return { from_state(interpreter.get_state()), output_target };
+}
+
+eagle::interp::exec_status interpret_container::get_status() const
+{
+    return status;
+}
+
+uint64_t interpret_container::get_executed() const
+{
+    return executed;
+}
+
+std::vector<std::string> interpret_container::get_trace() const
+{
+    std::vector<std::string> lines;
+    for (const auto& [rip, decode] : trace)
+    {
+        std::stringstream line;
+        line << std::hex << rip << ": " << eagle::codec::instruction_to_string(decode);
+
+        lines.push_back(line.str());
+    }
+
+    return lines;
+}
+
+eagle::interp::cpu_state interpret_container::to_state(const CONTEXT& context)
+{
+    eagle::interp::cpu_state state;
+    for (size_t i = 0; i < std::size(context_gprs); i++)
+        state.gpr[i] = context.*context_gprs[i];
+
+    state.rip = context.Rip;
+    state.rflags = context.EFlags | 0x2;
+
+    return state;
+}
+
+CONTEXT interpret_container::from_state(const eagle::interp::cpu_state& state)
+{
+    CONTEXT context = { };
+    for (size_t i = 0; i < std::size(context_gprs); i++)
+        context.*context_gprs[i] = state.gpr[i];
+
+    context.Rip = state.rip;
+    context.EFlags = static_cast<uint32_t>(state.rflags);
+
+    return context;
+}
@@ -1,14 +1,19 @@
+#ifdef _WIN32
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
 #include <crtdbg.h>
+#endif
 
+#include <algorithm>
+#include <bit>
 #include <bitset>
-#include <execution>
-#include <Windows.h>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 #include <future>
+#include <ranges>
+#include <thread>
 #include <vector>
 #include <eaglevm-core/disassembler/disassembler.h>
 
@@ -20,9 +25,16 @@
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 #include "util.h"
+#include "platform.h"
 #include "run_container.h"
+#include "interpret_container.h"
+#include "dispatch_benchmark.h"
+#include "overhead_benchmark.h"
+#include "pipeline_benchmark.h"
 #include "eaglevm-core/compiler/section_manager.h"
 #include "eaglevm-core/virtual_machine/ir/ir_translator.h"
+#include "eaglevm-core/virtual_machine/ir/passes/constant_fold.h"
+#include "eaglevm-core/virtual_machine/ir/passes/context_dataflow.h"
 #include "eaglevm-core/virtual_machine/machines/eagle/machine.h"
 #include "eaglevm-core/virtual_machine/machines/eagle/settings.h"
 #include "eaglevm-core/virtual_machine/machines/pidgeon/machine.h"
@@ -32,7 +44,6 @@ reg_overwrites build_writes(nlohmann::json& inputs);
 uint32_t compare_context(CONTEXT& result, CONTEXT& target, reg_overwrites& outs, bool flags);
 uint64_t* get_value(CONTEXT& new_context, std::string& reg);
 
-// imul and mul tests are cooked
 const std::string inclusive_tests[] = {
     "add",
     "dec",
@@ -41,13 +52,84 @@ const std::string inclusive_tests[] = {
     "mov",
     "movsx",
     "sub",
-    "cmp"
+    "cmp",
+    "and",
+    "or",
+    "xor",
+    "not",
+    "neg",
+    "test",
+    "adc",
+    "sbb",
+    "shl",
+    "shr",
+    "sar",
+    "rol",
+    "ror",
+    "movzx",
+    "movsxd",
+    "xchg",
+    "cmovb",
+    "cmovbe",
+    "cmovl",
+    "cmovle",
+    "cmovnb",
+    "cmovnbe",
+    "cmovnl",
+    "cmovnle",
+    "cmovno",
+    "cmovnp",
+    "cmovns",
+    "cmovnz",
+    "cmovo",
+    "cmovp",
+    "cmovs",
+    "cmovz",
+    "setb",
+    "setbe",
+    "setl",
+    "setle",
+    "setnb",
+    "setnbe",
+    "setnl",
+    "setnle",
+    "setno",
+    "setnp",
+    "setns",
+    "setnz",
+    "seto",
+    "setp",
+    "sets",
+    "setz",
+    "movsb",
+    "movsw",
+    "movsq",
+    "stosb",
+    "stosw",
+    "stosd",
+    "stosq",
+    "addsd",
+    "mulsd",
+    "pxor",
+    "movd",
+    "movq",
+    "comisd",
+    "ucomisd",
+    "cvtsi2sd",
+    "cvttsd2si",
+    "div",
+    "idiv",
+    "mul",
+    "imul"
 };
 
 using namespace eagle;
 
+// address compiled sections get mapped at when they run in the interpreter
+constexpr uint64_t interpret_base = 0x140000000;
+
 void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohmann::basic_json<>& test, std::atomic_uint32_t* passed,
-    std::atomic_uint32_t* failed, uint32_t task_id)
+    std::atomic_uint32_t* failed, uint32_t task_id, const bool interpret)
 {
     std::stringstream ss;
 
@@ -60,14 +142,15 @@ void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohman
 
     // i dont know what else to do
     // you cannot just use VEH to recover RIP/RSP corruption
-    if (instr.contains("sp"))
+    // the interpreter never touches the real stack so it can run these
+    if (!interpret && instr.contains("sp"))
         return;
 
     bool bp = false;
     if (test.contains("bp"))
         bp = test["bp"];
 
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_WIN32)
     if (bp)
         __debugbreak();
 #endif
@@ -85,9 +168,7 @@ void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohman
     reg_overwrites outs = build_writes(outputs);
 
     std::vector<uint8_t> instruction_data = test_util::parse_hex(instr_data);
-    instruction_data.push_back(0x0F);
-    instruction_data.push_back(0x01);
-    instruction_data.push_back(0xC1);
+    instruction_data.append_range(platform::exit_trap);
 
     codec::decode_vec instructions = codec::get_instructions(instruction_data.data(), instruction_data.size());
 
@@ -110,13 +191,24 @@ void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohman
         if (preopt_block->get_original_block() == dasm->get_block(0))
             entry_block = preopt_block;
 
-    assert(entry_block != nullptr, "could not find matching preopt block for entry block");
+    VM_ASSERT(entry_block != nullptr, "could not find matching preopt block for entry block");
 
     // if we want, we can do a little optimzation which will rewrite the preopt blocks
     // or we could simply ir_trans.flatten()
     std::unordered_map<ir::preopt_block_ptr, ir::block_ptr> block_tracker = { { entry_block, nullptr } };
     std::vector<ir::block_vm_id> vm_blocks = ir_trans.optimize(block_vm_ids, block_tracker, { entry_block });
 
+    // fold known immediates before they get turned into handler calls
+    for (auto& blocks : vm_blocks | std::views::keys)
+        for (const auto& block : blocks)
+            ir::constant_fold::run(block);
+
+    // keep decoded context values alive across commands and drop overwritten stores
+    const ir::context_dataflow dataflow(machine_settings->context_cache_registers);
+    for (auto& blocks : vm_blocks | std::views::keys)
+        for (const auto& block : blocks)
+            dataflow.run(block);
+
     // initialize block code labels
     std::unordered_map<ir::block_ptr, asmb::code_label_ptr> block_labels;
     for (auto& blocks : vm_blocks | std::views::keys)
@@ -153,25 +245,53 @@ void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohman
         vm_section.add_code_container(handler_containers);
     }
 
-    constexpr auto run_space_size = 0x500000;
-    uint64_t run_space = reinterpret_cast<uint64_t>(VirtualAlloc(nullptr, run_space_size, MEM_COMMIT, PAGE_EXECUTE_READWRITE));
+    CONTEXT result_context, output_target;
+    std::vector<std::string> trace;
+    if (interpret)
+    {
+        codec::encoded_vec virtualized_instruction = vm_section.compile_section(0, interpret_base);
+
+        interpret_container container(ins, outs);
+        std::tie(result_context, output_target) = container.run(virtualized_instruction, interpret_base);
 
-    codec::encoded_vec virtualized_instruction = vm_section.compile_section(0, run_space);
-    memcpy(reinterpret_cast<void*>(run_space), virtualized_instruction.data(), virtualized_instruction.size());
+        ss << "[interpreter] executed " << std::dec << container.get_executed() << " instructions\n";
+        if (container.get_status() != interp::exec_status::trap)
+        {
+            ss << "[!] run stopped with status " << static_cast<uint32_t>(container.get_status()) << "\n";
+            for (const std::string& line : container.get_trace())
+                ss << "  " << line << "\n";
 
-    assert(run_space_size >= virtualized_instruction.size(), "run space is not big enough");
+            failed->fetch_add(1);
 
-    run_container container(ins, outs);
-    container.set_run_area(run_space, run_space_size);
+            spdlog::get("test")->error(ss.str());
+            spdlog::get("console")->error("instruction {} failed", instr.c_str());
+            return;
+        }
 
-    spdlog::get("console")->info("starting {} run at {:x} {:x} bytes", instr.c_str(), run_space, virtualized_instruction.size());
-#ifdef _DEBUG
-    if(bp)
-        __debugbreak();
+        trace = container.get_trace();
+    }
+    else
+    {
+        constexpr auto run_space_size = 0x500000;
+        uint64_t run_space = reinterpret_cast<uint64_t>(platform::alloc_executable(run_space_size));
+
+        codec::encoded_vec virtualized_instruction = vm_section.compile_section(0, run_space);
+        memcpy(reinterpret_cast<void*>(run_space), virtualized_instruction.data(), virtualized_instruction.size());
+
+        VM_ASSERT(run_space_size >= virtualized_instruction.size(), "run space is not big enough");
+
+        run_container container(ins, outs);
+        container.set_run_area(run_space, run_space_size);
+
+        spdlog::get("console")->info("starting {} run at {:x} {:x} bytes", instr.c_str(), run_space, virtualized_instruction.size());
+#if defined(_DEBUG) && defined(_WIN32)
+        if(bp)
+            __debugbreak();
 #endif
 
-    auto [result_context, output_target] = container.run(bp);
-    VirtualFree(reinterpret_cast<void*>(run_space), 0, MEM_RELEASE);
+        std::tie(result_context, output_target) = container.run(bp);
+        platform::free_executable(reinterpret_cast<void*>(run_space), run_space_size);
+    }
 
     // result_context is being set in the exception handler
     const uint32_t result = compare_context(
@@ -216,6 +336,13 @@ void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohman
             ss << "  out:   " << out_flags << '\n';
         }
 
+        if (!trace.empty())
+        {
+            ss << "[trace]\n";
+            for (const std::string& line : trace)
+                ss << "  " << line << "\n";
+        }
+
         ss << "[!] failed\n";
         failed->fetch_add(1);
 
@@ -226,7 +353,7 @@ void process_entry(const virt::eg::settings_ptr& machine_settings, const nlohman
 
 int main(int argc, char* argv[])
 {
-    SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
+    platform::raise_priority();
 
     // give .handlers and .run_section execute permissions
     // the fact that i have to do this is so extremely cooked
@@ -235,7 +362,11 @@ int main(int argc, char* argv[])
     // so all i can do is create a section 🤣
 
     // setbuf(stdout, NULL);
-    const char* test_data_path = argc > 1 ? argv[1] : "../../../deps/x86_test_data/TestData64";
+    // --interpret runs every test through the interpreter instead of on the host cpu
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const bool interpret = std::erase(args, "--interpret") != 0;
+
+    const std::string test_data_path = !args.empty() ? args[0] : "../../../deps/x86_test_data/TestData64";
     if (!std::filesystem::exists("x86-tests"))
         std::filesystem::create_directory("x86-tests");
 
@@ -260,6 +391,31 @@ int main(int argc, char* argv[])
     machine_settings->shuffle_vm_xmm_order = false;
     machine_settings->relative_addressing = false;
 
+    if (!args.empty() && args[0] == "--dispatch-benchmark")
+    {
+        dispatch_benchmark::run(machine_settings, args.size() > 1 ? std::stoul(args[1]) : 100);
+        run_container::destroy_veh();
+        return 0;
+    }
+
+    if (!args.empty() && args[0] == "--overhead-benchmark")
+    {
+        overhead_benchmark::run(machine_settings, args.size() > 1 ? std::stoul(args[1]) : 100,
+            args.size() > 2 ? args[2] : "overhead_benchmark.json");
+        run_container::destroy_veh();
+        return 0;
+    }
+
+    if (!args.empty() && args[0] == "--pipeline-benchmark")
+    {
+        // anything after the output path is a file of raw code recorded from a real binary
+        pipeline_benchmark::run(machine_settings, args.size() > 1 ? std::stoul(args[1]) : 3,
+            args.size() > 2 ? args[2] : "pipeline_benchmark.json",
+            args.size() > 3 ? std::vector(args.begin() + 3, args.end()) : std::vector<std::string>());
+        run_container::destroy_veh();
+        return 0;
+    }
+
     // loop each file that test_data_path contains
     for (const auto& entry : std::filesystem::directory_iterator(test_data_path))
     {
@@ -281,17 +437,28 @@ int main(int argc, char* argv[])
         std::atomic_uint32_t passed = 0;
         std::atomic_uint32_t failed = 0;
 
-        std::atomic_uint32_t task_id;
+        std::vector<const nlohmann::json*> tests;
+        for (const auto& n : data)
+            tests.push_back(&n);
+
+        // workers pull tests off a shared index, libstdc++ runs parallel algorithms serially without tbb
+        std::atomic_uint32_t task_id = 0;
 #ifdef _DEBUG
-        auto execution_policy = std::execution::seq;
+        const uint32_t worker_count = 1;
 #else
-        auto execution_policy = std::execution::par_unseq;
+        const uint32_t worker_count = (std::max)(1u, std::thread::hardware_concurrency());
 #endif
-        std::for_each(execution_policy, data.begin(), data.end(), [&](auto& n)
         {
-            const auto current_task_id = task_id++;
-            process_entry(machine_settings, n, &passed, &failed, current_task_id);
-        });
+            std::vector<std::jthread> workers;
+            for (uint32_t i = 0; i < worker_count; i++)
+            {
+                workers.emplace_back([&]
+                {
+                    for (uint32_t current_task_id = task_id++; current_task_id < tests.size(); current_task_id = task_id++)
+                        process_entry(machine_settings, *tests[current_task_id], &passed, &failed, current_task_id, interpret);
+                });
+            }
+        }
 
         spdlog::get("console")->info("finished generating {} tests for: {}", passed + failed, file_name);
         spdlog::get("console")->info("passed {}", passed.load());
@@ -318,7 +485,7 @@ reg_overwrites build_writes(nlohmann::json& inputs)
         {
             std::string str = input.value();
             value = std::stoull(str, nullptr, 16);
-            value = _byteswap_uint64(value);
+            value = std::byteswap(value);
         }
         else
         {
@@ -0,0 +1,196 @@
+#include "overhead_benchmark.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
+#include "spdlog/spdlog.h"
+
+#include "benchmark_util.h"
+#include "platform.h"
+#include "eaglevm-core/interpreter/interpreter.h"
+
+using namespace eagle;
+
+namespace overhead_benchmark
+{
+    struct kernel
+    {
+        std::string name;
+        std::vector<uint8_t> bytes;
+    };
+
+    const std::vector<kernel> kernels = {
+        {
+            "arithmetic_loop", {
+                0xB9, 0x00, 0x01, 0x00, 0x00, // mov ecx, 0x100
+                0x48, 0x01, 0xD8, // loop: add rax, rbx
+                0x48, 0x31, 0xC3, // xor rbx, rax
+                0x48, 0xC1, 0xC0, 0x0D, // rol rax, 13
+                0x48, 0x8D, 0x04, 0x80, // lea rax, [rax + rax * 4]
+                0xFF, 0xC9, // dec ecx
+                0x75, 0xEE, // jnz loop
+            }
+        },
+        {
+            "memory_loop", {
+                0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00, // sub rsp, 0x100
+                0xB9, 0x20, 0x00, 0x00, 0x00, // mov ecx, 0x20
+                0x48, 0x89, 0x44, 0xCC, 0xF8, // loop: mov [rsp + rcx * 8 - 8], rax
+                0x48, 0x03, 0x5C, 0xCC, 0xF8, // add rbx, [rsp + rcx * 8 - 8]
+                0x48, 0xFF, 0xC0, // inc rax
+                0xFF, 0xC9, // dec ecx
+                0x75, 0xEF, // jnz loop
+                0x48, 0x81, 0xC4, 0x00, 0x01, 0x00, 0x00, // add rsp, 0x100
+            }
+        },
+        {
+            "branchy_loop", {
+                0xB9, 0x00, 0x01, 0x00, 0x00, // mov ecx, 0x100
+                0xF6, 0xC1, 0x01, // loop: test cl, 1
+                0x74, 0x03, // jz skip
+                0x48, 0x01, 0xC8, // add rax, rcx
+                0x48, 0x31, 0xD8, // skip: xor rax, rbx
+                0xF6, 0xC1, 0x02, // test cl, 2
+                0x75, 0x03, // jnz skip_inc
+                0x48, 0xFF, 0xC3, // inc rbx
+                0xFF, 0xC9, // skip_inc: dec ecx
+                0x75, 0xE9, // jnz loop
+            }
+        },
+    };
+
+    struct settings_variant
+    {
+        std::string name;
+        std::function<void(virt::eg::settings&)> apply;
+    };
+
+    const std::vector<settings_variant> variants = {
+        { "baseline", [](virt::eg::settings&) { } },
+        { "threaded_dispatch", [](virt::eg::settings& settings) { settings.threaded_dispatch = true; } },
+        { "no_context_cache", [](virt::eg::settings& settings) { settings.context_cache_registers = 0; } },
+    };
+
+    constexpr uint32_t run_space_size = 0x500000;
+    constexpr uint64_t max_steps = 100'000'000;
+
+    struct dynamic_counts
+    {
+        uint64_t instructions = 0;
+        uint64_t ir_commands = 0;
+    };
+
+    // counts what actually executes, every block entry adds the ir commands of that block
+    dynamic_counts count(const codec::encoded_vec& code, const uint64_t base, const std::vector<std::pair<uint64_t, size_t>>& block_entries)
+    {
+        std::unordered_map<uint64_t, size_t> commands_at;
+        for (const auto& [address, commands] : block_entries)
+            commands_at[address] += commands;
+
+        interp::memory memory;
+        memory.load(base, code.data(), code.size());
+        memory.set_lazy(true);
+
+        interp::interpreter interpreter(memory);
+        interpreter.get_state().rip = base;
+        interpreter.get_state().gpr[ZYDIS_REGISTER_RSP - ZYDIS_REGISTER_RAX] = 0x7FFFFFF00000;
+
+        dynamic_counts counts;
+        interpreter.set_trace([&](const interp::cpu_state& state, const codec::dec::inst_info&)
+        {
+            if (const auto it = commands_at.find(state.rip); it != commands_at.end())
+                counts.ir_commands += it->second;
+        });
+
+        if (interpreter.run(max_steps) != interp::exec_status::trap)
+            spdlog::get("console")->warn("overhead benchmark kernel did not reach the exit trap in the interpreter");
+
+        counts.instructions = interpreter.get_executed();
+        return counts;
+    }
+
+    void run(const virt::eg::settings_ptr& base_settings, const uint32_t iterations, const std::string& output_path)
+    {
+        const uint64_t run_space = reinterpret_cast<uint64_t>(platform::alloc_executable(run_space_size));
+
+        // native runs are measured once, they do not depend on the settings
+        const uint64_t native_empty_cycles = benchmark_util::measure(platform::exit_trap, run_space, run_space_size, iterations);
+
+        nlohmann::json results = nlohmann::json::array();
+        for (const auto& [kernel_name, bytes] : kernels)
+        {
+            std::vector<uint8_t> native = bytes;
+            native.append_range(platform::exit_trap);
+
+            const uint64_t native_full_cycles = benchmark_util::measure(native, run_space, run_space_size, iterations);
+            const uint64_t native_cycles = native_full_cycles - (std::min)(native_full_cycles, native_empty_cycles);
+            const dynamic_counts native_counts = count(native, run_space, { });
+
+            for (const auto& [variant_name, apply] : variants)
+            {
+                const virt::eg::settings_ptr settings = std::make_shared<virt::eg::settings>(*base_settings);
+                apply(*settings);
+
+                // the empty build only enters and leaves the vm, subtracting it leaves the cost of the kernel
+                const benchmark_util::build_result empty = benchmark_util::build(settings, { }, run_space);
+                const benchmark_util::build_result full = benchmark_util::build(settings, bytes, run_space);
+                if (full.code.size() > run_space_size)
+                {
+                    spdlog::get("console")->error("{} does not fit in the run space", kernel_name);
+                    continue;
+                }
+
+                const uint64_t empty_cycles = benchmark_util::measure(empty.code, run_space, run_space_size, iterations);
+                const uint64_t full_cycles = benchmark_util::measure(full.code, run_space, run_space_size, iterations);
+                const uint64_t virtual_cycles = full_cycles - (std::min)(full_cycles, empty_cycles);
+
+                const dynamic_counts virtual_counts = count(full.code, run_space, full.block_entries);
+
+                const double slowdown = native_cycles ? static_cast<double>(virtual_cycles) / native_cycles : 0.0;
+                const double ir_commands_per_instruction = native_counts.instructions
+                    ? static_cast<double>(virtual_counts.ir_commands) / native_counts.instructions
+                    : 0.0;
+                const double size_expansion = static_cast<double>(full.code.size()) / bytes.size();
+
+                results.push_back({
+                    { "kernel", kernel_name },
+                    { "settings", {
+                        { "name", variant_name },
+                        { "threaded_dispatch", settings->threaded_dispatch },
+                        { "context_cache_registers", settings->context_cache_registers },
+                        { "single_vm_handlers", settings->single_vm_handlers },
+                        { "relative_addressing", settings->relative_addressing },
+                    } },
+                    { "native_cycles", native_cycles },
+                    { "virtual_cycles", virtual_cycles },
+                    { "slowdown", slowdown },
+                    { "native_instructions", native_counts.instructions },
+                    { "virtual_instructions", virtual_counts.instructions },
+                    { "executed_ir_commands", virtual_counts.ir_commands },
+                    { "ir_commands_per_instruction", ir_commands_per_instruction },
+                    { "native_size", bytes.size() },
+                    { "virtual_size", full.code.size() },
+                    { "size_expansion", size_expansion },
+                });
+
+                spdlog::get("console")->info("{} ({}): {:.1f}x slower, {:.2f} ir commands per instruction, {:.1f}x code size",
+                    kernel_name, variant_name, slowdown, ir_commands_per_instruction, size_expansion);
+            }
+        }
+
+        platform::free_executable(reinterpret_cast<void*>(run_space), run_space_size);
+
+        const nlohmann::json output = {
+            { "iterations", iterations },
+            { "results", results },
+        };
+
+        std::ofstream file(output_path);
+        file << output.dump(4);
+
+        spdlog::get("console")->info("wrote overhead benchmark results to {}", output_path);
+    }
+}
@@ -0,0 +1,210 @@
+#include "pipeline_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+
+#include "nlohmann/json.hpp"
+#include "spdlog/spdlog.h"
+
+#include "alloc_tracker.h"
+#include "benchmark_util.h"
+#include "platform.h"
+#include "eaglevm-core/codec/zydis_helper.h"
+#include "eaglevm-core/disassembler/disassembler.h"
+#include "eaglevm-core/disassembler/analysis/liveness.h"
+
+using namespace eagle;
+
+namespace pipeline_benchmark
+{
+    // instructions the synthetic streams are made of, all supported by the lifter
+    const std::vector<std::vector<uint8_t>> synthetic_pool = {
+        { 0x48, 0x01, 0xD8 }, // add rax, rbx
+        { 0x48, 0x29, 0xCA }, // sub rdx, rcx
+        { 0x48, 0x31, 0xC3 }, // xor rbx, rax
+        { 0x48, 0x21, 0xD1 }, // and rcx, rdx
+        { 0x48, 0x09, 0xF0 }, // or rax, rsi
+        { 0x48, 0xC1, 0xC0, 0x0D }, // rol rax, 13
+        { 0x48, 0xC1, 0xEA, 0x03 }, // shr rdx, 3
+        { 0x48, 0x8D, 0x04, 0x80 }, // lea rax, [rax + rax * 4]
+        { 0x49, 0x89, 0xD0 }, // mov r8, rdx
+        { 0x48, 0x0F, 0x44, 0xC1 }, // cmovz rax, rcx
+        { 0x48, 0x89, 0x44, 0x24, 0x08 }, // mov [rsp + 8], rax
+        { 0x48, 0x8B, 0x5C, 0x24, 0x10 }, // mov rbx, [rsp + 0x10]
+        { 0x48, 0x83, 0xC1, 0x10 }, // add rcx, 0x10
+        { 0x48, 0x85, 0xC0 }, // test rax, rax
+    };
+
+    // a conditional jump over the next instruction ends a block every few instructions
+    constexpr uint32_t instructions_per_branch = 8;
+
+    const uint32_t synthetic_sizes[] = { 256, 1024, 4096, 16384 };
+
+    // fixed so the same streams are compared between commits
+    constexpr uint32_t synthetic_seed = 0xEA61E;
+
+    struct stream
+    {
+        std::string name;
+        std::vector<uint8_t> bytes;
+    };
+
+    std::vector<uint8_t> generate_synthetic(const uint32_t instruction_count)
+    {
+        std::mt19937 generator(synthetic_seed);
+
+        std::vector<uint8_t> bytes;
+        for (uint32_t i = 0; i < instruction_count; i++)
+        {
+            const auto& inst = synthetic_pool[generator() % synthetic_pool.size()];
+            if (i % instructions_per_branch == instructions_per_branch - 1)
+            {
+                // jnz over the instruction that follows
+                bytes.push_back(0x75);
+                bytes.push_back(static_cast<uint8_t>(inst.size()));
+                i++;
+            }
+
+            bytes.append_range(inst);
+        }
+
+        return bytes;
+    }
+
+    struct stage_result
+    {
+        std::chrono::nanoseconds time = std::chrono::nanoseconds::max();
+        alloc_tracker::snapshot allocations;
+    };
+
+    class stage_timer
+    {
+    public:
+        explicit stage_timer(std::vector<std::pair<std::string, stage_result>>& results)
+            : results(results)
+        {
+        }
+
+        /**
+         * runs a single stage, keeping the fastest time seen for it across repeats
+         */
+        template <typename T>
+        void measure(const std::string& name, T&& stage)
+        {
+            alloc_tracker::begin();
+            const auto start = std::chrono::steady_clock::now();
+
+            stage();
+
+            const auto end = std::chrono::steady_clock::now();
+            const alloc_tracker::snapshot allocations = alloc_tracker::end();
+
+            auto it = std::ranges::find(results, name, &std::pair<std::string, stage_result>::first);
+            if (it == results.end())
+                it = results.insert(results.end(), { name, { } });
+
+            stage_result& result = it->second;
+            if (end - start < result.time)
+                result.time = end - start;
+
+            result.allocations = allocations;
+        }
+
+    private:
+        std::vector<std::pair<std::string, stage_result>>& results;
+    };
+
+    void run_pipeline(const virt::eg::settings_ptr& settings, const std::vector<uint8_t>& bytes, stage_timer& timer)
+    {
+        // liveness is only used by the driver so it is not part of the shared build, it still gets timed on its own
+        std::vector<uint8_t> instruction_data = bytes;
+        instruction_data.append_range(platform::exit_trap);
+
+        codec::decode_vec instructions = codec::get_instructions(instruction_data.data(), instruction_data.size());
+        dasm::segment_dasm_ptr dasm = std::make_shared<dasm::segment_dasm>(std::move(instructions), 0, instruction_data.size());
+        dasm->generate_blocks();
+
+        timer.measure("liveness", [&]
+        {
+            dasm::analysis::liveness liveness(dasm);
+            liveness.compute_use_def();
+            liveness.analyze_cross_liveness(dasm->blocks.back());
+        });
+
+        benchmark_util::build(settings, bytes, 0, [&timer](const char* stage, const std::function<void()>& run)
+        {
+            timer.measure(stage, run);
+        });
+    }
+
+    void run(const virt::eg::settings_ptr& base_settings, const uint32_t repeats, const std::string& output_path,
+        const std::vector<std::string>& recorded_paths)
+    {
+        std::vector<stream> streams;
+        for (const uint32_t size : synthetic_sizes)
+            streams.emplace_back("synthetic_" + std::to_string(size), generate_synthetic(size));
+
+        for (const std::string& path : recorded_paths)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                spdlog::get("console")->error("unable to open recorded stream {}", path);
+                continue;
+            }
+
+            streams.emplace_back(path, std::vector<uint8_t>(std::istreambuf_iterator(file), { }));
+        }
+
+        nlohmann::json results = nlohmann::json::array();
+        for (const auto& [name, bytes] : streams)
+        {
+            const size_t instruction_count = codec::get_instructions(const_cast<uint8_t*>(bytes.data()), bytes.size()).size();
+
+            std::vector<std::pair<std::string, stage_result>> stages;
+            stage_timer timer(stages);
+            for (uint32_t i = 0; i < repeats; i++)
+                run_pipeline(base_settings, bytes, timer);
+
+            nlohmann::json stage_results = nlohmann::json::array();
+            for (const auto& [stage, result] : stages)
+            {
+                const double seconds = std::chrono::duration<double>(result.time).count();
+                const double instructions_per_second = seconds > 0 ? instruction_count / seconds : 0.0;
+
+                stage_results.push_back({
+                    { "stage", stage },
+                    { "seconds", seconds },
+                    { "instructions_per_second", instructions_per_second },
+                    { "allocations", result.allocations.allocations },
+                    { "allocated_bytes", result.allocations.allocated_bytes },
+                    { "peak_bytes", result.allocations.peak_bytes },
+                });
+
+                spdlog::get("console")->info("{} {}: {:.3f} ms, {:.0f} instructions/s, {} allocations, {} peak bytes",
+                    name, stage, seconds * 1000, instructions_per_second, result.allocations.allocations, result.allocations.peak_bytes);
+            }
+
+            results.push_back({
+                { "stream", name },
+                { "instructions", instruction_count },
+                { "bytes", bytes.size() },
+                { "stages", stage_results },
+            });
+        }
+
+        const nlohmann::json output = {
+            { "repeats", repeats },
+            { "results", results },
+        };
+
+        std::ofstream file(output_path);
+        file << output.dump(4);
+
+        spdlog::get("console")->info("wrote pipeline benchmark results to {}", output_path);
+    }
+}
@@ -0,0 +1,35 @@
+#include "platform.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+void* platform::alloc_executable(const size_t size)
+{
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+#else
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+#endif
+}
+
+void platform::free_executable(void* address, const size_t size)
+{
+#ifdef _WIN32
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    munmap(address, size);
+#endif
+}
+
+void platform::raise_priority()
+{
+#ifdef _WIN32
+    SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
+#else
+    // lowering niceness needs privileges, running at the default is fine without them
+    setpriority(PRIO_PROCESS, 0, -10);
+#endif
+}
@@ -1,9 +1,12 @@
 #include "run_container.h"
 
-#include <intrin.h>
 #include <iostream>
 #include "util.h"
 
+// the linux side of running a test lives in run_container_linux.cpp
+#ifdef _WIN32
+#include <intrin.h>
+
 #pragma optimize("", off)
 std::pair<CONTEXT, CONTEXT> run_container::run(const bool bp)
 {
@@ -49,6 +52,7 @@ std::pair<CONTEXT, CONTEXT> run_container::run(const bool bp)
     return { result_context, output_target };
 }
 #pragma optimize("", on)
+#endif
 
 void run_container::set_result_context(const PCONTEXT result)
 {
@@ -91,6 +95,7 @@ void* run_container::get_run_area() const
     return run_area;
 }
 
+#ifdef _WIN32
 void run_container::init_veh()
 {
     veh_handle = AddVectoredExceptionHandler(1, veh_handler);
@@ -100,6 +105,7 @@ void run_container::destroy_veh()
 {
     RemoveVectoredExceptionHandler(veh_handler);
 }
+#endif
 
 CONTEXT run_container::build_context(const CONTEXT& safe, reg_overwrites& writes)
 {
@@ -119,6 +125,7 @@ CONTEXT run_container::clear_context(const CONTEXT& safe, reg_overwrites& writes
     return new_context;
 }
 
+#ifdef _WIN32
 LONG run_container::veh_handler(EXCEPTION_POINTERS* info)
 {
     const uint64_t current_rip = info->ContextRecord->Rip;
@@ -149,3 +156,4 @@ LONG run_container::veh_handler(EXCEPTION_POINTERS* info)
 
     return EXCEPTION_CONTINUE_SEARCH;
 }
+#endif
@@ -0,0 +1,153 @@
+#include "run_container.h"
+
+// the windows side of running a test lives in run_container.cpp
+#ifndef _WIN32
+#include <cstring>
+
+namespace
+{
+    // the container waiting on its entry trap, the trap is raised and handled on the same thread
+    thread_local run_container* entering = nullptr;
+
+    // red zone plus some space so the vm does not touch anything live below the trap
+    constexpr uint64_t entry_stack_gap = 0x1000;
+
+    CONTEXT read_gregs(const greg_t* gregs)
+    {
+        CONTEXT context = { };
+        context.Rax = gregs[REG_RAX];
+        context.Rcx = gregs[REG_RCX];
+        context.Rdx = gregs[REG_RDX];
+        context.Rbx = gregs[REG_RBX];
+        context.Rsp = gregs[REG_RSP];
+        context.Rbp = gregs[REG_RBP];
+        context.Rsi = gregs[REG_RSI];
+        context.Rdi = gregs[REG_RDI];
+        context.R8 = gregs[REG_R8];
+        context.R9 = gregs[REG_R9];
+        context.R10 = gregs[REG_R10];
+        context.R11 = gregs[REG_R11];
+        context.R12 = gregs[REG_R12];
+        context.R13 = gregs[REG_R13];
+        context.R14 = gregs[REG_R14];
+        context.R15 = gregs[REG_R15];
+        context.Rip = gregs[REG_RIP];
+        context.EFlags = static_cast<uint32_t>(gregs[REG_EFL]);
+
+        return context;
+    }
+
+    void write_gregs(greg_t* gregs, const CONTEXT& context)
+    {
+        gregs[REG_RAX] = static_cast<greg_t>(context.Rax);
+        gregs[REG_RCX] = static_cast<greg_t>(context.Rcx);
+        gregs[REG_RDX] = static_cast<greg_t>(context.Rdx);
+        gregs[REG_RBX] = static_cast<greg_t>(context.Rbx);
+        gregs[REG_RSP] = static_cast<greg_t>(context.Rsp);
+        gregs[REG_RBP] = static_cast<greg_t>(context.Rbp);
+        gregs[REG_RSI] = static_cast<greg_t>(context.Rsi);
+        gregs[REG_RDI] = static_cast<greg_t>(context.Rdi);
+        gregs[REG_R8] = static_cast<greg_t>(context.R8);
+        gregs[REG_R9] = static_cast<greg_t>(context.R9);
+        gregs[REG_R10] = static_cast<greg_t>(context.R10);
+        gregs[REG_R11] = static_cast<greg_t>(context.R11);
+        gregs[REG_R12] = static_cast<greg_t>(context.R12);
+        gregs[REG_R13] = static_cast<greg_t>(context.R13);
+        gregs[REG_R14] = static_cast<greg_t>(context.R14);
+        gregs[REG_R15] = static_cast<greg_t>(context.R15);
+        gregs[REG_RIP] = static_cast<greg_t>(context.Rip);
+        gregs[REG_EFL] = static_cast<greg_t>(context.EFlags);
+    }
+}
+
+std::pair<CONTEXT, CONTEXT> run_container::run(const bool bp)
+{
+    // there is no captured context to start from, registers the test does not write start at zero
+    CONTEXT input_target = clear_context({ }, output_writes);
+    input_target = build_context(input_target, input_writes);
+
+    CONTEXT output_target = build_context({ }, output_writes);
+
+    // the signal handler moves both of these to where the run area actually gets entered
+    const int64_t rip_diff = output_target.Rip - input_target.Rip;
+    input_target.Rip = reinterpret_cast<uint64_t>(run_area);
+    output_target.Rip = input_target.Rip + rip_diff;
+
+    const int64_t rsp_diff = output_target.Rsp - input_target.Rsp;
+    input_context = input_target;
+
+    if (bp)
+        raise(SIGTRAP);
+
+    add_veh();
+
+    // the handler swaps this thread into the run area, the exit trap at the end swaps it back to right after the ud2
+    entering = this;
+    asm volatile("ud2" ::: "memory");
+
+    remove_veh();
+
+    output_target.Rsp = safe_context.Rsp - entry_stack_gap + rsp_diff;
+    return { result_context, output_target };
+}
+
+void run_container::init_veh()
+{
+    struct sigaction action = { };
+    action.sa_sigaction = signal_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    // the exit trap is #UD, anything the vm breaks along the way shows up as a segfault
+    sigaction(SIGILL, &action, nullptr);
+    sigaction(SIGSEGV, &action, nullptr);
+}
+
+void run_container::destroy_veh()
+{
+    signal(SIGILL, SIG_DFL);
+    signal(SIGSEGV, SIG_DFL);
+}
+
+void run_container::signal_handler(const int signal, siginfo_t* info, void* context)
+{
+    ucontext_t* ucontext = static_cast<ucontext_t*>(context);
+    greg_t* gregs = ucontext->uc_mcontext.gregs;
+
+    if (run_container* container = entering; container && signal == SIGILL)
+    {
+        entering = nullptr;
+
+        // resume after the ud2 once the run is over
+        memcpy(container->safe_gregs, gregs, sizeof(gregset_t));
+        container->safe_gregs[REG_RIP] += 2;
+        container->safe_fpu = *ucontext->uc_mcontext.fpregs;
+        container->safe_context = read_gregs(container->safe_gregs);
+
+        CONTEXT input_target = container->input_context;
+        input_target.Rsp = container->safe_context.Rsp - entry_stack_gap;
+
+        write_gregs(gregs, input_target);
+        return;
+    }
+
+    const uint64_t current_rip = gregs[REG_RIP];
+    std::lock_guard lock(run_tests_mutex);
+
+    for (auto& [key, ranges] : run_tests)
+    {
+        auto [low, size] = ranges;
+        if (low <= current_rip && current_rip <= low + size)
+        {
+            key->result_context = read_gregs(gregs);
+
+            memcpy(gregs, key->safe_gregs, sizeof(gregset_t));
+            *ucontext->uc_mcontext.fpregs = key->safe_fpu;
+            return;
+        }
+    }
+
+    // not a fault from a run area, let it crash the way it normally would once the instruction runs again
+    ::signal(signal, SIG_DFL);
+}
+#endif
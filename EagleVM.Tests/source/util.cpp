@@ -1,5 +1,6 @@
 #include "util.h"
 
+#include <bit>
 #include <fstream>
 
 std::vector<uint8_t> test_util::parse_hex(const std::string& hex)
@@ -30,7 +31,7 @@ void test_util::print_regs(nlohmann::json& inputs, std::stringstream& stream)
         {
             std::string str = input.value();
             value = std::stoull(str, nullptr, 16);
-            value = _byteswap_uint64(value);
+            value = std::byteswap(value);
         }
 
         stream << "  " << key << " : 0x" << std::hex << value << "\n";
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace eagle::vmprof
+{
+    struct counter_entry
+    {
+        // offset of the 8 byte counter inside the .vmprof section
+        uint64_t offset = 0;
+        uint32_t vm_id = 0;
+
+        uint64_t handler_rva = 0;
+
+        // start rvas of the original blocks which call the handler
+        std::vector<uint64_t> caller_rvas;
+
+        std::string name;
+    };
+
+    /**
+    * line based description of the .vmprof section written next to the protected binary
+    *
+    * section <rva> <size>
+    * counter <offset> <vm id> <handler rva> <caller rvas separated by commas or -> <name>
+    */
+    struct manifest
+    {
+        uint64_t section_rva = 0;
+        uint64_t section_size = 0;
+
+        std::vector<counter_entry> counters;
+
+        [[nodiscard]] std::string to_string() const;
+        static bool parse(std::istream& stream, manifest& out);
+    };
+
+    /**
+    * prints every handler sorted by how often it ran
+    * @param manifest_path manifest written while protecting
+    * @param dump_path raw copy of the .vmprof section taken from the running process
+    * @return process exit code
+    */
+    int print_report(const std::string& manifest_path, const std::string& dump_path);
+}
@@ -1,7 +1,12 @@
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
 #include <ranges>
+#include <unordered_set>
 
 #include "eaglevm-core/compiler/section_manager.h"
+#include "eaglevm-core/pe/mapped_image.h"
 #include "eaglevm-core/pe/pe_generator.h"
 #include "eaglevm-core/pe/packer/pe_packer.h"
 
@@ -11,38 +16,107 @@
 #include "eaglevm-core/disassembler/analysis/liveness.h"
 #include "eaglevm-core/pe/models/stub.h"
 #include "eaglevm-core/virtual_machine/ir/ir_translator.h"
+#include "eaglevm-core/virtual_machine/ir/profile_guide.h"
+#include "eaglevm-core/virtual_machine/ir/region_graph.h"
+#include "eaglevm-core/virtual_machine/ir/passes/constant_fold.h"
+#include "eaglevm-core/virtual_machine/ir/passes/context_dataflow.h"
 
 #include "eaglevm-core/virtual_machine/machines/pidgeon/inst_handlers.h"
 #include "eaglevm-core/virtual_machine/machines/pidgeon/machine.h"
 
+#include "eaglevm-core/virtual_machine/machines/eagle/cost_model.h"
 #include "eaglevm-core/virtual_machine/machines/eagle/machine.h"
+#include "eaglevm-core/virtual_machine/protection_stats.h"
+
+#include "eaglevm-core/util/profiler.h"
+
+#include "vmprof.h"
 
 using namespace eagle;
 
 int main(int argc, char* argv[])
 {
-    auto executable = argc > 1 ? argv[1] : "EagleVMSandbox.exe";
-    auto parsing_type = argc > 2 ? argv[2] : nullptr;
+    // --profile records the time spent in every stage and writes it out as a chrome trace
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const bool profile = std::erase(args, "--profile") != 0;
+    util::profiler::set_enabled(profile);
+
+    // --vmprof-report <manifest> <dump> reads the handler counters dumped from a binary protected with --profile-handlers
+    if (const auto report = std::ranges::find(args, "--vmprof-report"); report != args.end())
+    {
+        if (std::distance(report, args.end()) < 3)
+        {
+            std::printf("[!] usage: --vmprof-report <manifest> <dump>\n");
+            return EXIT_FAILURE;
+        }
+
+        return vmprof::print_report(*(report + 1), *(report + 2));
+    }
 
-    std::ifstream file(executable, std::ios::binary | std::ios::ate);
-    if (!file.is_open())
+    // --profile-handlers gives every handler a counter in a .vmprof section
+    const bool profile_handlers = std::erase(args, "--profile-handlers") != 0;
+
+    auto take_option = [&args](const std::string& name) -> std::optional<std::string>
+    {
+        const auto option = std::ranges::find(args, name);
+        if (option == args.end() || option + 1 == args.end())
+            return std::nullopt;
+
+        std::string value = *(option + 1);
+        args.erase(option, option + 2);
+
+        return value;
+    };
+
+    // --block-profile <file> lists how often each original block ran, hot blocks get lighter machine settings
+    // --slowdown-budget <x> is the estimated slowdown the hot blocks are picked for
+    const std::optional<std::string> block_profile_path = take_option("--block-profile");
+    const std::optional<std::string> slowdown_budget = take_option("--slowdown-budget");
+
+    // --block-costs <file> hands the cycle estimates written by a previous run to the profile guided settings
+    const std::optional<std::string> block_costs_path = take_option("--block-costs");
+
+    ir::block_profile block_profile;
+    if (block_profile_path && !block_profile.load(block_profile_path.value()))
     {
-        std::printf("[!] failed to open file: %s\n", executable);
+        std::printf("[!] failed to read block profile: %s\n", block_profile_path->c_str());
         return EXIT_FAILURE;
     }
 
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    ir::block_profile block_costs;
+    if (block_costs_path && !block_costs.load(block_costs_path.value()))
+    {
+        std::printf("[!] failed to read block costs: %s\n", block_costs_path->c_str());
+        return EXIT_FAILURE;
+    }
 
-    char* buffer = new char[size + 1];
-    if (!file.read(buffer, size))
+    // same rules as the profile files, the whole value has to parse
+    double budget = 20.0;
+    if (slowdown_budget)
     {
-        std::printf("[!] failed to read file: %s\n", executable);
+        char* budget_end = nullptr;
+        budget = std::strtod(slowdown_budget->c_str(), &budget_end);
+
+        if (slowdown_budget->empty() || *budget_end != '\0' || !std::isfinite(budget) || budget <= 0.0)
+        {
+            std::printf("[!] invalid slowdown budget: %s\n", slowdown_budget->c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto executable = !args.empty() ? args[0].c_str() : "EagleVMSandbox.exe";
+    auto parsing_type = args.size() > 1 ? args[1].c_str() : nullptr;
+
+    // the input is mapped read only, the generator copies a section only once it writes to it
+    pe::mapped_image image;
+    if (!image.open(executable))
+    {
+        std::printf("[!] failed to map file: %s\n", executable);
         return EXIT_FAILURE;
     }
 
-    win::image_x64_t* parser = reinterpret_cast<win::image_x64_t*>(buffer);
-    std::printf("[+] loaded %s -> %lld bytes\n", executable, size);
+    win::image_x64_t* parser = image.get_image();
+    std::printf("[+] loaded %s -> %zu bytes\n", executable, image.size());
 
     std::printf("[>] image sections\n");
     std::printf("%3s %-10s %-10s %-10s\n", "", "name", "va", "size");
@@ -232,6 +306,13 @@ int main(int argc, char* argv[])
     asmb::section_manager vm_section(false);
     std::vector<std::shared_ptr<virt::base_machine>> machines_used;
 
+    ir::region_graph regions;
+    virt::protection_stats protection_stats;
+    std::unordered_map<ir::block_ptr, uint64_t> block_rvas;
+    std::unordered_map<uint64_t, size_t> block_native_insts;
+    std::vector<ir::region_ptr> region_list;
+    std::vector<std::pair<ir::preopt_block_ptr, asmb::code_label_ptr>> region_entries;
+
     codec::setup_decoder();
     for (int c = 0; c < vm_iat_calls.size(); c += 2) // i1 = vm_begin, i2 = vm_end
     {
@@ -250,11 +331,8 @@ int main(int argc, char* argv[])
         uint8_t* pinst_end = parser->rva_to_ptr<uint8_t>(rva_inst_end);
 
         /*
-         * this approach is not a good idea, but its easy to solve
-         * the problem is that this gives us a limited scope of the context
-         * there should be some kind of whole-program context builder because then
-         * we will be able to chain every virtualized code section together.
-         * but this creates sort of a mess which i dont really like
+         * every region is still disassembled and translated on its own
+         * branches between regions are chained afterwards by the region graph
          */
 
         codec::decode_vec instructions = codec::get_instructions(pinst_begin, pinst_end - pinst_begin);
@@ -325,15 +403,8 @@ int main(int argc, char* argv[])
         std::printf("[>] dasm found %llu basic blocks\n", dasm->blocks.size());
         std::cout << std::endl;
 
-        ir::ir_translator ir_trans(dasm);
-        ir::preopt_block_vec preopt = ir_trans.translate(true);
-
-        // here we assign vms to each block
-        // for the current example we can assign a unique vm to each block
-        uint32_t vm_index = 0;
-        std::vector<ir::preopt_vm_id> block_vm_ids;
-        for (const auto& preopt_block : preopt)
-            block_vm_ids.emplace_back(preopt_block, vm_index++);
+        const std::shared_ptr<ir::ir_translator> ir_trans = std::make_shared<ir::ir_translator>(dasm);
+        ir::preopt_block_vec preopt = ir_trans->translate(true);
 
         // we want to prevent the vmenter from being removed from the first block, therefore we mark it as an external call
         ir::preopt_block_ptr entry_block = nullptr;
@@ -343,56 +414,25 @@ int main(int argc, char* argv[])
 
         assert(entry_block != nullptr, "could not find matching preopt block for entry block");
 
-        // if we want, we can do a little optimzation which will rewrite the preopt blocks
-        // or we could simply ir_trans.flatten()
-        std::unordered_map<ir::preopt_block_ptr, ir::block_ptr> block_tracker = { { entry_block, nullptr } };
-        std::vector<ir::block_vm_id> vm_blocks = ir_trans.optimize(block_vm_ids, block_tracker, { entry_block });
-
-        // // we want the same settings for every machine
-        // virt::pidg::settings_ptr machine_settings = std::make_shared<virt::pidg::settings>();
-        // machine_settings->set_temp_count(4);
-        // machine_settings->set_randomize_vm_regs(true);
-        // machine_settings->set_randomize_stack_regs(true);
-
-        virt::eg::settings_ptr machine_settings = std::make_shared<virt::eg::settings>();
-        machine_settings->randomize_working_register = false;
-        machine_settings->single_vm_handlers = false;
-
-        machine_settings->shuffle_push_order = true;
-        machine_settings->shuffle_vm_gpr_order = true;
-        machine_settings->shuffle_vm_xmm_order = true;
-
-        // initialize block code labels
-        std::unordered_map<ir::block_ptr, asmb::code_label_ptr> block_labels;
-        for (auto& blocks : vm_blocks | std::views::keys)
-            for (const auto& block : blocks)
-                block_labels[block] = asmb::code_label::create();
+        // here we assign vms to each block
+        // every block gets a unique vm unless the region graph links it to another region
+        const ir::region_ptr region = regions.add_region(dasm, ir_trans, preopt, entry_block);
+        protection_stats.add_region(region, rva_inst_begin, rva_inst_end);
+        region_list.push_back(region);
 
-        asmb::code_label_ptr entry_point = asmb::code_label::create();
-        for (const auto& [blocks, vm_id] : vm_blocks)
+        // handler profiles are reported against the original block that called the handler
+        for (const auto& preopt_block : preopt)
         {
-            // we create a new machine based off of the same settings to make things more annoying
-            // but the same machine could be used :)
-
-            // virt::pidg::machine_ptr machine = virt::pidg::machine::create(machine_settings);
-            virt::eg::machine_ptr machine = virt::eg::machine::create(machine_settings);
-            machines_used.push_back(machine);
+            const uint64_t block_rva = preopt_block->get_original_block()->start_rva;
+            block_native_insts[block_rva] = preopt_block->get_original_block()->decoded_insts.size();
 
-            machine->add_block_context(block_labels);
-
-            for (auto& translated_block : blocks)
-            {
-                asmb::code_container_ptr result_container = machine->lift_block(translated_block);
-                ir::block_ptr block = block_tracker[entry_block];
-                if (block == translated_block)
-                    result_container->bind_start(entry_point);
+            if (preopt_block->has_head())
+                block_rvas[preopt_block->get_head()] = block_rva;
 
-                vm_section.add_code_container(result_container);
-            }
+            for (const ir::block_ptr& body : preopt_block->get_body())
+                block_rvas[body] = block_rva;
 
-            // build handlers
-            std::vector<asmb::code_container_ptr> handler_containers = machine->create_handlers();
-            vm_section.add_code_container(handler_containers);
+            block_rvas[preopt_block->get_tail()] = block_rva;
         }
 
         // overwrite the original instructions
@@ -403,25 +443,227 @@ int main(int argc, char* argv[])
         va_nop.emplace_back(parser->fo_to_rva(vm_iat_calls[c + 1].second), call_size_64);
 
         // add vmenter for root block
+        asmb::code_label_ptr entry_point = asmb::code_label::create();
         va_enters.emplace_back(parser->fo_to_rva(vm_iat_calls[c].second), entry_point);
+        region_entries.emplace_back(entry_block, entry_point);
+    }
+
+    // branches into other regions used to exit the vm and land on code we deleted
+    const uint32_t linked_exits = regions.link();
+    std::printf("[+] linked %u exits between virtualized regions\n", linked_exits);
+
+    // hot blocks of a region are moved into one vm and lifted with the light settings
+    std::unordered_set<uint32_t> hot_vms;
+    if (!block_profile.empty())
+    {
+        ir::profile_guide guide(block_profile, budget);
+        if (!block_costs.empty())
+            guide.set_block_costs(block_costs);
+
+        const ir::profile_plan plan = guide.plan(region_list);
+
+        for (const ir::region_ptr& region : region_list)
+        {
+            std::vector<ir::preopt_block_ptr> hot_blocks;
+            for (const auto& preopt_block : region->blocks | std::views::keys)
+                if (plan.hot_blocks.contains(preopt_block))
+                    hot_blocks.push_back(preopt_block);
+
+            if (!hot_blocks.empty())
+                regions.share_vm(hot_blocks);
+        }
+
+        // sharing can merge the vms of different regions through linked blocks, so the ids are read back afterwards
+        for (const auto& [preopt_block, vm_id] : regions.get_block_vms())
+            if (plan.hot_blocks.contains(preopt_block))
+                hot_vms.insert(vm_id);
+
+        std::printf("[+] block profile marked %zu blocks hot in %zu vms\n", plan.hot_blocks.size(), hot_vms.size());
+        std::printf("\t[>] estimated slowdown: %.2fx heavy, %.2fx planned\n", plan.get_heavy_slowdown(), plan.get_planned_slowdown());
+    }
+
+    // if we want, we can do a little optimzation which will rewrite the preopt blocks
+    // or we could simply ir_translator::flatten()
+    const std::vector<ir::preopt_block_ptr> entry_blocks = regions.get_entry_blocks();
+
+    std::unordered_map<ir::preopt_block_ptr, ir::block_ptr> block_tracker;
+    for (const auto& entry_block : entry_blocks)
+        block_tracker[entry_block] = nullptr;
+
+    std::vector<ir::block_vm_id> vm_blocks = ir::ir_translator::optimize(regions.get_block_vms(), block_tracker, entry_blocks);
+
+    // // we want the same settings for every machine
+    // virt::pidg::settings_ptr machine_settings = std::make_shared<virt::pidg::settings>();
+    // machine_settings->set_temp_count(4);
+    // machine_settings->set_randomize_vm_regs(true);
+    // machine_settings->set_randomize_stack_regs(true);
+
+    virt::eg::settings_ptr machine_settings = std::make_shared<virt::eg::settings>();
+    machine_settings->randomize_working_register = false;
+    machine_settings->single_vm_handlers = false;
+
+    machine_settings->shuffle_push_order = true;
+    machine_settings->shuffle_vm_gpr_order = true;
+    machine_settings->shuffle_vm_xmm_order = true;
+
+    machine_settings->profile_handlers = profile_handlers;
+
+    // hot blocks trade the complex temp loading for threaded dispatch
+    virt::eg::settings_ptr hot_settings = std::make_shared<virt::eg::settings>(*machine_settings);
+    hot_settings->threaded_dispatch = true;
+    hot_settings->complex_temp_loading = false;
+
+    // fold known immediates before they get turned into handler calls
+    for (auto& blocks : vm_blocks | std::views::keys)
+        for (const auto& block : blocks)
+            ir::constant_fold::run(block);
+
+    // keep decoded context values alive across commands and drop overwritten stores
+    const ir::context_dataflow dataflow(machine_settings->context_cache_registers);
+    for (auto& blocks : vm_blocks | std::views::keys)
+        for (const auto& block : blocks)
+            dataflow.run(block);
+
+    // initialize block code labels
+    std::unordered_map<ir::block_ptr, asmb::code_label_ptr> block_labels;
+    for (auto& blocks : vm_blocks | std::views::keys)
+        for (const auto& block : blocks)
+            block_labels[block] = asmb::code_label::create();
+
+    std::unordered_map<ir::block_ptr, asmb::code_label_ptr> entry_labels;
+    for (const auto& [entry_block, entry_point] : region_entries)
+        entry_labels[block_tracker[entry_block]] = entry_point;
+
+    // linked blocks from different regions share a vm id, they have to be lifted by the same machine
+    std::map<uint32_t, std::vector<ir::block_ptr>> vm_groups;
+    for (const auto& [blocks, vm_id] : vm_blocks)
+        vm_groups[vm_id].insert(vm_groups[vm_id].end(), blocks.begin(), blocks.end());
+
+    std::unordered_map<asmb::code_container_ptr, uint64_t> container_rvas;
+    std::vector<std::pair<uint32_t, virt::eg::machine_ptr>> profiled_machines;
+
+    // head, body and tail of an original block all add up to the cost of one execution
+    virt::eg::cost_model cost_model;
+    std::map<uint64_t, virt::eg::container_cost> block_estimates;
+
+    for (const auto& [vm_id, blocks] : vm_groups)
+    {
+        // we create a new machine based off of the same settings to make things more annoying
+        // but the same machine could be used :)
+
+        // virt::pidg::machine_ptr machine = virt::pidg::machine::create(machine_settings);
+        virt::eg::machine_ptr machine = virt::eg::machine::create(hot_vms.contains(vm_id) ? hot_settings : machine_settings);
+        machines_used.push_back(machine);
+
+        machine->add_block_context(block_labels);
+
+        std::vector<asmb::code_container_ptr> block_containers;
+        for (auto& translated_block : blocks)
+        {
+            asmb::code_container_ptr result_container = machine->lift_block(translated_block);
+            block_containers.push_back(result_container);
+
+            if (entry_labels.contains(translated_block))
+                result_container->bind_start(entry_labels[translated_block]);
+
+            protection_stats.add_block(vm_id, translated_block, result_container);
+            if (block_rvas.contains(translated_block))
+                container_rvas[result_container] = block_rvas[translated_block];
+
+            vm_section.add_code_container(result_container);
+        }
+
+        // build handlers
+        std::vector<asmb::code_container_ptr> handler_containers = machine->create_handlers();
+        protection_stats.add_handlers(vm_id, handler_containers);
+
+        cost_model.add_handlers(handler_containers, machine->get_handler_calls());
+        for (const asmb::code_container_ptr& container : block_containers)
+            if (container_rvas.contains(container))
+                block_estimates[container_rvas[container]].add(cost_model.estimate(container));
+
+        if (profile_handlers)
+            profiled_machines.emplace_back(vm_id, machine);
+        vm_section.add_code_container(handler_containers);
+    }
+
+    // rank by total cycles when we know how often each block runs, by cycles per execution otherwise
+    std::vector<std::pair<double, uint64_t>> ranked_blocks;
+    for (const auto& [block_rva, estimate] : block_estimates)
+    {
+        const uint64_t executions = block_profile.empty() ? 1 : block_profile.get_count(block_rva);
+        ranked_blocks.emplace_back(estimate.cycles * static_cast<double>(executions), block_rva);
+    }
+
+    std::ranges::sort(ranked_blocks, std::greater{ });
+
+    std::printf("[+] most expensive virtualized blocks\n");
+    for (const auto& block_rva : ranked_blocks | std::views::values | std::views::take(10))
+    {
+        const virt::eg::container_cost& estimate = block_estimates[block_rva];
+        const size_t native_insts = block_native_insts[block_rva];
+
+        std::printf("\t[>] 0x%llx: %.0f cycles per execution, %.1fx over %zu native instructions\n",
+            static_cast<unsigned long long>(block_rva), estimate.cycles, native_insts ? estimate.cycles / native_insts : 0.0, native_insts);
+        std::printf("\t\t%llu instructions, %llu memory ops, %llu indirect jumps, %llu handler calls\n",
+            static_cast<unsigned long long>(estimate.instructions), static_cast<unsigned long long>(estimate.memory_ops),
+            static_cast<unsigned long long>(estimate.indirect_jumps), static_cast<unsigned long long>(estimate.handler_calls));
     }
 
     std::printf("\n");
 
     win::section_header_t* last_section = parser->get_nt_headers()->get_section(parser->get_nt_headers()->sections().count - 1);
 
-    auto& [code_section, code_section_bytes] = generator.add_section(".hihihi");
-    code_section.ptr_raw_data = last_section->ptr_raw_data + last_section->size_raw_data;
-    code_section.size_raw_data = 0;
-    code_section.virtual_address = generator.align_section(last_section->virtual_address + last_section->virtual_size);
-    code_section.virtual_size = generator.align_section(1);
-
     win::section_characteristics_t characteristics;
     characteristics.mem_read = 1;
     characteristics.mem_execute = 1;
     characteristics.mem_write = 1;
     characteristics.cnt_code = 1;
 
+    // the handlers address their counters relative to VBASE, so the counters are placed before the vm code is compiled
+    vmprof::manifest profile_manifest;
+    win::section_header_t profile_header = { };
+
+    asmb::section_manager profile_sm(false);
+    for (const auto& [vm_id, machine] : profiled_machines)
+        if (const asmb::code_container_ptr counters = machine->create_profile_counters())
+            profile_sm.add_code_container(counters);
+
+    if (!profiled_machines.empty())
+    {
+        auto& [profile_section, profile_section_bytes] = generator.add_section(".vmprof");
+        profile_section.ptr_raw_data = last_section->ptr_raw_data + last_section->size_raw_data;
+        profile_section.virtual_address = generator.align_section(last_section->virtual_address + last_section->virtual_size);
+
+        win::section_characteristics_t profile_characteristics;
+        profile_characteristics.mem_read = 1;
+        profile_characteristics.mem_write = 1;
+        profile_characteristics.cnt_init_data = 1;
+
+        profile_section.characteristics = profile_characteristics;
+        profile_section.ptr_relocs = 0;
+        profile_section.num_relocs = 0;
+        profile_section.num_line_numbers = 0;
+
+        codec::encoded_vec profile_bytes = profile_sm.compile_section(profile_section.virtual_address);
+        profile_section.size_raw_data = generator.align_file(profile_bytes.size());
+        profile_section.virtual_size = generator.align_section(profile_bytes.size());
+        profile_section_bytes += profile_bytes;
+
+        profile_manifest.section_rva = profile_section.virtual_address;
+        profile_manifest.section_size = profile_bytes.size();
+
+        // sections are stored in a vector, adding the code section would leave a pointer to this one dangling
+        profile_header = profile_section;
+        last_section = &profile_header;
+    }
+
+    auto& [code_section, code_section_bytes] = generator.add_section(".hihihi");
+    code_section.ptr_raw_data = last_section->ptr_raw_data + last_section->size_raw_data;
+    code_section.size_raw_data = 0;
+    code_section.virtual_address = generator.align_section(last_section->virtual_address + last_section->virtual_size);
+    code_section.virtual_size = generator.align_section(1);
+
     code_section.characteristics = characteristics;
     code_section.ptr_relocs = 0;
     code_section.num_relocs = 0;
@@ -434,6 +676,27 @@ int main(int argc, char* argv[])
 
     last_section = &code_section;
 
+    for (const auto& [vm_id, machine] : profiled_machines)
+    {
+        for (const virt::eg::profile_counter& counter : machine->get_profile_counters())
+        {
+            vmprof::counter_entry entry;
+            entry.offset = counter.counter->get_address() - profile_manifest.section_rva;
+            entry.vm_id = vm_id;
+            entry.handler_rva = counter.handler->get_address();
+            entry.name = counter.name;
+
+            for (const asmb::code_container_ptr& caller : counter.callers)
+                if (container_rvas.contains(caller))
+                    entry.caller_rvas.push_back(container_rvas[caller]);
+
+            std::ranges::sort(entry.caller_rvas);
+            entry.caller_rvas.erase(std::ranges::unique(entry.caller_rvas).begin(), entry.caller_rvas.end());
+
+            profile_manifest.counters.push_back(entry);
+        }
+    }
+
     // now that the section is compiled we must:
     // delete the code marked by va_delete
     // create jumps marked by va_enters
@@ -481,8 +744,36 @@ int main(int argc, char* argv[])
         );
     }
 
-    generator.save_file("EagleVMSandboxProtected.exe");
+    if (!generator.save_file("EagleVMSandboxProtected.exe"))
+        return EXIT_FAILURE;
+
     std::printf("\n[+] generated output file -> EagleVMSandboxProtected.exe\n");
 
+    std::ofstream stats_file("EagleVMSandboxProtected.stats.json");
+    stats_file << protection_stats.to_json();
+    std::printf("[+] generated protection stats -> EagleVMSandboxProtected.stats.json\n");
+
+    // same "<rva> <value>" format as a block profile so it can be passed back in with --block-costs
+    std::ofstream costs_file("EagleVMSandboxProtected.costs");
+    for (const auto& [block_rva, estimate] : block_estimates)
+        costs_file << "0x" << std::hex << block_rva << " " << std::dec << static_cast<uint64_t>(estimate.cycles + 0.5) << "\n";
+    std::printf("[+] generated block cost estimates -> EagleVMSandboxProtected.costs\n");
+
+    if (profile_handlers)
+    {
+        std::ofstream manifest_file("EagleVMSandboxProtected.vmprof");
+        manifest_file << profile_manifest.to_string();
+        std::printf("[+] generated handler profile manifest -> EagleVMSandboxProtected.vmprof\n");
+    }
+
+    if (profile)
+    {
+        std::ofstream trace_file("EagleVMProfile.json");
+        trace_file << util::profiler::chrome_trace();
+
+        std::printf("\n[>] profile\n%s", util::profiler::summary().c_str());
+        std::printf("[+] generated chrome trace -> EagleVMProfile.json\n");
+    }
+
     return 0;
 }
@@ -0,0 +1,134 @@
+#include "vmprof.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace eagle::vmprof
+{
+    std::string manifest::to_string() const
+    {
+        std::stringstream out;
+        out << std::hex << "section 0x" << section_rva << " 0x" << section_size << "\n";
+
+        for (const counter_entry& counter : counters)
+        {
+            out << "counter 0x" << counter.offset << " " << std::dec << counter.vm_id << " 0x" << std::hex << counter.handler_rva << " ";
+            if (counter.caller_rvas.empty())
+                out << "-";
+
+            for (size_t i = 0; i < counter.caller_rvas.size(); i++)
+                out << (i ? "," : "") << "0x" << counter.caller_rvas[i];
+
+            out << " " << counter.name << "\n";
+        }
+
+        return out.str();
+    }
+
+    bool manifest::parse(std::istream& stream, manifest& out)
+    {
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            std::istringstream line_stream(line);
+
+            std::string kind;
+            line_stream >> kind;
+
+            if (kind == "section")
+            {
+                line_stream >> std::hex >> out.section_rva >> out.section_size;
+            }
+            else if (kind == "counter")
+            {
+                counter_entry counter;
+
+                std::string callers;
+                line_stream >> std::hex >> counter.offset >> std::dec >> counter.vm_id >> std::hex >> counter.handler_rva >> callers;
+
+                if (callers != "-")
+                {
+                    std::istringstream caller_stream(callers);
+                    for (std::string caller; std::getline(caller_stream, caller, ',');)
+                        counter.caller_rvas.push_back(std::stoull(caller, nullptr, 16));
+                }
+
+                std::getline(line_stream >> std::ws, counter.name);
+                out.counters.push_back(counter);
+            }
+            else if (!kind.empty())
+            {
+                return false;
+            }
+
+            if (line_stream.bad())
+                return false;
+        }
+
+        return true;
+    }
+
+    int print_report(const std::string& manifest_path, const std::string& dump_path)
+    {
+        std::ifstream manifest_file(manifest_path);
+        manifest profile;
+        if (!manifest_file.is_open() || !manifest::parse(manifest_file, profile))
+        {
+            std::printf("[!] failed to read profile manifest: %s\n", manifest_path.c_str());
+            return EXIT_FAILURE;
+        }
+
+        std::ifstream dump_file(dump_path, std::ios::binary);
+        const std::vector<uint8_t> dump((std::istreambuf_iterator(dump_file)), std::istreambuf_iterator<char>());
+        if (dump.size() < profile.section_size)
+        {
+            std::printf("[!] dump is smaller than the .vmprof section: %s\n", dump_path.c_str());
+            return EXIT_FAILURE;
+        }
+
+        std::vector<std::pair<uint64_t, const counter_entry*>> hits;
+        uint64_t total = 0;
+
+        for (const counter_entry& counter : profile.counters)
+        {
+            if (counter.offset + 8 > dump.size())
+            {
+                std::printf("[!] counter for %s is outside of the dump\n", counter.name.c_str());
+                return EXIT_FAILURE;
+            }
+
+            uint64_t value = 0;
+            for (int i = 0; i < 8; i++)
+                value |= static_cast<uint64_t>(dump[counter.offset + i]) << i * 8;
+
+            hits.emplace_back(value, &counter);
+            total += value;
+        }
+
+        std::ranges::stable_sort(hits, std::greater{ }, &std::pair<uint64_t, const counter_entry*>::first);
+
+        std::printf("%-16s %8s %4s %-10s %s\n", "hits", "share", "vm", "handler", "name");
+        for (const auto& [value, counter] : hits)
+        {
+            const double share = total ? 100.0 * static_cast<double>(value) / static_cast<double>(total) : 0.0;
+            std::printf("%-16llu %7.2f%% %4u 0x%-8llx %s\n", static_cast<unsigned long long>(value), share, counter->vm_id,
+                static_cast<unsigned long long>(counter->handler_rva), counter->name.c_str());
+
+            if (value == 0 || counter->caller_rvas.empty())
+                continue;
+
+            std::stringstream callers;
+            for (size_t i = 0; i < counter->caller_rvas.size(); i++)
+                callers << (i ? ", " : "") << "0x" << std::hex << counter->caller_rvas[i];
+
+            std::printf("%32s called from %s\n", "", callers.str().c_str());
+        }
+
+        std::printf("[+] %llu handler executions across %zu handlers\n", static_cast<unsigned long long>(total), hits.size());
+        return EXIT_SUCCESS;
+    }
+}